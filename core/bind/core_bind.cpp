@@ -69,6 +69,28 @@ RES _ResourceLoader::load(const String &p_path, const String &p_type_hint, bool
 	return ret;
 }
 
+int _ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	return ResourceLoader::load_threaded_request(p_path, p_type_hint);
+}
+
+_ResourceLoader::ThreadLoadStatus _ResourceLoader::load_threaded_get_status(int p_ticket) {
+
+	return (ThreadLoadStatus)ResourceLoader::load_threaded_get_status(p_ticket);
+}
+
+float _ResourceLoader::load_threaded_get_progress(int p_ticket) {
+
+	float progress = 0;
+	ResourceLoader::load_threaded_get_status(p_ticket, &progress);
+	return progress;
+}
+
+RES _ResourceLoader::load_threaded_get(int p_ticket) {
+
+	return ResourceLoader::load_threaded_get(p_ticket);
+}
+
 DVector<String> _ResourceLoader::get_recognized_extensions_for_type(const String &p_type) {
 
 	List<String> exts;
@@ -115,11 +137,20 @@ void _ResourceLoader::_bind_methods() {
 
 	ObjectTypeDB::bind_method(_MD("load_interactive:ResourceInteractiveLoader", "path", "type_hint"), &_ResourceLoader::load_interactive, DEFVAL(""));
 	ObjectTypeDB::bind_method(_MD("load:Resource", "path", "type_hint", "p_no_cache"), &_ResourceLoader::load, DEFVAL(""), DEFVAL(false));
+	ObjectTypeDB::bind_method(_MD("load_threaded_request", "path", "type_hint"), &_ResourceLoader::load_threaded_request, DEFVAL(""));
+	ObjectTypeDB::bind_method(_MD("load_threaded_get_status", "ticket"), &_ResourceLoader::load_threaded_get_status);
+	ObjectTypeDB::bind_method(_MD("load_threaded_get_progress", "ticket"), &_ResourceLoader::load_threaded_get_progress);
+	ObjectTypeDB::bind_method(_MD("load_threaded_get:Resource", "ticket"), &_ResourceLoader::load_threaded_get);
 	ObjectTypeDB::bind_method(_MD("load_import_metadata:ResourceImportMetadata", "path"), &_ResourceLoader::load_import_metadata);
 	ObjectTypeDB::bind_method(_MD("get_recognized_extensions_for_type", "type"), &_ResourceLoader::get_recognized_extensions_for_type);
 	ObjectTypeDB::bind_method(_MD("set_abort_on_missing_resources", "abort"), &_ResourceLoader::set_abort_on_missing_resources);
 	ObjectTypeDB::bind_method(_MD("get_dependencies", "path"), &_ResourceLoader::get_dependencies);
 	ObjectTypeDB::bind_method(_MD("has", "path"), &_ResourceLoader::has);
+
+	BIND_CONSTANT(THREAD_LOAD_INVALID_TICKET);
+	BIND_CONSTANT(THREAD_LOAD_IN_PROGRESS);
+	BIND_CONSTANT(THREAD_LOAD_FAILED);
+	BIND_CONSTANT(THREAD_LOAD_LOADED);
 }
 
 _ResourceLoader::_ResourceLoader() {
@@ -790,6 +821,21 @@ void _OS::dump_memory_to_file(const String &p_file) {
 	OS::get_singleton()->dump_memory_to_file(p_file.utf8().get_data());
 }
 
+Error _OS::dump_trace_to_file(const String &p_file) {
+
+	return OS::get_singleton()->dump_trace_to_file(p_file.utf8().get_data());
+}
+
+void _OS::set_tracing_enabled(bool p_enabled) {
+
+	OS::get_singleton()->set_tracing_enabled(p_enabled);
+}
+
+bool _OS::is_tracing_enabled() const {
+
+	return OS::get_singleton()->is_tracing_enabled();
+}
+
 struct _OSCoreBindImg {
 
 	String path;
@@ -1106,6 +1152,9 @@ void _OS::_bind_methods() {
 	//ObjectTypeDB::bind_method(_MD("get_mouse_button_state"),&_OS::get_mouse_button_state);
 
 	ObjectTypeDB::bind_method(_MD("dump_memory_to_file", "file"), &_OS::dump_memory_to_file);
+	ObjectTypeDB::bind_method(_MD("dump_trace_to_file", "file"), &_OS::dump_trace_to_file);
+	ObjectTypeDB::bind_method(_MD("set_tracing_enabled", "enabled"), &_OS::set_tracing_enabled);
+	ObjectTypeDB::bind_method(_MD("is_tracing_enabled"), &_OS::is_tracing_enabled);
 	ObjectTypeDB::bind_method(_MD("dump_resources_to_file", "file"), &_OS::dump_resources_to_file);
 	ObjectTypeDB::bind_method(_MD("has_virtual_keyboard"), &_OS::has_virtual_keyboard);
 	ObjectTypeDB::bind_method(_MD("show_virtual_keyboard", "existing_text"), &_OS::show_virtual_keyboard, DEFVAL(""));
@@ -44,9 +44,20 @@ protected:
 	static _ResourceLoader *singleton;
 
 public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_TICKET,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
 	static _ResourceLoader *get_singleton() { return singleton; }
 	Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "");
 	RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false);
+	int load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	ThreadLoadStatus load_threaded_get_status(int p_ticket);
+	float load_threaded_get_progress(int p_ticket);
+	RES load_threaded_get(int p_ticket);
 	DVector<String> get_recognized_extensions_for_type(const String &p_type);
 	void set_abort_on_missing_resources(bool p_abort);
 	StringArray get_dependencies(const String &p_path);
@@ -195,6 +206,9 @@ public:
 	float get_frames_per_second() const;
 
 	void dump_memory_to_file(const String &p_file);
+	Error dump_trace_to_file(const String &p_file);
+	void set_tracing_enabled(bool p_enabled);
+	bool is_tracing_enabled() const;
 	void dump_resources_to_file(const String &p_file);
 
 	bool has_virtual_keyboard() const;
@@ -319,6 +333,7 @@ public:
 	_OS();
 };
 
+VARIANT_ENUM_CAST(_ResourceLoader::ThreadLoadStatus);
 VARIANT_ENUM_CAST(_OS::SystemDir);
 VARIANT_ENUM_CAST(_OS::ScreenOrientation);
 
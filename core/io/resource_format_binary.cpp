@@ -836,6 +836,7 @@ Error ResourceInteractiveLoaderBinary::poll() {
 			}
 			res->set_import_metadata(imd);
 		}
+		ResourceLoader::add_loaded_bytes(f->get_len());
 		f->close();
 		resource = res;
 		error = ERR_FILE_EOF;
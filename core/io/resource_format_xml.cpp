@@ -1528,6 +1528,7 @@ Error ResourceInteractiveLoaderXML::poll() {
 	resource_cache.push_back(res); //keep it in mem until finished loading
 	resource_current++;
 	if (main) {
+		ResourceLoader::add_loaded_bytes(f->get_len());
 		f->close();
 		resource = res;
 		if (!ResourceCache::has(res_path)) {
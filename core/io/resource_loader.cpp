@@ -30,6 +30,7 @@
 #include "globals.h"
 #include "os/file_access.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "path_remap.h"
 #include "print_string.h"
 ResourceFormatLoader *ResourceLoader::loader[MAX_LOADERS];
@@ -168,6 +169,36 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 		return RES(ResourceCache::get(local_path));
 	}
 
+	if (!p_no_cache && thread_load_mutex) {
+		//being loaded in the background already, use that instead of loading it twice
+		RES res;
+		ThreadLoadTask *task = NULL;
+		if (_thread_load_get_in_flight(local_path, p_type_hint, &res, r_error, &task))
+			return res;
+
+		if (task) {
+			//registered as in flight, so background requests for it wait for this load
+			Error err = ERR_CANT_OPEN;
+			res = _load(local_path, p_type_hint, p_no_cache, &err);
+			if (r_error)
+				*r_error = err;
+
+			_thread_load_finish(task, res, err);
+
+			thread_load_mutex->lock();
+			_thread_load_unref(task);
+			thread_load_mutex->unlock();
+
+			return res;
+		}
+	}
+
+	return _load(local_path, p_type_hint, p_no_cache, r_error);
+}
+
+RES ResourceLoader::_load(const String &p_local_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
+
+	const String &local_path = p_local_path;
 	String remapped_path = PathRemap::get_singleton()->get_remap(local_path);
 
 	if (OS::get_singleton()->is_stdout_verbose())
@@ -202,9 +233,9 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 	}
 
 	if (found) {
-		ERR_EXPLAIN("Failed loading resource: " + p_path);
+		ERR_EXPLAIN("Failed loading resource: " + local_path);
 	} else {
-		ERR_EXPLAIN("No loader found for resource: " + p_path);
+		ERR_EXPLAIN("No loader found for resource: " + local_path);
 	}
 	ERR_FAIL_V(RES());
 	return RES();
@@ -279,6 +310,31 @@ String ResourceLoader::find_complete_path(const String &p_path, const String &p_
 	return local_path;
 }
 
+void ResourceLoader::add_loaded_bytes(uint64_t p_bytes) {
+
+	if (thread_load_mutex)
+		thread_load_mutex->lock();
+
+	loaded_bytes += p_bytes;
+
+	if (thread_load_mutex)
+		thread_load_mutex->unlock();
+}
+
+uint64_t ResourceLoader::read_loaded_bytes() {
+
+	if (thread_load_mutex)
+		thread_load_mutex->lock();
+
+	uint64_t bytes = loaded_bytes;
+	loaded_bytes = 0;
+
+	if (thread_load_mutex)
+		thread_load_mutex->unlock();
+
+	return bytes;
+}
+
 Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
 	if (r_error)
@@ -456,6 +512,461 @@ String ResourceLoader::get_resource_type(const String &p_path) {
 
 	return "";
 }
+///////////////////////////////////
+
+struct ResourceLoader::ThreadLoadTask {
+
+	String local_path;
+	String type_hint;
+
+	bool started;
+	bool done;
+	Thread::ID thread;
+	float progress;
+
+	RES resource;
+	Error error;
+
+	int refcount;
+	int waiters;
+	Semaphore *semaphore; //created for the first waiter
+
+	Vector<ThreadLoadTask *> dependencies;
+};
+
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+Vector<Thread *> ResourceLoader::thread_load_threads;
+bool ResourceLoader::thread_load_started = false;
+bool ResourceLoader::thread_load_exit = false;
+List<ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_queue;
+HashMap<String, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tasks;
+Map<int, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_tickets;
+Map<Thread::ID, ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_waiting;
+int ResourceLoader::thread_load_last_ticket = 0;
+
+static String _get_local_path(const String &p_path) {
+
+	if (p_path.is_rel_path())
+		return "res://" + p_path;
+	return Globals::get_singleton()->localize_path(p_path);
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_thread_load_create_task(const String &p_local_path, const String &p_type_hint) {
+
+	ThreadLoadTask *task = memnew(ThreadLoadTask);
+	task->local_path = p_local_path;
+	task->type_hint = p_type_hint;
+	task->started = false;
+	task->done = false;
+	task->thread = 0;
+	task->progress = 0;
+	task->error = OK;
+	task->refcount = 1;
+	task->waiters = 0;
+	task->semaphore = NULL;
+	return task;
+}
+
+ResourceLoader::ThreadLoadTask *ResourceLoader::_thread_load_request(const String &p_local_path, const String &p_type_hint) {
+
+	ThreadLoadTask **existing = thread_load_tasks.getptr(p_local_path);
+	if (existing) {
+		(*existing)->refcount++;
+		return *existing;
+	}
+
+	ThreadLoadTask *task = _thread_load_create_task(p_local_path, p_type_hint);
+
+	if (ResourceCache::has(p_local_path)) {
+
+		task->resource = RES(ResourceCache::get(p_local_path));
+		task->started = true;
+		task->done = true;
+		task->progress = 1;
+		return task;
+	}
+
+	thread_load_tasks[p_local_path] = task;
+
+	task->refcount++; //the queue holds a reference until a worker takes it
+	thread_load_queue.push_back(task);
+
+	_thread_load_start();
+	if (thread_load_semaphore)
+		thread_load_semaphore->post();
+
+	return task;
+}
+
+void ResourceLoader::_thread_load_unref(ThreadLoadTask *p_task) {
+
+	p_task->refcount--;
+	if (p_task->refcount > 0)
+		return;
+
+	for (int i = 0; i < p_task->dependencies.size(); i++) {
+		_thread_load_unref(p_task->dependencies[i]);
+	}
+
+	if (p_task->semaphore)
+		memdelete(p_task->semaphore);
+	memdelete(p_task);
+}
+
+bool ResourceLoader::_thread_load_wait(ThreadLoadTask *p_task) {
+
+	if (p_task->done)
+		return true;
+
+	Thread::ID thread_id = Thread::get_caller_ID();
+
+	if (!p_task->started) {
+		//nobody took it yet, so better load it here than sit waiting
+		p_task->started = true;
+		p_task->thread = thread_id;
+		thread_load_mutex->unlock();
+		_thread_load_run(p_task);
+		thread_load_mutex->lock();
+		return true;
+	}
+
+	//follow what the loading thread is waiting for, if it leads back here waiting would never end
+	ThreadLoadTask *t = p_task;
+	while (t) {
+		if (t->thread == thread_id)
+			return false;
+		Map<Thread::ID, ThreadLoadTask *>::Element *E = thread_load_waiting.find(t->thread);
+		t = E ? E->get() : NULL;
+	}
+
+	if (!p_task->semaphore)
+		p_task->semaphore = Semaphore::create();
+	p_task->waiters++;
+	thread_load_waiting[thread_id] = p_task;
+
+	thread_load_mutex->unlock();
+	p_task->semaphore->wait();
+	thread_load_mutex->lock();
+
+	thread_load_waiting.erase(thread_id);
+	return true;
+}
+
+void ResourceLoader::_thread_load_start() {
+
+	if (thread_load_started)
+		return;
+	thread_load_started = true;
+
+	int thread_count = GLOBAL_DEF("core/resource_loader_threads", MAX(1, OS::get_singleton()->get_processor_count() - 1));
+	if (thread_count <= 0)
+		return; //requests are only loaded when waited for
+
+	thread_load_semaphore = Semaphore::create();
+	for (int i = 0; i < thread_count; i++) {
+		thread_load_threads.push_back(Thread::create(_thread_load_worker, NULL));
+	}
+}
+
+void ResourceLoader::_thread_load_run(ThreadLoadTask *p_task) {
+
+	TRACE_ZONE("ResourceLoader::load_threaded");
+
+	//queue the external dependencies first, so they load in other threads while this one gets to them
+	List<String> deps;
+	get_dependencies(p_task->local_path, &deps, true);
+
+	if (deps.size()) {
+
+		thread_load_mutex->lock();
+		for (List<String>::Element *E = deps.front(); E; E = E->next()) {
+
+			String dep_path = E->get();
+			String dep_type;
+			if (dep_path.find("::") != -1) {
+				dep_type = dep_path.get_slice("::", 1);
+				dep_path = dep_path.get_slice("::", 0);
+			}
+			dep_path = _get_local_path(dep_path);
+			if (dep_path == p_task->local_path)
+				continue;
+
+			p_task->dependencies.push_back(_thread_load_request(dep_path, dep_type));
+		}
+		thread_load_mutex->unlock();
+	}
+
+	Error err = OK;
+	RES res;
+
+	Ref<ResourceInteractiveLoader> ril = load_interactive(p_task->local_path, p_task->type_hint, false, &err);
+	if (ril.is_valid()) {
+
+		while (true) {
+
+			err = ril->poll();
+			if (err == ERR_FILE_EOF) {
+				err = OK;
+				res = ril->get_resource();
+				break;
+			} else if (err != OK) {
+				break;
+			}
+
+			int stage_count = ril->get_stage_count();
+			if (stage_count > 0)
+				p_task->progress = float(ril->get_stage()) / stage_count;
+		}
+	}
+
+	if (err == OK && res.is_null())
+		err = ERR_CANT_OPEN;
+
+	if (res.is_valid()) {
+		//same as load(), loaders that aren't interactive don't set the path themselves
+		if (res->get_path() != p_task->local_path)
+			res->set_path(p_task->local_path);
+#ifdef TOOLS_ENABLED
+		res->set_edited(false);
+		if (timestamp_on_load) {
+			String remapped_path = PathRemap::get_singleton()->get_remap(p_task->local_path);
+			res->set_last_modified_time(FileAccess::get_modified_time(remapped_path));
+		}
+#endif
+	}
+
+	_thread_load_finish(p_task, res, err);
+}
+
+void ResourceLoader::_thread_load_finish(ThreadLoadTask *p_task, const RES &p_resource, Error p_error) {
+
+	thread_load_mutex->lock();
+
+	p_task->resource = p_resource;
+	p_task->error = p_error;
+	p_task->progress = 1;
+	p_task->done = true;
+	//from now on it's found through the resource cache
+	thread_load_tasks.erase(p_task->local_path);
+
+	for (int i = 0; i < p_task->waiters; i++) {
+		p_task->semaphore->post();
+	}
+	p_task->waiters = 0;
+
+	thread_load_mutex->unlock();
+}
+
+bool ResourceLoader::_thread_load_get_in_flight(const String &p_local_path, const String &p_type_hint, RES *r_res, Error *r_error, ThreadLoadTask **r_task) {
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask **task_ptr = thread_load_tasks.getptr(p_local_path);
+	if (!task_ptr) {
+
+		if (ResourceCache::has(p_local_path)) {
+			//a task finished after the caller checked the cache
+			*r_res = RES(ResourceCache::get(p_local_path));
+			if (r_error)
+				*r_error = OK;
+			thread_load_mutex->unlock();
+			return true;
+		}
+
+		//not loading anywhere, register the caller's load so background requests wait for it
+		ThreadLoadTask *task = _thread_load_create_task(p_local_path, p_type_hint);
+		task->started = true;
+		task->thread = Thread::get_caller_ID();
+		thread_load_tasks[p_local_path] = task;
+		*r_task = task;
+
+		thread_load_mutex->unlock();
+		return false;
+	}
+
+	ThreadLoadTask *task = *task_ptr;
+	task->refcount++;
+
+	bool waited = _thread_load_wait(task);
+	if (waited) {
+		*r_res = task->resource;
+		if (r_error)
+			*r_error = task->error;
+	}
+
+	_thread_load_unref(task);
+	thread_load_mutex->unlock();
+
+	return waited;
+}
+
+void ResourceLoader::_thread_load_worker(void *p_ud) {
+
+	Trace::set_thread_name("loader");
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+
+		thread_load_mutex->lock();
+
+		if (thread_load_exit || thread_load_queue.empty()) {
+			bool exit = thread_load_exit;
+			thread_load_mutex->unlock();
+			if (exit)
+				break;
+			continue;
+		}
+
+		ThreadLoadTask *task = thread_load_queue.front()->get();
+		thread_load_queue.pop_front();
+
+		if (!task->started) {
+			task->started = true;
+			task->thread = Thread::get_caller_ID();
+			thread_load_mutex->unlock();
+			_thread_load_run(task);
+			thread_load_mutex->lock();
+		}
+
+		_thread_load_unref(task);
+		thread_load_mutex->unlock();
+	}
+}
+
+int ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint) {
+
+	ERR_FAIL_COND_V(!thread_load_mutex, -1);
+
+	String local_path = find_complete_path(_get_local_path(p_path), p_type_hint);
+	ERR_FAIL_COND_V(local_path == "", -1);
+
+	thread_load_mutex->lock();
+	ThreadLoadTask *task = _thread_load_request(local_path, p_type_hint);
+	int ticket = ++thread_load_last_ticket;
+	thread_load_tickets[ticket] = task;
+	thread_load_mutex->unlock();
+
+	return ticket;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(int p_ticket, float *r_progress) {
+
+	ERR_FAIL_COND_V(!thread_load_mutex, THREAD_LOAD_INVALID_TICKET);
+
+	thread_load_mutex->lock();
+
+	Map<int, ThreadLoadTask *>::Element *E = thread_load_tickets.find(p_ticket);
+	if (!E) {
+		thread_load_mutex->unlock();
+		return THREAD_LOAD_INVALID_TICKET;
+	}
+
+	ThreadLoadTask *task = E->get();
+
+	ThreadLoadStatus status;
+	if (!task->done)
+		status = THREAD_LOAD_IN_PROGRESS;
+	else if (task->resource.is_null())
+		status = THREAD_LOAD_FAILED;
+	else
+		status = THREAD_LOAD_LOADED;
+
+	if (r_progress) {
+		//the resource and its external dependencies weigh the same
+		float progress = task->progress;
+		for (int i = 0; i < task->dependencies.size(); i++) {
+			progress += task->dependencies[i]->done ? 1.0 : task->dependencies[i]->progress;
+		}
+		*r_progress = task->done ? 1.0 : progress / (task->dependencies.size() + 1);
+	}
+
+	thread_load_mutex->unlock();
+
+	return status;
+}
+
+RES ResourceLoader::load_threaded_get(int p_ticket, Error *r_error) {
+
+	if (r_error)
+		*r_error = ERR_INVALID_PARAMETER;
+
+	ERR_FAIL_COND_V(!thread_load_mutex, RES());
+
+	thread_load_mutex->lock();
+
+	Map<int, ThreadLoadTask *>::Element *E = thread_load_tickets.find(p_ticket);
+	if (!E) {
+		thread_load_mutex->unlock();
+		ERR_EXPLAIN("Invalid load ticket: " + itos(p_ticket));
+		ERR_FAIL_V(RES());
+	}
+
+	ThreadLoadTask *task = E->get();
+	thread_load_tickets.erase(E);
+
+	RES res;
+	if (_thread_load_wait(task)) {
+		res = task->resource;
+		if (r_error)
+			*r_error = task->error;
+		_thread_load_unref(task);
+		thread_load_mutex->unlock();
+	} else {
+		//requested from inside a load that the task depends on, load it here like load() would
+		String local_path = task->local_path;
+		String type_hint = task->type_hint;
+		_thread_load_unref(task);
+		thread_load_mutex->unlock();
+		res = load(local_path, type_hint, true, r_error);
+	}
+
+	return res;
+}
+
+void ResourceLoader::initialize() {
+
+	thread_load_mutex = Mutex::create();
+}
+
+void ResourceLoader::finalize() {
+
+	if (!thread_load_mutex)
+		return;
+
+	thread_load_mutex->lock();
+	thread_load_exit = true;
+	thread_load_mutex->unlock();
+
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		thread_load_semaphore->post();
+	}
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		Thread::wait_to_finish(thread_load_threads[i]);
+		memdelete(thread_load_threads[i]);
+	}
+	thread_load_threads.clear();
+
+	//drop whatever was never loaded or picked up
+	while (thread_load_queue.size()) {
+		_thread_load_unref(thread_load_queue.front()->get());
+		thread_load_queue.pop_front();
+	}
+	for (Map<int, ThreadLoadTask *>::Element *E = thread_load_tickets.front(); E; E = E->next()) {
+		_thread_load_unref(E->get());
+	}
+	thread_load_tickets.clear();
+	thread_load_tasks.clear();
+
+	if (thread_load_semaphore) {
+		memdelete(thread_load_semaphore);
+		thread_load_semaphore = NULL;
+	}
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
+}
+
 ResourceLoadErrorNotify ResourceLoader::err_notify = NULL;
 void *ResourceLoader::err_notify_ud = NULL;
 
@@ -464,3 +975,4 @@ void *ResourceLoader::dep_err_notify_ud = NULL;
 
 bool ResourceLoader::abort_on_missing_resource = true;
 bool ResourceLoader::timestamp_on_load = false;
+uint64_t ResourceLoader::loaded_bytes = 0;
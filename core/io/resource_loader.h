@@ -30,6 +30,9 @@
 #define RESOURCE_LOADER_H
 
 #include "export_data.h"
+#include "os/mutex.h"
+#include "os/semaphore.h"
+#include "os/thread.h"
 #include "resource.h"
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
@@ -74,7 +77,15 @@ typedef void (*ResourceLoadErrorNotify)(void *p_ud, const String &p_text);
 typedef void (*DependencyErrorNotify)(void *p_ud, const String &p_loading, const String &p_which, const String &p_type);
 
 class ResourceLoader {
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_TICKET,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
 
+private:
 	enum {
 		MAX_LOADERS = 64
 	};
@@ -89,7 +100,35 @@ class ResourceLoader {
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
 
+	static uint64_t loaded_bytes;
+
 	static String find_complete_path(const String &p_path, const String &p_type);
+	static RES _load(const String &p_local_path, const String &p_type_hint, bool p_no_cache, Error *r_error);
+
+	struct ThreadLoadTask;
+
+	static Mutex *thread_load_mutex;
+	static Semaphore *thread_load_semaphore;
+	static Vector<Thread *> thread_load_threads;
+	static bool thread_load_started;
+	static bool thread_load_exit;
+	static List<ThreadLoadTask *> thread_load_queue;
+	static HashMap<String, ThreadLoadTask *> thread_load_tasks; //queued or loading, by local path
+	static Map<int, ThreadLoadTask *> thread_load_tickets;
+	static Map<Thread::ID, ThreadLoadTask *> thread_load_waiting; //what each blocked thread waits for
+	static int thread_load_last_ticket;
+
+	//these expect thread_load_mutex to be locked
+	static ThreadLoadTask *_thread_load_request(const String &p_local_path, const String &p_type_hint);
+	static void _thread_load_unref(ThreadLoadTask *p_task);
+	static bool _thread_load_wait(ThreadLoadTask *p_task);
+	static void _thread_load_start();
+
+	static void _thread_load_run(ThreadLoadTask *p_task);
+	static ThreadLoadTask *_thread_load_create_task(const String &p_local_path, const String &p_type_hint);
+	static void _thread_load_finish(ThreadLoadTask *p_task, const RES &p_resource, Error p_error);
+	static bool _thread_load_get_in_flight(const String &p_local_path, const String &p_type_hint, RES *r_res, Error *r_error, ThreadLoadTask **r_task);
+	static void _thread_load_worker(void *p_ud);
 
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
@@ -126,6 +165,17 @@ public:
 
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
+
+	static void add_loaded_bytes(uint64_t p_bytes); //called by the loaders as they finish reading a file, from any thread
+	static uint64_t read_loaded_bytes(); //bytes loaded since the previous read
+
+	//background loading, the ticket is released by load_threaded_get()
+	static int load_threaded_request(const String &p_path, const String &p_type_hint = "");
+	static ThreadLoadStatus load_threaded_get_status(int p_ticket, float *r_progress = NULL);
+	static RES load_threaded_get(int p_ticket, Error *r_error = NULL);
+
+	static void initialize();
+	static void finalize();
 };
 
 #endif
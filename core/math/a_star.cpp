@@ -46,7 +46,11 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, float p_weight_scale) {
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
 		pt->prev_point = NULL;
-		pt->last_pass = 0;
+		pt->g_score = 0;
+		pt->f_score = 0;
+		pt->open_pass = 0;
+		pt->closed_pass = 0;
+		pt->heap_index = -1;
 		points[p_id] = pt;
 	} else {
 		points[p_id]->pos = p_pos;
@@ -175,128 +179,140 @@ Vector3 AStar::get_closest_pos_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
+void AStar::_heap_sift_up(int p_index) {
 
-	pass++;
+	Point *p = open_heap[p_index];
 
-	SelfList<Point>::List open_list;
+	while (p_index > 0) {
+		int parent = (p_index - 1) >> 1;
+		if (open_heap[parent]->f_score <= p->f_score)
+			break;
+		_heap_set(p_index, open_heap[parent]);
+		p_index = parent;
+	}
 
-	bool found_route = false;
+	_heap_set(p_index, p);
+}
 
-	for (int i = 0; i < begin_point->neighbours.size(); i++) {
+void AStar::_heap_sift_down(int p_index) {
 
-		Point *n = begin_point->neighbours[i];
-		n->prev_point = begin_point;
-		n->distance = n->pos.distance_to(begin_point->pos);
-		n->distance *= n->weight_scale;
-		n->last_pass = pass;
-		open_list.add(&n->list);
+	Point *p = open_heap[p_index];
 
-		if (end_point == n) {
-			found_route = true;
+	while (true) {
+		int child = (p_index << 1) + 1;
+		if (child >= open_count)
 			break;
-		}
+		if (child + 1 < open_count && open_heap[child + 1]->f_score < open_heap[child]->f_score)
+			child++;
+		if (p->f_score <= open_heap[child]->f_score)
+			break;
+		_heap_set(p_index, open_heap[child]);
+		p_index = child;
 	}
 
-	while (!found_route) {
+	_heap_set(p_index, p);
+}
 
-		if (open_list.first() == NULL) {
-			//could not find path sadly
-			break;
-		}
-		//check open list
+void AStar::_heap_push(Point *p_point) {
 
-		SelfList<Point> *least_cost_point = NULL;
-		float least_cost = 1e30;
+	if (open_count == open_heap.size()) {
+		open_heap.resize(MAX(open_count * 2, 64));
+	}
 
-		//this could be faster (cache previous results)
-		for (SelfList<Point> *E = open_list.first(); E; E = E->next()) {
+	_heap_set(open_count, p_point);
+	open_count++;
+	_heap_sift_up(open_count - 1);
+}
 
-			Point *p = E->self();
+AStar::Point *AStar::_heap_pop() {
 
-			float cost = p->distance;
-			cost += p->pos.distance_to(end_point->pos);
-			cost *= p->weight_scale;
+	Point *p = open_heap[0];
+	open_count--;
 
-			if (cost < least_cost) {
+	if (open_count > 0) {
+		_heap_set(0, open_heap[open_count]);
+		_heap_sift_down(0);
+	}
 
-				least_cost_point = E;
-				least_cost = cost;
-			}
+	p->heap_index = -1;
+	return p;
+}
+
+bool AStar::_solve(Point *begin_point, Point *end_point) {
+
+	pass++;
+
+	open_count = 0;
+
+	begin_point->prev_point = NULL;
+	begin_point->g_score = 0;
+	begin_point->f_score = begin_point->pos.distance_to(end_point->pos);
+	begin_point->open_pass = pass;
+	_heap_push(begin_point);
+
+	bool found_route = false;
+
+	while (open_count) {
+
+		Point *p = _heap_pop();
+
+		if (p == end_point) {
+			found_route = true;
+			break;
 		}
 
-		Point *p = least_cost_point->self();
+		p->closed_pass = pass;
+
 		//open the neighbours for search
 		int es = p->neighbours.size();
+		Point *const *neighbours = p->neighbours.ptr();
 
 		for (int i = 0; i < es; i++) {
 
-			Point *e = p->neighbours[i];
+			Point *e = neighbours[i];
 
-			float distance = p->pos.distance_to(e->pos) + p->distance;
-			distance *= e->weight_scale;
+			if (e->closed_pass == pass)
+				continue;
 
-			if (e->last_pass == pass) {
-				//oh this was visited already, can we win the cost?
+			float g_score = p->g_score + p->pos.distance_to(e->pos) * e->weight_scale;
 
-				if (e->distance > distance) {
+			if (e->open_pass == pass) {
+				//already in the open list, can we win the cost?
+				if (g_score >= e->g_score)
+					continue;
+
+				e->prev_point = p;
+				e->g_score = g_score;
+				e->f_score = g_score + e->pos.distance_to(end_point->pos);
+				_heap_sift_up(e->heap_index);
 
-					e->prev_point = p;
-					e->distance = distance;
-				}
 			} else {
 				//add to open neighbours
-
 				e->prev_point = p;
-				e->distance = distance;
-				e->last_pass = pass; //mark as used
-				open_list.add(&e->list);
-
-				if (e == end_point) {
-					//oh my reached end! stop algorithm
-					found_route = true;
-					break;
-				}
+				e->g_score = g_score;
+				e->f_score = g_score + e->pos.distance_to(end_point->pos);
+				e->open_pass = pass; //mark as used
+				_heap_push(e);
 			}
 		}
-
-		if (found_route)
-			break;
-
-		open_list.remove(least_cost_point);
 	}
 
-	//clear the openf list
-	while (open_list.first()) {
-		open_list.remove(open_list.first());
-	}
+	//whatever is left in the open list is stale for the next search
+	open_count = 0;
 
 	return found_route;
 }
 
-DVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
-
-	ERR_FAIL_COND_V(!points.has(p_from_id), DVector<Vector3>());
-	ERR_FAIL_COND_V(!points.has(p_to_id), DVector<Vector3>());
-
-	pass++;
+DVector<int> AStar::_build_id_path(Point *begin_point, Point *end_point) {
 
-	Point *a = points[p_from_id];
-	Point *b = points[p_to_id];
-
-	if (a == b) {
-		DVector<Vector3> ret;
-		ret.push_back(a->pos);
+	if (begin_point == end_point) {
+		DVector<int> ret;
+		ret.push_back(begin_point->id);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-
-	if (!found_route)
-		return DVector<Vector3>();
+	if (!_solve(begin_point, end_point))
+		return DVector<int>();
 
 	//midpoints
 	Point *p = end_point;
@@ -306,20 +322,43 @@ DVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 		p = p->prev_point;
 	}
 
-	DVector<Vector3> path;
+	DVector<int> path;
 	path.resize(pc);
 
 	{
-		DVector<Vector3>::Write w = path.write();
+		DVector<int>::Write w = path.write();
 
-		Point *p = end_point;
+		p = end_point;
 		int idx = pc - 1;
 		while (p != begin_point) {
-			w[idx--] = p->pos;
+			w[idx--] = p->id;
 			p = p->prev_point;
 		}
 
-		w[0] = p->pos; //assign first
+		w[0] = p->id; //assign first
+	}
+
+	return path;
+}
+
+DVector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
+
+	ERR_FAIL_COND_V(!points.has(p_from_id), DVector<Vector3>());
+	ERR_FAIL_COND_V(!points.has(p_to_id), DVector<Vector3>());
+
+	DVector<int> ids = _build_id_path(points[p_from_id], points[p_to_id]);
+	int pc = ids.size();
+
+	DVector<Vector3> path;
+	path.resize(pc);
+
+	{
+		DVector<int>::Read r = ids.read();
+		DVector<Vector3>::Write w = path.write();
+
+		for (int i = 0; i < pc; i++) {
+			w[i] = points[r[i]]->pos;
+		}
 	}
 
 	return path;
@@ -330,50 +369,36 @@ DVector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	ERR_FAIL_COND_V(!points.has(p_from_id), DVector<int>());
 	ERR_FAIL_COND_V(!points.has(p_to_id), DVector<int>());
 
-	pass++;
-
-	Point *a = points[p_from_id];
-	Point *b = points[p_to_id];
+	return _build_id_path(points[p_from_id], points[p_to_id]);
+}
 
-	if (a == b) {
-		DVector<int> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
+Array AStar::get_id_paths(const DVector<int> &p_from_ids, const DVector<int> &p_to_ids) {
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	ERR_FAIL_COND_V(p_from_ids.size() != p_to_ids.size(), Array());
 
-	bool found_route = _solve(begin_point, end_point);
+	int count = p_from_ids.size();
 
-	if (!found_route)
-		return DVector<int>();
+	Array ret;
+	ret.resize(count);
 
-	//midpoints
-	Point *p = end_point;
-	int pc = 1; //begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
+	DVector<int>::Read from = p_from_ids.read();
+	DVector<int>::Read to = p_to_ids.read();
 
-	DVector<int> path;
-	path.resize(pc);
+	for (int i = 0; i < count; i++) {
 
-	{
-		DVector<int>::Write w = path.write();
+		const Map<int, Point *>::Element *A = points.find(from[i]);
+		const Map<int, Point *>::Element *B = points.find(to[i]);
 
-		p = end_point;
-		int idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+		if (!A || !B) {
+			ERR_PRINT("Invalid point id in path query.");
+			ret[i] = DVector<int>();
+			continue;
 		}
 
-		w[0] = p->id; //assign first
+		ret[i] = _build_id_path(A->get(), B->get());
 	}
 
-	return path;
+	return ret;
 }
 
 void AStar::_bind_methods() {
@@ -395,11 +420,13 @@ void AStar::_bind_methods() {
 
 	ObjectTypeDB::bind_method(_MD("get_point_path", "from_id", "to_id"), &AStar::get_point_path);
 	ObjectTypeDB::bind_method(_MD("get_id_path", "from_id", "to_id"), &AStar::get_id_path);
+	ObjectTypeDB::bind_method(_MD("get_id_paths", "from_ids", "to_ids"), &AStar::get_id_paths);
 }
 
 AStar::AStar() {
 
 	pass = 1;
+	open_count = 0;
 }
 
 AStar::~AStar() {
@@ -30,7 +30,6 @@
 #define ASTAR_H
 
 #include "reference.h"
-#include "self_list.h"
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
 */
@@ -43,21 +42,19 @@ class AStar : public Reference {
 
 	struct Point {
 
-		SelfList<Point> list;
-
 		int id;
 		Vector3 pos;
 		float weight_scale;
-		uint64_t last_pass;
 
 		Vector<Point *> neighbours;
 
 		//used for pathfinding
 		Point *prev_point;
-		float distance;
-
-		Point()
-			: list(this) {}
+		float g_score;
+		float f_score;
+		uint64_t open_pass;
+		uint64_t closed_pass;
+		int heap_index;
 	};
 
 	Map<int, Point *> points;
@@ -88,7 +85,23 @@ class AStar : public Reference {
 
 	Set<Segment> segments;
 
+	//open list, a binary min-heap on f_score indexed by Point::heap_index (so costs can be decreased in place)
+	//kept between searches so repeated queries don't reallocate it
+	Vector<Point *> open_heap;
+	int open_count;
+
+	_FORCE_INLINE_ void _heap_set(int p_index, Point *p_point) {
+		open_heap[p_index] = p_point;
+		p_point->heap_index = p_index;
+	}
+
+	void _heap_sift_up(int p_index);
+	void _heap_sift_down(int p_index);
+	void _heap_push(Point *p_point);
+	Point *_heap_pop();
+
 	bool _solve(Point *begin_point, Point *end_point);
+	DVector<int> _build_id_path(Point *begin_point, Point *end_point);
 
 protected:
 	static void _bind_methods();
@@ -112,6 +125,7 @@ public:
 
 	DVector<Vector3> get_point_path(int p_from_id, int p_to_id);
 	DVector<int> get_id_path(int p_from_id, int p_to_id);
+	Array get_id_paths(const DVector<int> &p_from_ids, const DVector<int> &p_to_ids);
 
 	AStar();
 	~AStar();
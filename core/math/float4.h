@@ -0,0 +1,141 @@
+/*************************************************************************/
+/*  float4.h                                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef FLOAT4_H
+#define FLOAT4_H
+
+#include "math_funcs.h"
+
+//four reals processed at once, used by code that runs the same math over several inputs (ie, projecting against many axes)
+//maps to SSE2 when the target has it and real_t is float, plain loops otherwise
+
+#if !defined(REAL_T_IS_DOUBLE) && !defined(NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FLOAT4_SSE2
+#include <emmintrin.h>
+#endif
+
+struct Float4 {
+
+#ifdef FLOAT4_SSE2
+
+	__m128 v;
+
+	_FORCE_INLINE_ static Float4 splat(real_t p_s) { return Float4(_mm_set1_ps(p_s)); }
+	_FORCE_INLINE_ static Float4 load(const real_t *p_src) { return Float4(_mm_loadu_ps(p_src)); }
+	_FORCE_INLINE_ void store(real_t *p_dst) const { _mm_storeu_ps(p_dst, v); }
+
+	_FORCE_INLINE_ Float4 operator+(const Float4 &p_b) const { return Float4(_mm_add_ps(v, p_b.v)); }
+	_FORCE_INLINE_ Float4 operator-(const Float4 &p_b) const { return Float4(_mm_sub_ps(v, p_b.v)); }
+	_FORCE_INLINE_ Float4 operator*(const Float4 &p_b) const { return Float4(_mm_mul_ps(v, p_b.v)); }
+	_FORCE_INLINE_ Float4 operator*(real_t p_s) const { return Float4(_mm_mul_ps(v, _mm_set1_ps(p_s))); }
+
+	_FORCE_INLINE_ static Float4 min(const Float4 &p_a, const Float4 &p_b) { return Float4(_mm_min_ps(p_a.v, p_b.v)); }
+	_FORCE_INLINE_ static Float4 max(const Float4 &p_a, const Float4 &p_b) { return Float4(_mm_max_ps(p_a.v, p_b.v)); }
+	_FORCE_INLINE_ static Float4 abs(const Float4 &p_a) { return Float4(_mm_andnot_ps(_mm_set1_ps(-0.0f), p_a.v)); }
+	_FORCE_INLINE_ static Float4 sqrt(const Float4 &p_a) { return Float4(_mm_sqrt_ps(p_a.v)); }
+
+	_FORCE_INLINE_ Float4() {}
+	_FORCE_INLINE_ Float4(__m128 p_v) { v = p_v; }
+
+#else
+
+	real_t v[4];
+
+	_FORCE_INLINE_ static Float4 splat(real_t p_s) {
+		Float4 r;
+		r.v[0] = r.v[1] = r.v[2] = r.v[3] = p_s;
+		return r;
+	}
+	_FORCE_INLINE_ static Float4 load(const real_t *p_src) {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = p_src[i];
+		return r;
+	}
+	_FORCE_INLINE_ void store(real_t *p_dst) const {
+		for (int i = 0; i < 4; i++)
+			p_dst[i] = v[i];
+	}
+
+	_FORCE_INLINE_ Float4 operator+(const Float4 &p_b) const {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = v[i] + p_b.v[i];
+		return r;
+	}
+	_FORCE_INLINE_ Float4 operator-(const Float4 &p_b) const {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = v[i] - p_b.v[i];
+		return r;
+	}
+	_FORCE_INLINE_ Float4 operator*(const Float4 &p_b) const {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = v[i] * p_b.v[i];
+		return r;
+	}
+
+	_FORCE_INLINE_ Float4 operator*(real_t p_s) const {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = v[i] * p_s;
+		return r;
+	}
+
+	_FORCE_INLINE_ static Float4 min(const Float4 &p_a, const Float4 &p_b) {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = p_a.v[i] < p_b.v[i] ? p_a.v[i] : p_b.v[i];
+		return r;
+	}
+	_FORCE_INLINE_ static Float4 max(const Float4 &p_a, const Float4 &p_b) {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = p_a.v[i] > p_b.v[i] ? p_a.v[i] : p_b.v[i];
+		return r;
+	}
+	_FORCE_INLINE_ static Float4 abs(const Float4 &p_a) {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = p_a.v[i] < 0 ? -p_a.v[i] : p_a.v[i];
+		return r;
+	}
+	_FORCE_INLINE_ static Float4 sqrt(const Float4 &p_a) {
+		Float4 r;
+		for (int i = 0; i < 4; i++)
+			r.v[i] = Math::sqrt(p_a.v[i]);
+		return r;
+	}
+
+	_FORCE_INLINE_ Float4() {}
+
+#endif
+};
+
+#endif // FLOAT4_H
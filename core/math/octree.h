@@ -32,6 +32,7 @@
 #include "aabb.h"
 #include "list.h"
 #include "map.h"
+#include "os/thread_work_pool.h"
 #include "print_string.h"
 #include "variant.h"
 #include "vector3.h"
@@ -346,6 +347,37 @@ private:
 	};
 
 	void _cull_convex(Octant *p_octant, _CullConvexData *p_cull);
+
+	struct _CullConvexTask {
+
+		Octant *octant;
+		const Plane *planes;
+		int plane_count;
+		uint32_t mask;
+
+		//elements owned by a single octant can only be found once and go straight to the results,
+		//the rest may be found by several tasks and are deduplicated and tested once all of them finished
+		Vector<T *> result;
+		int result_count;
+		Vector<Element *> shared;
+		int shared_count;
+	};
+
+	_CullConvexTask cull_top_task;
+	Vector<_CullConvexTask> cull_tasks;
+	Vector<Octant *> cull_octants[2];
+
+	template <class V>
+	static _FORCE_INLINE_ void _cull_push(Vector<V> &p_buffer, int &r_count, const V &p_value) {
+
+		if (r_count == p_buffer.size())
+			p_buffer.resize(MAX(r_count * 2, 64));
+		p_buffer.ptr()[r_count++] = p_value;
+	}
+
+	void _cull_convex_elements(Octant *p_octant, _CullConvexTask *p_task);
+	void _cull_convex_task(Octant *p_octant, _CullConvexTask *p_task);
+	void _cull_convex_job(uint32_t p_index, _CullConvexTask *p_tasks);
 	void _cull_AABB(Octant *p_octant, const AABB &p_aabb, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_segment(Octant *p_octant, const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_point(Octant *p_octant, const Vector3 &p_point, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
@@ -375,6 +407,9 @@ public:
 	int get_subindex(OctreeElementID p_id) const;
 
 	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	//no result limit, r_result grows as needed (but never shrinks) and the amount of results is returned.
+	//with a work pool the octree is split in subtrees that are culled in parallel, results are not in tree order
+	int cull_convex(const Vector<Plane> &p_convex, Vector<T *> &r_result, uint32_t p_mask = 0xFFFFFFFF, ThreadWorkPool *p_work_pool = NULL);
 	int cull_AABB(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 
@@ -1328,6 +1363,164 @@ int Octree<T, use_pairs, AL>::cull_convex(const Vector<Plane> &p_convex, T **p_r
 	return result_count;
 }
 
+template <class T, bool use_pairs, class AL>
+void Octree<T, use_pairs, AL>::_cull_convex_elements(Octant *p_octant, _CullConvexTask *p_task) {
+
+	for (int i = 0; i < (use_pairs ? 2 : 1); i++) {
+
+		typename List<Element *, AL>::Element *I = i == 0 ? p_octant->elements.front() : p_octant->pairable_elements.front();
+
+		for (; I; I = I->next()) {
+
+			Element *e = I->get();
+
+			if (use_pairs && !(e->pairable_type & p_task->mask))
+				continue;
+
+			if (e->common_parent != p_octant) {
+				//only single owner elements have their own octant as common parent, the rest are tested when merging
+				_cull_push(p_task->shared, p_task->shared_count, e);
+				continue;
+			}
+
+			if (e->aabb.intersects_convex_shape(p_task->planes, p_task->plane_count)) {
+				_cull_push(p_task->result, p_task->result_count, e->userdata);
+			}
+		}
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void Octree<T, use_pairs, AL>::_cull_convex_task(Octant *p_octant, _CullConvexTask *p_task) {
+
+	_cull_convex_elements(p_octant, p_task);
+
+	for (int i = 0; i < 8; i++) {
+
+		if (p_octant->children[i] && p_octant->children[i]->aabb.intersects_convex_shape(p_task->planes, p_task->plane_count)) {
+			_cull_convex_task(p_octant->children[i], p_task);
+		}
+	}
+}
+
+template <class T, bool use_pairs, class AL>
+void Octree<T, use_pairs, AL>::_cull_convex_job(uint32_t p_index, _CullConvexTask *p_tasks) {
+
+	_cull_convex_task(p_tasks[p_index].octant, &p_tasks[p_index]);
+}
+
+template <class T, bool use_pairs, class AL>
+int Octree<T, use_pairs, AL>::cull_convex(const Vector<Plane> &p_convex, Vector<T *> &r_result, uint32_t p_mask, ThreadWorkPool *p_work_pool) {
+
+	if (!root)
+		return 0;
+
+	cull_top_task.planes = &p_convex[0];
+	cull_top_task.plane_count = p_convex.size();
+	cull_top_task.mask = p_mask;
+	cull_top_task.result_count = 0;
+	cull_top_task.shared_count = 0;
+
+	//go down the tree until there are enough subtrees to keep the pool busy, the octants above them are culled here
+	int split = p_work_pool ? p_work_pool->get_thread_count() * 4 : 0;
+
+	int octant_count = 1;
+	int current = 0;
+	if (cull_octants[0].size() == 0)
+		cull_octants[0].resize(64);
+	cull_octants[0].ptr()[0] = root;
+
+	while (octant_count > 0 && octant_count < split) {
+
+		Octant **from = cull_octants[current].ptr();
+		int next_count = 0;
+		bool expanded = false;
+
+		for (int i = 0; i < octant_count; i++) {
+
+			Octant *o = from[i];
+
+			if (o->children_count == 0) {
+				_cull_push(cull_octants[current ^ 1], next_count, o);
+				continue;
+			}
+
+			_cull_convex_elements(o, &cull_top_task);
+			expanded = true;
+
+			for (int j = 0; j < 8; j++) {
+
+				if (o->children[j] && o->children[j]->aabb.intersects_convex_shape(cull_top_task.planes, cull_top_task.plane_count)) {
+					_cull_push(cull_octants[current ^ 1], next_count, o->children[j]);
+				}
+			}
+		}
+
+		current ^= 1;
+		octant_count = next_count;
+
+		if (!expanded)
+			break;
+	}
+
+	if (cull_tasks.size() < octant_count)
+		cull_tasks.resize(octant_count);
+
+	_CullConvexTask *tasks = cull_tasks.ptr();
+	Octant **octants = cull_octants[current].ptr();
+
+	for (int i = 0; i < octant_count; i++) {
+
+		tasks[i].octant = octants[i];
+		tasks[i].planes = cull_top_task.planes;
+		tasks[i].plane_count = cull_top_task.plane_count;
+		tasks[i].mask = p_mask;
+		tasks[i].result_count = 0;
+		tasks[i].shared_count = 0;
+	}
+
+	if (p_work_pool) {
+		p_work_pool->do_work(octant_count, this, &Octree::_cull_convex_job, tasks);
+	} else {
+		for (int i = 0; i < octant_count; i++) {
+			_cull_convex_job(i, tasks);
+		}
+	}
+
+	//gather the results, elements found by more than one task are only added once
+	int result_count = 0;
+	pass++;
+
+	for (int i = -1; i < octant_count; i++) {
+
+		const _CullConvexTask &task = i < 0 ? cull_top_task : tasks[i];
+
+		if (task.result_count) {
+
+			if (r_result.size() < result_count + task.result_count)
+				r_result.resize(MAX(r_result.size() * 2, result_count + task.result_count));
+			copymem(&r_result.ptr()[result_count], task.result.ptr(), task.result_count * sizeof(T *));
+			result_count += task.result_count;
+		}
+
+		Element *const *shared = task.shared.ptr();
+
+		for (int j = 0; j < task.shared_count; j++) {
+
+			Element *e = shared[j];
+			if (e->last_pass == pass)
+				continue;
+			e->last_pass = pass;
+
+			if (e->aabb.intersects_convex_shape(cull_top_task.planes, cull_top_task.plane_count)) {
+				_cull_push(r_result, result_count, e->userdata);
+			}
+		}
+	}
+
+	return result_count;
+}
+
 template <class T, bool use_pairs, class AL>
 int Octree<T, use_pairs, AL>::cull_AABB(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
 
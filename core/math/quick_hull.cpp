@@ -27,11 +27,14 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "quick_hull.h"
-#include "map.h"
+#include "hashfuncs.h"
 
 uint32_t QuickHull::debug_stop_after = 0xFFFFFFFF;
 
-Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh) {
+QuickHull::CacheEntry *QuickHull::cache = NULL;
+Mutex *QuickHull::cache_mutex = NULL;
+
+Error QuickHull::_build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh) {
 
 	static const real_t over_tolerance = 0.0001;
 
@@ -51,22 +54,33 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 		return ERR_CANT_CREATE;
 	}
 
+	const Vector3 *points = p_points.ptr();
+	int point_count = p_points.size();
+
+	//discard duplicates (the first one found is kept), sorting is much cheaper than a set
 	Vector<bool> valid_points;
-	valid_points.resize(p_points.size());
-	Set<Vector3> valid_cache;
+	valid_points.resize(point_count);
 
-	for (int i = 0; i < p_points.size(); i++) {
+	{
+		Vector<SnapPoint> snapped;
+		snapped.resize(point_count);
+		SnapPoint *sw = snapped.ptr();
 
-		Vector3 sp = p_points[i].snapped(0.0001);
-		if (valid_cache.has(sp)) {
-			valid_points[i] = false;
-			//print_line("INVALIDATED: "+itos(i));
-		} else {
-			valid_points[i] = true;
-			valid_cache.insert(sp);
+		for (int i = 0; i < point_count; i++) {
+			sw[i].pos = points[i].snapped(0.0001);
+			sw[i].index = i;
+		}
+
+		snapped.sort();
+
+		bool *vw = valid_points.ptr();
+		for (int i = 0; i < point_count; i++) {
+			vw[sw[i].index] = i == 0 || sw[i].pos != sw[i - 1].pos;
 		}
 	}
 
+	const bool *valid = valid_points.ptr();
+
 	/* CREATE INITIAL SIMPLEX */
 
 	int longest_axis = aabb.get_longest_axis_index();
@@ -77,11 +91,11 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 	{
 		real_t max, min;
 
-		for (int i = 0; i < p_points.size(); i++) {
+		for (int i = 0; i < point_count; i++) {
 
-			if (!valid_points[i])
+			if (!valid[i])
 				continue;
-			float d = p_points[i][longest_axis];
+			float d = points[i][longest_axis];
 			if (i == 0 || d < min) {
 
 				simplex[0] = i;
@@ -99,15 +113,15 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	{
 		float maxd;
-		Vector3 rel12 = p_points[simplex[0]] - p_points[simplex[1]];
+		Vector3 rel12 = points[simplex[0]] - points[simplex[1]];
 
-		for (int i = 0; i < p_points.size(); i++) {
+		for (int i = 0; i < point_count; i++) {
 
-			if (!valid_points[i])
+			if (!valid[i])
 				continue;
 
-			Vector3 n = rel12.cross(p_points[simplex[0]] - p_points[i]).cross(rel12).normalized();
-			real_t d = Math::abs(n.dot(p_points[simplex[0]]) - n.dot(p_points[i]));
+			Vector3 n = rel12.cross(points[simplex[0]] - points[i]).cross(rel12).normalized();
+			real_t d = Math::abs(n.dot(points[simplex[0]]) - n.dot(points[i]));
 
 			if (i == 0 || d > maxd) {
 
@@ -121,14 +135,14 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	{
 		float maxd;
-		Plane p(p_points[simplex[0]], p_points[simplex[1]], p_points[simplex[2]]);
+		Plane p(points[simplex[0]], points[simplex[1]], points[simplex[2]]);
 
-		for (int i = 0; i < p_points.size(); i++) {
+		for (int i = 0; i < point_count; i++) {
 
-			if (!valid_points[i])
+			if (!valid[i])
 				continue;
 
-			real_t d = Math::abs(p.distance_to(p_points[i]));
+			real_t d = Math::abs(p.distance_to(points[i]));
 
 			if (i == 0 || d > maxd) {
 
@@ -136,20 +150,65 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 				simplex[3] = i;
 			}
 		}
+
+		if (maxd <= over_tolerance) {
+			return ERR_CANT_CREATE; //all points lie on a plane or a line, there is no volume
+		}
 	}
 
 	//compute center of simplex, this is a point always warranted to be inside
 	Vector3 center;
 
 	for (int i = 0; i < 4; i++) {
-		center += p_points[simplex[i]];
+		center += points[simplex[i]];
 	}
 
 	center /= 4.0;
 
-	//add faces
+	//all the working memory is allocated here, up front, and reused by every iteration
+
+	int face_count = 0;
+	int face_capacity = point_count * 2 + 16;
+
+	Vector<Face> faces;
+	faces.resize(face_capacity);
+	Face *fw = faces.ptr();
 
-	List<Face> faces;
+	Vector<int> free_faces; //removed faces, ready to be reused
+	free_faces.resize(face_capacity);
+	int free_count = 0;
+
+	Vector<int> point_next; //links the points over each face into a list
+	point_next.resize(point_count);
+	int *pnext = point_next.ptr();
+
+	Vector<int> vertex_face; //new face whose horizon edge starts at each vertex
+	vertex_face.resize(point_count);
+	int *vface = vertex_face.ptr();
+
+	Vector<uint32_t> vertex_pass;
+	vertex_pass.resize(point_count);
+	uint32_t *vpass = vertex_pass.ptr();
+
+	for (int i = 0; i < point_count; i++) {
+		vpass[i] = 0;
+	}
+
+	Vector<int> stack; //pending faces while building, then lit faces and coplanar groups
+	stack.resize(face_capacity);
+
+	Vector<int> lit_faces;
+	lit_faces.resize(face_capacity);
+
+	Vector<int> horizon; //lit face and edge index pairs
+	horizon.resize(face_capacity * 2);
+
+	Vector<int> new_faces;
+	new_faces.resize(face_capacity);
+
+	uint32_t pass = 0;
+
+	//add faces
 
 	for (int i = 0; i < 4; i++) {
 
@@ -160,12 +219,12 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 			{ 1, 2, 3 }
 		};
 
-		Face f;
+		Face &f = fw[face_count++];
 		for (int j = 0; j < 3; j++) {
 			f.vertices[j] = simplex[face_order[i][j]];
 		}
 
-		Plane p(p_points[f.vertices[0]], p_points[f.vertices[1]], p_points[f.vertices[2]]);
+		Plane p(points[f.vertices[0]], points[f.vertices[1]], points[f.vertices[2]]);
 
 		if (p.is_point_over(center)) {
 			//flip face to clockwise if facing inwards
@@ -174,13 +233,41 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 		}
 
 		f.plane = p;
+		f.points_first = -1;
+		f.point_count = 0;
+		f.visit_pass = 0;
+		f.lit = false;
+		f.alive = true;
+	}
+
+	//every edge of the simplex is shared with the face that has it reversed
+	for (int i = 0; i < 4; i++) {
+
+		for (int j = 0; j < 3; j++) {
 
-		faces.push_back(f);
+			int a = fw[i].vertices[j];
+			int b = fw[i].vertices[(j + 1) % 3];
+			fw[i].neighbors[j] = -1;
+
+			for (int k = 0; k < 4 && fw[i].neighbors[j] == -1; k++) {
+
+				if (k == i)
+					continue;
+				for (int l = 0; l < 3; l++) {
+					if (fw[k].vertices[l] == b && fw[k].vertices[(l + 1) % 3] == a) {
+						fw[i].neighbors[j] = k;
+						break;
+					}
+				}
+			}
+
+			ERR_FAIL_COND_V(fw[i].neighbors[j] == -1, ERR_CANT_CREATE);
+		}
 	}
 
 	/* COMPUTE AVAILABLE VERTICES */
 
-	for (int i = 0; i < p_points.size(); i++) {
+	for (int i = 0; i < point_count; i++) {
 
 		if (i == simplex[0])
 			continue;
@@ -190,44 +277,64 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 			continue;
 		if (i == simplex[3])
 			continue;
-		if (!valid_points[i])
+		if (!valid[i])
 			continue;
 
-		for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+		for (int j = 0; j < 4; j++) {
 
-			if (E->get().plane.distance_to(p_points[i]) > over_tolerance) {
+			if (fw[j].plane.distance_to(points[i]) > over_tolerance) {
 
-				E->get().points_over.push_back(i);
+				pnext[i] = fw[j].points_first;
+				fw[j].points_first = i;
+				fw[j].point_count++;
 				break;
 			}
 		}
 	}
 
-	faces.sort(); // sort them, so the ones with points are in the back
+	//faces with the most points are processed first
+	int stack_count = 0;
+
+	for (int i = 0; i < 4; i++) {
+
+		if (fw[i].point_count == 0)
+			continue;
+
+		int pos = stack_count++;
+		while (pos > 0 && fw[stack[pos - 1]].point_count > fw[i].point_count) {
+			stack[pos] = stack[pos - 1];
+			pos--;
+		}
+		stack[pos] = i;
+	}
 
 	/* BUILD HULL */
 
-	//poop face (while still remain)
+	//pop face (while still remain)
 	//find further away point
-	//find lit faces
+	//find lit faces, flooding from the popped one through the neighbors
 	//determine horizon edges
 	//build new faces with horizon edges, them assign points side from all lit faces
 	//remove lit faces
 
 	uint32_t debug_stop = debug_stop_after;
 
-	while (debug_stop > 0 && faces.back()->get().points_over.size()) {
+	while (debug_stop > 0 && stack_count) {
+
+		int fi = stack[--stack_count];
+		if (!fw[fi].alive || fw[fi].point_count == 0)
+			continue;
 
 		debug_stop--;
-		Face &f = faces.back()->get();
+		pass++;
 
 		//find vertex most outside
 		int next = -1;
 		real_t next_d = 0;
 
-		for (int i = 0; i < f.points_over.size(); i++) {
+		for (int i = fw[fi].points_first; i != -1; i = pnext[i]) {
 
-			real_t d = f.plane.distance_to(p_points[f.points_over[i]]);
+			real_t d = fw[fi].plane.distance_to(points[i]);
 
 			if (d > next_d) {
 				next_d = d;
@@ -237,106 +344,156 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 		ERR_FAIL_COND_V(next == -1, ERR_BUG);
 
-		Vector3 v = p_points[f.points_over[next]];
+		Vector3 v = points[next];
 
-		//find lit faces and lit edges
-		List<List<Face>::Element *> lit_faces; //lit face is a death sentence
+		//find lit faces and horizon edges
+		int lit_count = 0;
+		int horizon_count = 0;
 
-		Map<Edge, FaceConnect> lit_edges; //create this on the flight, should not be that bad for performance and simplifies code a lot
+		fw[fi].visit_pass = pass;
+		fw[fi].lit = true;
+		lit_faces[lit_count++] = fi;
 
-		for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+		for (int i = 0; i < lit_count; i++) {
 
-			if (E->get().plane.distance_to(v) > 0) {
+			int li = lit_faces[i];
 
-				lit_faces.push_back(E);
+			for (int j = 0; j < 3; j++) {
 
-				for (int i = 0; i < 3; i++) {
-					uint32_t a = E->get().vertices[i];
-					uint32_t b = E->get().vertices[(i + 1) % 3];
-					Edge e(a, b);
+				int ni = fw[li].neighbors[j];
+				Face &n = fw[ni];
 
-					Map<Edge, FaceConnect>::Element *F = lit_edges.find(e);
-					if (!F) {
-						F = lit_edges.insert(e, FaceConnect());
+				if (n.visit_pass != pass) {
+					n.visit_pass = pass;
+					n.lit = n.plane.distance_to(v) > 0;
+					if (n.lit) {
+						lit_faces[lit_count++] = ni;
 					}
-					if (e.vertices[0] == a) {
-						//left
-						F->get().left = E;
-					} else {
+				}
 
-						F->get().right = E;
-					}
+				if (!n.lit) {
+					horizon[horizon_count * 2 + 0] = li;
+					horizon[horizon_count * 2 + 1] = j;
+					horizon_count++;
 				}
 			}
 		}
 
-		//create new faces from horizon edges
-		List<List<Face>::Element *> new_faces; //new faces
+		//make sure new faces fit, all pointers are taken again if the arrays grow
+		if (face_count + horizon_count > face_capacity) {
 
-		for (Map<Edge, FaceConnect>::Element *E = lit_edges.front(); E; E = E->next()) {
+			face_capacity = MAX(face_capacity * 2, face_count + horizon_count);
+			faces.resize(face_capacity);
+			free_faces.resize(face_capacity);
+			lit_faces.resize(face_capacity);
+			horizon.resize(face_capacity * 2);
+			new_faces.resize(face_capacity);
+			fw = faces.ptr();
+		}
+
+		//create new faces from horizon edges
 
-			FaceConnect &fc = E->get();
-			if (fc.left && fc.right) {
-				continue; //edge is uninteresting, not on horizont
+		for (int i = 0; i < horizon_count; i++) {
+
+			int li = horizon[i * 2 + 0];
+			int le = horizon[i * 2 + 1];
+
+			int a = fw[li].vertices[le];
+			int b = fw[li].vertices[(le + 1) % 3];
+			int ni = fw[li].neighbors[le];
+
+			int idx = free_count ? free_faces[--free_count] : face_count++;
+			Face &face = fw[idx];
+
+			//same winding as the lit face it replaces, so it faces outwards
+			face.vertices[0] = a;
+			face.vertices[1] = b;
+			face.vertices[2] = next;
+			face.plane = Plane(points[a], points[b], points[next]);
+			face.neighbors[0] = ni;
+			face.neighbors[1] = -1;
+			face.neighbors[2] = -1;
+			face.points_first = -1;
+			face.point_count = 0;
+			face.visit_pass = pass;
+			face.lit = false;
+			face.alive = true;
+
+			//repoint the face across the horizon
+			Face &n = fw[ni];
+			for (int j = 0; j < 3; j++) {
+				if (n.vertices[j] == b && n.vertices[(j + 1) % 3] == a) {
+					n.neighbors[j] = idx;
+					break;
+				}
 			}
 
-			//create new face!
+			//horizon edges form a loop, so each vertex starts exactly one of them
+			ERR_FAIL_COND_V(vpass[a] == pass, ERR_BUG);
+			vpass[a] = pass;
+			vface[a] = idx;
 
-			Face face;
-			face.vertices[0] = f.points_over[next];
-			face.vertices[1] = E->key().vertices[0];
-			face.vertices[2] = E->key().vertices[1];
+			new_faces[i] = idx;
+		}
 
-			Plane p(p_points[face.vertices[0]], p_points[face.vertices[1]], p_points[face.vertices[2]]);
+		//stitch new faces together around the new vertex
+		for (int i = 0; i < horizon_count; i++) {
 
-			if (p.is_point_over(center)) {
-				//flip face to clockwise if facing inwards
-				SWAP(face.vertices[0], face.vertices[1]);
-				p = -p;
-			}
+			Face &face = fw[new_faces[i]];
+			int b = face.vertices[1];
 
-			face.plane = p;
-			new_faces.push_back(faces.push_back(face));
+			ERR_FAIL_COND_V(vpass[b] != pass, ERR_BUG);
+			int gi = vface[b];
+			face.neighbors[1] = gi;
+			fw[gi].neighbors[2] = new_faces[i];
 		}
 
 		//distribute points into new faces
 
-		for (List<List<Face>::Element *>::Element *F = lit_faces.front(); F; F = F->next()) {
+		for (int i = 0; i < lit_count; i++) {
 
-			Face &lf = F->get()->get();
+			int p = fw[lit_faces[i]].points_first;
 
-			for (int i = 0; i < lf.points_over.size(); i++) {
+			while (p != -1) {
 
-				if (lf.points_over[i] == f.points_over[next]) //do not add current one
-					continue;
+				int pn = pnext[p];
 
-				Vector3 p = p_points[lf.points_over[i]];
-				for (List<List<Face>::Element *>::Element *E = new_faces.front(); E; E = E->next()) {
+				if (p != next) { //do not add current one
 
-					Face &f2 = E->get()->get();
-					if (f2.plane.distance_to(p) > over_tolerance) {
-						f2.points_over.push_back(lf.points_over[i]);
-						break;
+					for (int j = 0; j < horizon_count; j++) {
+
+						Face &f2 = fw[new_faces[j]];
+						if (f2.plane.distance_to(points[p]) > over_tolerance) {
+							pnext[p] = f2.points_first;
+							f2.points_first = p;
+							f2.point_count++;
+							break;
+						}
 					}
 				}
+
+				p = pn;
 			}
 		}
 
 		//erase lit faces
 
-		while (lit_faces.size()) {
+		for (int i = 0; i < lit_count; i++) {
 
-			faces.erase(lit_faces.front()->get());
-			lit_faces.pop_front();
+			fw[lit_faces[i]].alive = false;
+			free_faces[free_count++] = lit_faces[i];
 		}
 
-		//put faces that contain no points on the front
+		//new faces that got points are processed next, stale entries of recycled faces can pile up in the stack
+
+		if (stack_count + horizon_count > stack.size()) {
+			stack.resize(MAX(stack.size() * 2, stack_count + horizon_count));
+		}
 
-		for (List<List<Face>::Element *>::Element *E = new_faces.front(); E; E = E->next()) {
+		for (int i = 0; i < horizon_count; i++) {
 
-			Face &f2 = E->get()->get();
-			if (f2.points_over.size() == 0) {
-				faces.move_to_front(E->get());
+			if (fw[new_faces[i]].point_count) {
+				stack[stack_count++] = new_faces[i];
 			}
 		}
 
@@ -345,131 +502,228 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	/* CREATE MESHDATA */
 
-	//make a map of edges again
-	Map<Edge, RetFaceConnect> ret_edges;
-	List<Geometry::MeshData::Face> ret_faces;
+	//neighbor faces lying on the same plane are merged into a single polygon
 
-	for (List<Face>::Element *E = faces.front(); E; E = E->next()) {
+	int group_count = 0;
 
-		Geometry::MeshData::Face f;
-		f.plane = E->get().plane;
+	if (stack.size() < face_count) {
+		stack.resize(face_count);
+	}
 
-		for (int i = 0; i < 3; i++) {
-			f.indices.push_back(E->get().vertices[i]);
-		}
+	for (int i = 0; i < face_count; i++) {
+		fw[i].group = -1;
+	}
 
-		List<Geometry::MeshData::Face>::Element *F = ret_faces.push_back(f);
+	for (int i = 0; i < face_count; i++) {
 
-		for (int i = 0; i < 3; i++) {
+		if (!fw[i].alive || fw[i].group != -1)
+			continue;
 
-			uint32_t a = E->get().vertices[i];
-			uint32_t b = E->get().vertices[(i + 1) % 3];
-			Edge e(a, b);
+		const Plane &plane = fw[i].plane;
+		int group = group_count++;
 
-			Map<Edge, RetFaceConnect>::Element *G = ret_edges.find(e);
-			if (!G) {
-				G = ret_edges.insert(e, RetFaceConnect());
-			}
-			if (e.vertices[0] == a) {
-				//left
-				G->get().left = F;
-			} else {
+		fw[i].group = group;
+		stack_count = 0;
+		stack[stack_count++] = i;
+
+		while (stack_count) {
+
+			Face &f = fw[stack[--stack_count]];
+
+			for (int j = 0; j < 3; j++) {
 
-				G->get().right = F;
+				Face &n = fw[f.neighbors[j]];
+				if (n.group == -1 && n.plane.is_almost_like(plane)) {
+					n.group = group;
+					stack[stack_count++] = f.neighbors[j];
+				}
 			}
 		}
 	}
 
-	//fill faces
+	//sort the faces by group, so each polygon is built from its own faces only
 
-	for (List<Geometry::MeshData::Face>::Element *E = ret_faces.front(); E; E = E->next()) {
+	Vector<int> group_offsets;
+	group_offsets.resize(group_count + 1);
+	int *goffs = group_offsets.ptr();
 
-		Geometry::MeshData::Face &f = E->get();
+	for (int i = 0; i <= group_count; i++) {
+		goffs[i] = 0;
+	}
 
-		for (int i = 0; i < f.indices.size(); i++) {
+	for (int i = 0; i < face_count; i++) {
+		if (fw[i].alive) {
+			goffs[fw[i].group + 1]++;
+		}
+	}
 
-			uint32_t a = E->get().indices[i];
-			uint32_t b = E->get().indices[(i + 1) % f.indices.size()];
-			Edge e(a, b);
+	for (int i = 0; i < group_count; i++) {
+		goffs[i + 1] += goffs[i];
+	}
 
-			Map<Edge, RetFaceConnect>::Element *F = ret_edges.find(e);
+	int *group_faces = stack.ptr();
+	int *group_fill = new_faces.ptr();
 
-			ERR_CONTINUE(!F);
+	for (int i = 0; i < group_count; i++) {
+		group_fill[i] = goffs[i];
+	}
 
-			List<Geometry::MeshData::Face>::Element *O = F->get().left == E ? F->get().right : F->get().left;
-			ERR_CONTINUE(O == E);
-			ERR_CONTINUE(O == NULL);
+	for (int i = 0; i < face_count; i++) {
+		if (fw[i].alive) {
+			group_faces[group_fill[fw[i].group]++] = i;
+		}
+	}
 
-			if (O->get().plane.is_almost_like(f.plane)) {
-				//merge and delete edge and contiguous face, while repointing edges (uuugh!)
-				int ois = O->get().indices.size();
-				int merged = 0;
+	r_mesh.faces.clear();
+	r_mesh.faces.resize(group_count);
+	r_mesh.edges.clear();
 
-				for (int j = 0; j < ois; j++) {
-					//search a
-					if (O->get().indices[j] == a) {
-						//append the rest
-						for (int k = 0; k < ois; k++) {
+	Geometry::MeshData::Face *rfaces = r_mesh.faces.ptr();
+	int edge_count = 0;
 
-							int idx = O->get().indices[(k + j) % ois];
-							int idxn = O->get().indices[(k + j + 1) % ois];
-							if (idx == b && idxn == a) { //already have b!
-								break;
-							}
-							if (idx != a) {
-								f.indices.insert(i + 1, idx);
-								i++;
-								merged++;
-							}
-							Edge e2(idx, idxn);
+	for (int i = 0; i < group_count; i++) {
 
-							Map<Edge, RetFaceConnect>::Element *F2 = ret_edges.find(e2);
+		pass++;
 
-							ERR_CONTINUE(!F2);
-							//change faceconnect, point to this face instead
-							if (F2->get().left == O)
-								F2->get().left = E;
-							else if (F2->get().right == O)
-								F2->get().right = E;
-						}
+		//chain the boundary edges by the vertex they start from, vertices inside the polygon are never reached
+		int start = -1;
+		int boundary_count = 0;
 
-						break;
-					}
+		for (int j = goffs[i]; j < goffs[i + 1]; j++) {
+
+			const Face &f = fw[group_faces[j]];
+
+			for (int k = 0; k < 3; k++) {
+
+				if (fw[f.neighbors[k]].group == i)
+					continue; //merged away
+
+				int a = f.vertices[k];
+				int b = f.vertices[(k + 1) % 3];
+				vface[a] = b;
+				vpass[a] = pass;
+				start = a;
+				boundary_count++;
+
+				if (a < b) {
+					edge_count++;
 				}
+			}
+		}
+
+		ERR_CONTINUE(start == -1);
+
+		Geometry::MeshData::Face &rf = rfaces[i];
+		rf.plane = fw[group_faces[goffs[i]]].plane;
+		rf.indices.resize(boundary_count);
+		int *rfi = rf.indices.ptr();
+
+		int vtx = start;
+		int index_count = 0;
+		do {
+			ERR_BREAK(vpass[vtx] != pass);
+			rfi[index_count++] = vtx;
+			vtx = vface[vtx];
+		} while (vtx != start && index_count < boundary_count);
+
+		rf.indices.resize(index_count);
+	}
+
+	r_mesh.edges.resize(edge_count);
+	Geometry::MeshData::Edge *redges = r_mesh.edges.ptr();
+	int edge_idx = 0;
+
+	for (int i = 0; i < face_count; i++) {
 
-				ret_edges.erase(F); //remove the edge
-				ret_faces.erase(O); //remove the face
+		if (!fw[i].alive)
+			continue;
+
+		const Face &f = fw[i];
+
+		for (int j = 0; j < 3; j++) {
+
+			int a = f.vertices[j];
+			int b = f.vertices[(j + 1) % 3];
+
+			if (a < b && fw[f.neighbors[j]].group != f.group) {
+				redges[edge_idx].a = a;
+				redges[edge_idx].b = b;
+				edge_idx++;
 			}
 		}
 	}
 
-	//fill mesh
-	r_mesh.faces.clear();
-	r_mesh.faces.resize(ret_faces.size());
-	//	print_line("FACECOUNT: "+itos(r_mesh.faces.size()));
+	r_mesh.vertices = p_points;
 
-	int idx = 0;
-	for (List<Geometry::MeshData::Face>::Element *E = ret_faces.front(); E; E = E->next()) {
-		r_mesh.faces[idx++] = E->get();
+	return OK;
+}
+
+uint32_t QuickHull::_hash_points(const Vector<Vector3> &p_points) {
+
+	return hash_djb2_buffer((const uint8_t *)p_points.ptr(), p_points.size() * sizeof(Vector3), hash_djb2_one_32(p_points.size()));
+}
+
+Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh) {
+
+	if (!cache_mutex || debug_stop_after != 0xFFFFFFFF) {
+		return _build(p_points, r_mesh);
 	}
-	r_mesh.edges.resize(ret_edges.size());
-	idx = 0;
-	for (Map<Edge, RetFaceConnect>::Element *E = ret_edges.front(); E; E = E->next()) {
-
-		Geometry::MeshData::Edge e;
-		e.a = E->key().vertices[0];
-		e.b = E->key().vertices[1];
-		r_mesh.edges[idx++] = e;
+
+	uint32_t hash = _hash_points(p_points);
+	CacheEntry &entry = cache[hash % CACHE_SIZE];
+
+	cache_mutex->lock();
+	if (entry.hash == hash && entry.points.size() == p_points.size()) {
+
+		bool equal = true;
+		const Vector<Vector3> &cached_points = entry.points; //const access, so no copy on write is triggered
+		const Vector3 *a = cached_points.ptr();
+		const Vector3 *b = p_points.ptr();
+		for (int i = 0; i < p_points.size(); i++) {
+			if (a[i] != b[i]) {
+				equal = false;
+				break;
+			}
+		}
+
+		if (equal) {
+			r_mesh = entry.mesh; //copy on write, nothing is duplicated here
+			cache_mutex->unlock();
+			return OK;
+		}
 	}
+	cache_mutex->unlock();
 
-	r_mesh.vertices = p_points;
+	Error err = _build(p_points, r_mesh);
+	if (err != OK)
+		return err;
 
-	//r_mesh.optimize_vertices();
-	/*
-	print_line("FACES: "+itos(r_mesh.faces.size()));
-	print_line("EDGES: "+itos(r_mesh.edges.size()));
-	print_line("VERTICES: "+itos(r_mesh.vertices.size()));
-*/
+	cache_mutex->lock();
+	entry.hash = hash;
+	entry.points = p_points;
+	entry.mesh = r_mesh;
+	cache_mutex->unlock();
 
 	return OK;
 }
+
+void QuickHull::create_cache() {
+
+	ERR_FAIL_COND(cache_mutex);
+	cache = memnew_arr(CacheEntry, CACHE_SIZE);
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		cache[i].hash = 0;
+	}
+	cache_mutex = Mutex::create();
+}
+
+void QuickHull::free_cache() {
+
+	if (!cache_mutex)
+		return;
+
+	memdelete(cache_mutex);
+	cache_mutex = NULL;
+	memdelete_arr(cache);
+	cache = NULL;
+}
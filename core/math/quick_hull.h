@@ -31,8 +31,7 @@
 
 #include "aabb.h"
 #include "geometry.h"
-#include "list.h"
-#include "set.h"
+#include "os/mutex.h"
 
 class QuickHull {
 
@@ -59,37 +58,55 @@ public:
 		}
 	};
 
+private:
+	//faces live in a flat array and refer to each other by index, removed ones are recycled
 	struct Face {
 
 		Plane plane;
 		int vertices[3];
-		Vector<int> points_over;
+		int neighbors[3]; //face across the edge that goes from vertices[i] to vertices[(i+1)%3]
+		int points_first; //points over this face, chained through the point_next array
+		int point_count;
+		uint32_t visit_pass;
+		bool lit;
+		bool alive;
+		int group; //coplanar group, used when building the mesh
+	};
+
+	struct SnapPoint {
 
-		bool operator<(const Face &p_face) const {
+		Vector3 pos;
+		int index;
 
-			return points_over.size() < p_face.points_over.size();
+		bool operator<(const SnapPoint &p_point) const {
+			return pos == p_point.pos ? index < p_point.index : pos < p_point.pos;
 		}
 	};
 
-private:
-	struct FaceConnect {
-		List<Face>::Element *left, *right;
-		FaceConnect() {
-			left = NULL;
-			right = NULL;
-		}
+	//hulls are cached by point cloud contents, so shapes built again and again from the same points (debris, instanced props) skip the work
+	enum {
+		CACHE_SIZE = 64
 	};
-	struct RetFaceConnect {
-		List<Geometry::MeshData::Face>::Element *left, *right;
-		RetFaceConnect() {
-			left = NULL;
-			right = NULL;
-		}
+
+	struct CacheEntry {
+
+		uint32_t hash;
+		Vector<Vector3> points;
+		Geometry::MeshData mesh;
 	};
 
+	static CacheEntry *cache;
+	static Mutex *cache_mutex;
+
+	static uint32_t _hash_points(const Vector<Vector3> &p_points);
+	static Error _build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh);
+
 public:
 	static uint32_t debug_stop_after;
 	static Error build(const Vector<Vector3> &p_points, Geometry::MeshData &r_mesh);
+
+	static void create_cache();
+	static void free_cache();
 };
 
 #endif // QUICK_HULL_H
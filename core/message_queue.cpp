@@ -28,46 +28,150 @@
 /*************************************************************************/
 #include "message_queue.h"
 #include "globals.h"
+#include "os/os.h"
+#include "os/trace.h"
 #include "script_language.h"
 MessageQueue *MessageQueue::singleton = NULL;
 
+#ifdef _THREAD_LOCAL_
+//producer of the calling thread, valid while the queue id matches
+static _THREAD_LOCAL_ void *_message_queue_producer = NULL;
+static _THREAD_LOCAL_ uint32_t _message_queue_id = 0;
+#endif
+
+static uint32_t _message_queue_last_id = 0;
+
 MessageQueue *MessageQueue::get_singleton() {
 
 	return singleton;
 }
 
-Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
+MessageQueue::Producer *MessageQueue::_get_producer() {
+
+#ifdef _THREAD_LOCAL_
+	if (_message_queue_id == id)
+		return (Producer *)_message_queue_producer;
+#endif
+
+	Thread::ID thread_id = Thread::get_caller_ID();
+
+	mutex->lock();
+
+	Producer *p = producers;
+	while (p && p->thread_id != thread_id) {
+		p = p->next;
+	}
+
+	if (!p) {
+		//threads that finish leave their producer behind, it's reused if the ID comes back
+		p = memnew(Producer);
+		p->thread_id = thread_id;
+		p->mutex = Mutex::create();
+		p->first = NULL;
+		p->last = NULL;
+		p->spare = NULL;
+		p->flush_page = NULL;
+		p->flush_pos = 0;
+		p->next = producers;
+		producers = p;
+	}
+
+	mutex->unlock();
+
+#ifdef _THREAD_LOCAL_
+	_message_queue_producer = p;
+	_message_queue_id = id;
+#endif
+
+	return p;
+}
+
+uint8_t *MessageQueue::_alloc_message(Producer *p_producer, uint32_t p_size) {
+
+	//called with the producer locked
+	Page *page = p_producer->last;
+
+	if (!page || page->used + p_size > page->size) {
+
+		if (p_producer->spare && p_size <= p_producer->spare->size) {
+			page = p_producer->spare;
+			p_producer->spare = NULL;
+		} else {
+			uint32_t size = MAX(page_size, p_size);
+			page = (Page *)memalloc(DATA_OFFSET + size);
+			page->size = size;
+		}
+
+		page->next = NULL;
+		page->used = 0;
+
+		if (p_producer->last)
+			p_producer->last->next = page;
+		else
+			p_producer->first = page;
+		p_producer->last = page;
+	}
 
-	_THREAD_SAFE_METHOD_
+	uint8_t *ptr = page->get_data() + page->used;
+	page->used += p_size;
+	return ptr;
+}
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+void MessageQueue::_free_page(Producer *p_producer, Page *p_page) {
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_type();
-		print_line("failed method: " + type + ":" + p_method + " target ID: " + itos(p_id));
-		statistics();
+	p_producer->mutex->lock();
+	if (!p_producer->spare && p_page->size == page_size) {
+		p_producer->spare = p_page;
+		p_page = NULL;
 	}
+	p_producer->mutex->unlock();
+
+	if (p_page)
+		memfree(p_page);
+}
+
+uint32_t MessageQueue::_get_message_size(const Message *p_message) {
+
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION)
+		size += sizeof(Variant) * p_message->args;
+	return size;
+}
+
+void MessageQueue::_destroy_message(Message *p_message) {
+
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+	}
+	p_message->~Message();
+}
+
+Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 
-	ERR_FAIL_COND_V((buffer_end + room_needed) >= buffer_size, ERR_OUT_OF_MEMORY);
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Producer *producer = _get_producer();
+	producer->mutex->lock();
+
+	Message *msg = memnew_placement(_alloc_message(producer, sizeof(Message) + sizeof(Variant) * p_argcount), Message);
 	msg->args = p_argcount;
 	msg->instance_ID = p_id;
+	msg->sequence = sequence.refval();
 	msg->target = p_method;
 	msg->type = TYPE_CALL;
 	if (p_show_error)
 		msg->type |= FLAG_SHOW_ERROR;
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
 
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
+		Variant *v = memnew_placement(&args[i], Variant);
 		*v = *p_args[i];
 	}
 
+	producer->mutex->unlock();
+
 	return OK;
 }
 
@@ -88,60 +192,39 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
 
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_type();
-		print_line("failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-	}
-
-	ERR_FAIL_COND_V((buffer_end + room_needed) >= buffer_size, ERR_OUT_OF_MEMORY);
+	Producer *producer = _get_producer();
+	producer->mutex->lock();
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(_alloc_message(producer, sizeof(Message) + sizeof(Variant)), Message);
 	msg->args = 1;
 	msg->instance_ID = p_id;
+	msg->sequence = sequence.refval();
 	msg->target = p_prop;
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
+	Variant *v = memnew_placement((Variant *)(msg + 1), Variant);
 	*v = p_value;
 
+	producer->mutex->unlock();
+
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
 
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id))
-			type = ObjectDB::get_instance(p_id)->get_type();
-		print_line("failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-	}
-
-	ERR_FAIL_COND_V((buffer_end + room_needed) >= buffer_size, ERR_OUT_OF_MEMORY);
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Producer *producer = _get_producer();
+	producer->mutex->lock();
 
+	Message *msg = memnew_placement(_alloc_message(producer, sizeof(Message)), Message);
 	msg->type = TYPE_NOTIFICATION;
 	msg->instance_ID = p_id;
+	msg->sequence = sequence.refval();
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	producer->mutex->unlock();
 
 	return OK;
 }
@@ -166,57 +249,72 @@ void MessageQueue::statistics() {
 	Map<int, int> notify_count;
 	Map<StringName, int> call_count;
 	int null_count = 0;
+	uint32_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	mutex->lock();
+	Producer *first_producer = producers;
+	mutex->unlock();
 
-		Object *target = ObjectDB::get_instance(message->instance_ID);
+	for (Producer *p = first_producer; p; p = p->next) {
 
-		if (target != NULL) {
+		p->mutex->lock();
 
-			switch (message->type & FLAG_MASK) {
+		for (Page *page = p->first; page; page = page->next) {
 
-				case TYPE_CALL: {
+			total_bytes += page->used;
 
-					if (!call_count.has(message->target))
-						call_count[message->target] = 0;
+			uint32_t read_pos = 0;
+			while (read_pos < page->used) {
+				Message *message = (Message *)&page->get_data()[read_pos];
 
-					call_count[message->target]++;
+				Object *target = ObjectDB::get_instance(message->instance_ID);
 
-				} break;
-				case TYPE_NOTIFICATION: {
+				if (target != NULL) {
 
-					if (!notify_count.has(message->notification))
-						notify_count[message->notification] = 0;
+					switch (message->type & FLAG_MASK) {
 
-					notify_count[message->notification]++;
+						case TYPE_CALL: {
 
-				} break;
-				case TYPE_SET: {
+							if (!call_count.has(message->target))
+								call_count[message->target] = 0;
 
-					if (!set_count.has(message->target))
-						set_count[message->target] = 0;
+							call_count[message->target]++;
 
-					set_count[message->target]++;
+						} break;
+						case TYPE_NOTIFICATION: {
 
-				} break;
-			}
+							if (!notify_count.has(message->notification))
+								notify_count[message->notification] = 0;
 
-			//object was deleted
-			//WARN_PRINT("Object was deleted while awaiting a callback")
-			//should it print a warning?
-		} else {
+							notify_count[message->notification]++;
+
+						} break;
+						case TYPE_SET: {
+
+							if (!set_count.has(message->target))
+								set_count[message->target] = 0;
+
+							set_count[message->target]++;
+
+						} break;
+					}
+
+					//object was deleted
+					//WARN_PRINT("Object was deleted while awaiting a callback")
+					//should it print a warning?
+				} else {
+
+					null_count++;
+				}
 
-			null_count++;
+				read_pos += _get_message_size(message);
+			}
 		}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		p->mutex->unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (Map<StringName, int>::Element *E = set_count.front(); E; E = E->next()) {
@@ -281,6 +379,20 @@ int MessageQueue::get_max_buffer_usage() const {
 	return buffer_max_used;
 }
 
+uint64_t MessageQueue::read_flush_time() {
+
+	uint64_t time = flush_time;
+	flush_time = 0;
+	return time;
+}
+
+int MessageQueue::read_flush_max_messages() {
+
+	int max_messages = flush_max_messages;
+	flush_max_messages = 0;
+	return max_messages;
+}
+
 void MessageQueue::_call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error) {
 
 	const Variant **argptrs = NULL;
@@ -299,72 +411,127 @@ void MessageQueue::_call_function(Object *p_target, const StringName &p_func, co
 	}
 }
 
-void MessageQueue::flush() {
+bool MessageQueue::_take_pages() {
+
+	//every producer is locked at once, so the pages taken hold whatever was pushed before any later message
+	mutex->lock();
 
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-		//statistics();
+	for (Producer *p = producers; p; p = p->next) {
+		p->mutex->lock();
 	}
 
-	uint32_t read_pos = 0;
+	bool taken = false;
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
+	for (Producer *p = producers; p; p = p->next) {
 
-	while (read_pos < buffer_end) {
+		//the producer starts a new page list on the next push
+		p->flush_page = p->first;
+		p->flush_pos = 0;
+		p->first = NULL;
+		p->last = NULL;
+		if (p->flush_page)
+			taken = true;
+	}
 
-		_THREAD_SAFE_UNLOCK_
+	//messages are only compared within what is taken here, so numbering can restart
+	sequence.init(1);
 
-		//lock on each interation, so a call can re-add itself to the message queue
+	for (Producer *p = producers; p; p = p->next) {
+		p->mutex->unlock();
+	}
 
-		Message *message = (Message *)&buffer[read_pos];
+	mutex->unlock();
 
-		Object *target = ObjectDB::get_instance(message->instance_ID);
+	return taken;
+}
 
-		if (target != NULL) {
+void MessageQueue::flush() {
 
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
+	TRACE_ZONE("MessageQueue::flush");
 
-					Variant *args = (Variant *)(message + 1);
+	uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t messages = 0;
+	uint32_t bytes = 0;
 
-					// messages don't expect a return value
+	//messages can push more messages while they run, keep going until every producer is empty
+	while (_take_pages()) {
 
-					_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
+		mutex->lock();
+		Producer *first_producer = producers;
+		mutex->unlock();
 
-					for (int i = 0; i < message->args; i++) {
-						args[i].~Variant();
-					}
+		while (true) {
+
+			//run the oldest message among the producers, only a few threads ever push so a scan is enough
+			Producer *producer = NULL;
+			Message *message = NULL;
+
+			for (Producer *p = first_producer; p; p = p->next) {
+
+				if (!p->flush_page)
+					continue;
+
+				Message *m = (Message *)&p->flush_page->get_data()[p->flush_pos];
+				if (!message || m->sequence < message->sequence) {
+					producer = p;
+					message = m;
+				}
+			}
+
+			if (!message)
+				break;
+
+			Object *target = ObjectDB::get_instance(message->instance_ID);
+
+			if (target != NULL) {
+
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+
+						Variant *args = (Variant *)(message + 1);
+
+						// messages don't expect a return value
 
-				} break;
-				case TYPE_NOTIFICATION: {
+						_call_function(target, message->target, args, message->args, message->type & FLAG_SHOW_ERROR);
 
-					// messages don't expect a return value
-					target->notification(message->notification);
+					} break;
+					case TYPE_NOTIFICATION: {
 
-				} break;
-				case TYPE_SET: {
+						// messages don't expect a return value
+						target->notification(message->notification);
 
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->target, *arg);
+					} break;
+					case TYPE_SET: {
 
-					arg->~Variant();
-				} break;
+						Variant *arg = (Variant *)(message + 1);
+						// messages don't expect a return value
+						target->set(message->target, *arg);
+
+					} break;
+				}
 			}
-		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			advance += sizeof(Variant) * message->args;
-		message->~Message();
+			producer->flush_pos += _get_message_size(message);
+			_destroy_message(message);
+			messages++;
 
-		_THREAD_SAFE_LOCK_
-		read_pos += advance;
+			Page *page = producer->flush_page;
+			if (producer->flush_pos >= page->used) {
+
+				bytes += page->used;
+				producer->flush_page = page->next;
+				producer->flush_pos = 0;
+				_free_page(producer, page);
+			}
+		}
 	}
 
-	buffer_end = 0; // reset buffer
-	_THREAD_SAFE_UNLOCK_
+	if (bytes > buffer_max_used)
+		buffer_max_used = bytes;
+
+	flush_time += OS::get_singleton()->get_ticks_usec() - flush_begin;
+	if (messages > flush_max_messages)
+		flush_max_messages = messages;
 }
 
 MessageQueue::MessageQueue() {
@@ -372,33 +539,48 @@ MessageQueue::MessageQueue() {
 	ERR_FAIL_COND(singleton != NULL);
 	singleton = this;
 
-	buffer_end = 0;
+	mutex = Mutex::create();
+	producers = NULL;
+	sequence.init(1);
+	id = ++_message_queue_last_id;
+
 	buffer_max_used = 0;
-	buffer_size = GLOBAL_DEF("core/message_queue_size_kb", DEFAULT_QUEUE_SIZE_KB);
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	flush_time = 0;
+	flush_max_messages = 0;
+	page_size = GLOBAL_DEF("core/message_queue_page_size_kb", DEFAULT_PAGE_SIZE_KB);
+	page_size *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
 
-	uint32_t read_pos = 0;
+	while (producers) {
 
-	while (read_pos < buffer_end) {
+		Producer *p = producers;
+		producers = p->next;
 
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++)
-				args[i].~Variant();
+		while (p->first) {
+
+			Page *page = p->first;
+			p->first = page->next;
+
+			uint32_t read_pos = 0;
+			while (read_pos < page->used) {
+
+				Message *message = (Message *)&page->get_data()[read_pos];
+				read_pos += _get_message_size(message);
+				_destroy_message(message);
+			}
+
+			memfree(page);
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION)
-			read_pos += sizeof(Variant) * message->args;
+		if (p->spare)
+			memfree(p->spare);
+
+		memdelete(p->mutex);
+		memdelete(p);
 	}
 
+	memdelete(mutex);
 	singleton = NULL;
-	memdelete_arr(buffer);
 }
@@ -31,18 +31,26 @@
 
 #include "object.h"
 #include "os/mutex.h"
-#include "os/thread_safe.h"
-class MessageQueue {
+#include "os/thread.h"
+#include "safe_refcount.h"
+
+/**
+ * Deferred calls, sets and notifications, run on the main thread by flush().
+ * Each thread that pushes messages gets its own producer, a list of pages the
+ * messages are written into, so threads never wait on each other while pushing.
+ * flush() takes the pending pages of every producer in one go and runs them without
+ * holding any lock, merged by a sequence number so they run in the order they were
+ * pushed, across threads too. Pages are added as needed, so the queue never runs
+ * out of room.
+ */
 
-	_THREAD_SAFE_CLASS_
+class MessageQueue {
 
 	enum {
 
-		DEFAULT_QUEUE_SIZE_KB = 1024
+		DEFAULT_PAGE_SIZE_KB = 64
 	};
 
-	Mutex *mutex;
-
 	enum {
 		TYPE_CALL,
 		TYPE_NOTIFICATION,
@@ -55,6 +63,7 @@ class MessageQueue {
 	struct Message {
 
 		ObjectID instance_ID;
+		uint32_t sequence; //push order across producers, restarts on every flush round
 		StringName target;
 		int16_t type;
 		union {
@@ -63,10 +72,49 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end;
+	struct Page {
+
+		Page *next;
+		uint32_t used;
+		uint32_t size;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return ((uint8_t *)this) + DATA_OFFSET; }
+	};
+
+	enum {
+		//keep messages (and the variants that follow them) aligned
+		DATA_OFFSET = (sizeof(Page) + 15) & ~15
+	};
+
+	struct Producer {
+
+		Thread::ID thread_id;
+		Mutex *mutex; //only contended by flush() taking the pages
+		Page *first;
+		Page *last;
+		Page *spare; //kept after a flush, so steady traffic doesn't allocate
+		Page *flush_page; //read position of flush(), in the pages it took
+		uint32_t flush_pos;
+		Producer *next;
+	};
+
+	Mutex *mutex; //guards the producer list, only taken when a thread pushes for the first time
+	Producer *producers;
+	SafeRefCount sequence; //taken with the producer locked, so flush() can restart it while holding every producer
+	uint32_t id;
+	uint32_t page_size;
+
 	uint32_t buffer_max_used;
-	uint32_t buffer_size;
+
+	uint64_t flush_time;
+	uint32_t flush_max_messages;
+
+	Producer *_get_producer();
+	uint8_t *_alloc_message(Producer *p_producer, uint32_t p_size);
+	void _free_page(Producer *p_producer, Page *p_page);
+	bool _take_pages();
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
 	void _call_function(Object *p_target, const StringName &p_func, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -90,6 +138,10 @@ public:
 
 	int get_max_buffer_usage() const;
 
+	//flush statistics since the previous read, used by the performance monitors
+	uint64_t read_flush_time();
+	int read_flush_max_messages();
+
 	MessageQueue();
 	~MessageQueue();
 };
@@ -31,6 +31,7 @@
 #include "globals.h"
 #include "input.h"
 #include "os/file_access.h"
+#include "os/trace.h"
 #include <stdarg.h>
 // For get_engine_version, could be removed if it's moved to a new Engine singleton
 #include "version.h"
@@ -187,6 +188,21 @@ void OS::dump_memory_to_file(const char *p_file) {
 	Memory::dump_static_mem_to_file(p_file);
 }
 
+Error OS::dump_trace_to_file(const char *p_file) {
+
+	return Trace::save_json(p_file);
+}
+
+void OS::set_tracing_enabled(bool p_enabled) {
+
+	Trace::set_enabled(p_enabled);
+}
+
+bool OS::is_tracing_enabled() const {
+
+	return Trace::is_enabled();
+}
+
 static FileAccess *_OSPRF = NULL;
 
 static void _OS_printres(Object *p_obj) {
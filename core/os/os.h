@@ -314,6 +314,10 @@ public:
 	virtual bool get_swap_ok_cancel() { return false; }
 	virtual void dump_memory_to_file(const char *p_file);
 	virtual void dump_resources_to_file(const char *p_file);
+	virtual Error dump_trace_to_file(const char *p_file);
+
+	void set_tracing_enabled(bool p_enabled);
+	bool is_tracing_enabled() const;
 	virtual void print_resources_in_use(bool p_short = false);
 	virtual void print_all_resources(String p_to_file = "");
 
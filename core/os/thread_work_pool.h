@@ -0,0 +1,148 @@
+/*************************************************************************/
+/*  thread_work_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "os/memory.h"
+#include "os/mutex.h"
+#include "os/semaphore.h"
+#include "os/thread.h"
+
+/**
+ * Small fixed-size pool of worker threads used to run "parallel for" style
+ * jobs. The calling thread takes part in the work and do_work() only returns
+ * once every element has been processed, so callers can treat it as a plain
+ * (if unordered) loop. With zero threads everything runs on the caller.
+ */
+
+class ThreadWorkPool {
+
+	struct BaseWork {
+
+		Mutex *mutex;
+		uint32_t index;
+		uint32_t max_elements;
+
+		_FORCE_INLINE_ uint32_t claim() {
+
+			mutex->lock();
+			uint32_t idx = index++;
+			mutex->unlock();
+			return idx;
+		}
+
+		virtual void work() = 0;
+		virtual ~BaseWork() {}
+	};
+
+	template <class C, class M, class U>
+	struct Work : public BaseWork {
+
+		C *instance;
+		M method;
+		U userdata;
+
+		virtual void work() {
+
+			while (true) {
+				uint32_t work_index = claim();
+				if (work_index >= max_elements)
+					break;
+				(instance->*method)(work_index, userdata);
+			}
+		}
+	};
+
+	struct ThreadData {
+
+		ThreadWorkPool *pool;
+		Thread *thread;
+		Semaphore *start;
+		Semaphore *completed;
+		BaseWork *work;
+		bool exit;
+	};
+
+	ThreadData *threads;
+	int thread_count;
+	bool working;
+	Mutex *mutex;
+
+	static void _thread_function(void *p_user);
+
+public:
+	template <class C, class M, class U>
+	void do_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+
+		if (thread_count == 0 || p_elements < 2 || working) {
+			//nothing to gain from the threads (or called from within a job), run in place
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+			return;
+		}
+
+		Work<C, M, U> w;
+		w.mutex = mutex;
+		w.index = 0;
+		w.max_elements = p_elements;
+		w.instance = p_instance;
+		w.method = p_method;
+		w.userdata = p_userdata;
+
+		working = true;
+
+		int used_threads = MIN(thread_count, (int)p_elements - 1);
+
+		for (int i = 0; i < used_threads; i++) {
+			threads[i].work = &w;
+			threads[i].start->post();
+		}
+
+		w.work();
+
+		for (int i = 0; i < used_threads; i++) {
+			threads[i].completed->wait();
+			threads[i].work = NULL;
+		}
+
+		working = false;
+	}
+
+	_FORCE_INLINE_ bool is_working() const { return working; }
+	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
+
+	void init(int p_thread_count = -1);
+	void finish();
+
+	ThreadWorkPool();
+	~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -0,0 +1,229 @@
+/*************************************************************************/
+/*  trace.cpp                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "trace.h"
+#include "globals.h"
+#include "os/file_access.h"
+
+#ifdef _THREAD_LOCAL_
+//cached per thread so recording never has to look the buffer up
+static _THREAD_LOCAL_ void *_trace_thread_buffer = NULL;
+static _THREAD_LOCAL_ const char *_trace_thread_name = NULL;
+#endif
+
+volatile bool Trace::enabled = false;
+Mutex *Trace::mutex = NULL;
+Trace::ThreadBuffer *Trace::buffers = NULL;
+uint32_t Trace::buffer_size = 65536;
+
+Trace::ThreadBuffer *Trace::_get_thread_buffer() {
+
+#ifdef _THREAD_LOCAL_
+	if (_trace_thread_buffer)
+		return (ThreadBuffer *)_trace_thread_buffer;
+#endif
+
+	if (!mutex)
+		return NULL;
+
+	Thread::ID id = Thread::get_caller_ID();
+
+	mutex->lock();
+
+	ThreadBuffer *tb = buffers;
+	while (tb && tb->thread_id != id) {
+		tb = tb->next;
+	}
+
+	if (!tb) {
+		//first zone recorded by this thread (or a thread that reused the ID of a finished one)
+		tb = memnew(ThreadBuffer);
+		tb->thread_id = id;
+		tb->thread_name = NULL;
+		tb->events = memnew_arr(Event, buffer_size);
+		tb->mask = buffer_size - 1;
+		tb->written = 0;
+		tb->next = buffers;
+		buffers = tb;
+	}
+
+#ifdef _THREAD_LOCAL_
+	if (_trace_thread_name)
+		tb->thread_name = _trace_thread_name;
+	_trace_thread_buffer = tb;
+#endif
+
+	mutex->unlock();
+
+	return tb;
+}
+
+void Trace::set_enabled(bool p_enabled) {
+
+	ERR_FAIL_COND(!mutex);
+	enabled = p_enabled;
+}
+
+void Trace::set_thread_name(const char *p_name) {
+
+#ifdef _THREAD_LOCAL_
+	_trace_thread_name = p_name;
+	if (_trace_thread_buffer)
+		((ThreadBuffer *)_trace_thread_buffer)->thread_name = p_name;
+#else
+	//without thread locals, only threads that already recorded can be named
+	if (!mutex)
+		return;
+
+	Thread::ID id = Thread::get_caller_ID();
+	mutex->lock();
+	for (ThreadBuffer *tb = buffers; tb; tb = tb->next) {
+		if (tb->thread_id == id)
+			tb->thread_name = p_name;
+	}
+	mutex->unlock();
+#endif
+}
+
+void Trace::clear() {
+
+	if (!mutex)
+		return;
+
+	mutex->lock();
+	for (ThreadBuffer *tb = buffers; tb; tb = tb->next) {
+		tb->written = 0;
+	}
+	mutex->unlock();
+}
+
+void Trace::record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+
+	if (!enabled)
+		return;
+
+	ThreadBuffer *tb = _get_thread_buffer();
+	if (!tb)
+		return;
+
+	Event &e = tb->events[tb->written & tb->mask];
+	e.name = p_name;
+	e.begin = p_begin;
+	e.end = p_end;
+	tb->written++;
+}
+
+Error Trace::save_json(const String &p_path) {
+
+	ERR_FAIL_COND_V(!mutex, ERR_UNCONFIGURED);
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_EXPLAIN("Can't save trace to file: " + p_path);
+	ERR_FAIL_COND_V(err, err);
+
+	//stop recording while the buffers are read, so the rings don't wrap under us
+	bool was_enabled = enabled;
+	enabled = false;
+
+	mutex->lock();
+
+	f->store_string("{\"traceEvents\":[\n");
+
+	bool first = true;
+	int tid = 0;
+
+	for (ThreadBuffer *tb = buffers; tb; tb = tb->next) {
+
+		tid++;
+
+		String thread_name;
+		if (tb->thread_name)
+			thread_name = tb->thread_name;
+		else if (tb->thread_id == Thread::get_main_ID())
+			thread_name = "main";
+		else
+			thread_name = "thread " + itos(tid);
+
+		String tid_str = itos(tid);
+
+		if (!first)
+			f->store_string(",\n");
+		first = false;
+		f->store_string("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid_str + ",\"args\":{\"name\":\"" + thread_name.json_escape() + "\"}}");
+
+		uint32_t written = tb->written;
+		uint32_t count = MIN(written, tb->mask + 1);
+
+		for (uint32_t i = written - count; i != written; i++) {
+
+			const Event &e = tb->events[i & tb->mask];
+			f->store_string(",\n{\"name\":\"" + String(e.name).json_escape() + "\",\"ph\":\"X\",\"ts\":" + itos(e.begin) + ",\"dur\":" + itos(e.end - e.begin) + ",\"pid\":1,\"tid\":" + tid_str + "}");
+		}
+	}
+
+	f->store_string("\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	mutex->unlock();
+
+	enabled = was_enabled;
+
+	f->close();
+	memdelete(f);
+
+	return OK;
+}
+
+void Trace::initialize() {
+
+	int size = GLOBAL_DEF("debug/trace_buffer_events", 65536);
+	ERR_FAIL_COND(size < 1);
+	buffer_size = nearest_power_of_2(size);
+	mutex = Mutex::create();
+}
+
+void Trace::finalize() {
+
+	enabled = false;
+
+	while (buffers) {
+		ThreadBuffer *tb = buffers;
+		buffers = tb->next;
+		memdelete_arr(tb->events);
+		memdelete(tb);
+	}
+
+#ifdef _THREAD_LOCAL_
+	_trace_thread_buffer = NULL;
+#endif
+
+	if (mutex) {
+		memdelete(mutex);
+		mutex = NULL;
+	}
+}
@@ -0,0 +1,116 @@
+/*************************************************************************/
+/*  trace.h                                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "os/mutex.h"
+#include "os/os.h"
+#include "os/thread.h"
+#include "ustring.h"
+
+/**
+ * Lightweight timeline tracer. Zones are recorded as begin/duration pairs into
+ * a ring buffer owned by the recording thread, so no lock is taken while
+ * tracing (only the first time a thread records, to register its buffer).
+ * When a ring fills up the oldest zones are overwritten. The result can be
+ * saved in the Chrome trace event format, which chrome://tracing and Perfetto
+ * can open.
+ *
+ * Zone names must be string literals (or otherwise outlive the tracer), only
+ * the pointer is stored.
+ */
+
+class Trace {
+public:
+	struct Event {
+
+		const char *name;
+		uint64_t begin;
+		uint64_t end;
+	};
+
+private:
+	struct ThreadBuffer {
+
+		Thread::ID thread_id;
+		const char *thread_name;
+		Event *events;
+		uint32_t mask;
+		volatile uint32_t written;
+		ThreadBuffer *next;
+	};
+
+	static volatile bool enabled;
+	static Mutex *mutex;
+	static ThreadBuffer *buffers;
+	static uint32_t buffer_size;
+
+	static ThreadBuffer *_get_thread_buffer();
+
+public:
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+
+	static void set_enabled(bool p_enabled);
+	static void set_thread_name(const char *p_name);
+	static void clear();
+
+	static void record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+	static Error save_json(const String &p_path);
+
+	static void initialize();
+	static void finalize();
+};
+
+class TraceZone {
+
+	const char *name;
+	uint64_t begin;
+
+public:
+	_FORCE_INLINE_ TraceZone(const char *p_name) {
+
+		if (Trace::is_enabled()) {
+			name = p_name;
+			begin = OS::get_singleton()->get_ticks_usec();
+		} else {
+			name = NULL;
+		}
+	}
+
+	_FORCE_INLINE_ ~TraceZone() {
+
+		if (name)
+			Trace::record(name, begin, OS::get_singleton()->get_ticks_usec());
+	}
+};
+
+//records the enclosing scope as a zone, at most one per scope
+#define TRACE_ZONE(m_name) TraceZone _trace_zone(m_name)
+
+#endif // TRACE_H
@@ -47,6 +47,7 @@
 #include "io/tcp_server.h"
 #include "io/translation_loader_po.h"
 #include "math/a_star.h"
+#include "math/quick_hull.h"
 #include "object_type_db.h"
 #include "os/input.h"
 #include "os/main_loop.h"
@@ -82,6 +83,7 @@ void register_core_types() {
 	_global_mutex = Mutex::create();
 
 	StringName::setup();
+	QuickHull::create_cache();
 
 	register_variant_methods();
 
@@ -200,6 +202,7 @@ void unregister_core_types() {
 	ObjectTypeDB::cleanup();
 	ResourceCache::clear();
 	CoreStringNames::free();
+	QuickHull::free_cache();
 	StringName::cleanup();
 
 	if (_global_mutex) {
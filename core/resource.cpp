@@ -152,26 +152,31 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	if (path_cache == p_path)
 		return;
 
-	if (path_cache != "") {
+	{
+		//resources can be loaded from several threads at once
+		GLOBAL_LOCK_FUNCTION
 
-		ResourceCache::resources.erase(path_cache);
-	}
+		if (path_cache != "") {
 
-	path_cache = "";
-	if (ResourceCache::resources.has(p_path)) {
-		if (p_take_over) {
+			ResourceCache::resources.erase(path_cache);
+		}
+
+		path_cache = "";
+		if (ResourceCache::resources.has(p_path)) {
+			if (p_take_over) {
 
-			ResourceCache::resources.get(p_path)->set_name("");
-		} else {
-			ERR_EXPLAIN("Another resource is loaded from path: " + p_path);
-			ERR_FAIL_COND(ResourceCache::resources.has(p_path));
+				ResourceCache::resources.get(p_path)->set_name("");
+			} else {
+				ERR_EXPLAIN("Another resource is loaded from path: " + p_path);
+				ERR_FAIL_COND(ResourceCache::resources.has(p_path));
+			}
 		}
-	}
-	path_cache = p_path;
+		path_cache = p_path;
 
-	if (path_cache != "") {
+		if (path_cache != "") {
 
-		ResourceCache::resources[path_cache] = this;
+			ResourceCache::resources[path_cache] = this;
+		}
 	}
 
 	_change_notify("resource/path");
@@ -363,8 +368,10 @@ Resource::Resource() {
 
 Resource::~Resource() {
 
-	if (path_cache != "")
+	if (path_cache != "") {
+		GLOBAL_LOCK_FUNCTION
 		ResourceCache::resources.erase(path_cache);
+	}
 	if (owners.size()) {
 		WARN_PRINT("Resource is still owned");
 	}
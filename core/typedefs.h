@@ -74,6 +74,15 @@
 #endif
 #endif
 
+//storage class for per-thread variables, left undefined where it can't be relied on (users must then fall back to a lookup by thread ID)
+#ifndef _THREAD_LOCAL_
+#if defined(__GNUC__) && !defined(IPHONE_ENABLED)
+#define _THREAD_LOCAL_ __thread
+#elif defined(_MSC_VER)
+#define _THREAD_LOCAL_ __declspec(thread)
+#endif
+#endif
+
 #ifndef DEFAULT_ALIGNMENT
 #define DEFAULT_ALIGNMENT 1
 #endif
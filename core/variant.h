@@ -119,6 +119,7 @@ public:
 
 private:
 	friend class _VariantCall;
+	friend class GDFunction;
 	// Variant takes 20 bytes when real_t is float, and 36 if double
 	// it only allocates extra memory for aabb/matrix.
 
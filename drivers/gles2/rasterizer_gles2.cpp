@@ -8533,12 +8533,7 @@ void RasterizerGLES2::_canvas_normal_set_flip(const Vector2 &p_flip) {
 template <bool use_normalmap>
 void RasterizerGLES2::_canvas_item_render_commands(CanvasItem *p_item, CanvasItem *current_clip, bool &reclip) {
 
-	int cc = p_item->commands.size();
-	CanvasItem::Command **commands = p_item->commands.ptr();
-
-	for (int i = 0; i < cc; i++) {
-
-		CanvasItem::Command *c = commands[i];
+	for (CanvasItem::Command *c = p_item->commands; c; c = c->next) {
 
 		switch (c->type) {
 			case CanvasItem::Command::TYPE_LINE: {
@@ -8806,9 +8801,14 @@ void RasterizerGLES2::canvas_render_items(CanvasItem *p_item_list, int p_z, cons
 	bool reset_modulate = false;
 	bool prev_distance_field = false;
 
+	//consecutive items sharing state are merged into single draws, the rest are drawn one by one
+	canvas_batcher.build(p_item_list, p_z, p_modulate, p_light);
+	int batch_idx = 0;
+
 	while (p_item_list) {
 
 		CanvasItem *ci = p_item_list;
+		const CanvasBatcher::Batch &batch = canvas_batcher.get_batch(batch_idx++);
 
 		if (ci->vp_render) {
 			if (draw_viewport_func) {
@@ -8956,7 +8956,8 @@ void RasterizerGLES2::canvas_render_items(CanvasItem *p_item_list, int p_z, cons
 			reset_modulate = false;
 		}
 
-		canvas_shader.set_uniform(CanvasShaderGLES2::MODELVIEW_MATRIX, ci->final_transform);
+		//batched vertices are already in canvas space
+		canvas_shader.set_uniform(CanvasShaderGLES2::MODELVIEW_MATRIX, batch.geometry ? Matrix32() : ci->final_transform);
 		canvas_shader.set_uniform(CanvasShaderGLES2::EXTRA_MATRIX, Matrix32());
 
 		bool reclip = false;
@@ -9000,6 +9001,20 @@ void RasterizerGLES2::canvas_render_items(CanvasItem *p_item_list, int p_z, cons
 
 		canvas_opacity = ci->final_opacity;
 
+		if (batch.geometry) {
+
+			//opacity is baked in the vertex colors, batched items are never lit
+			canvas_opacity = 1.0;
+			if (batch.index_count) {
+				canvas_draw_polygon(batch.index_count, &canvas_batcher.get_indices()[batch.index_from], &canvas_batcher.get_points()[batch.vertex_from], &canvas_batcher.get_uvs()[batch.vertex_from], &canvas_batcher.get_colors()[batch.vertex_from], batch.texture, false);
+			}
+
+			for (int i = 0; i < batch.item_count; i++) {
+				p_item_list = p_item_list->next;
+			}
+			continue;
+		}
+
 		if (unshaded || (p_modulate.a > 0.001 && (!material || material->shading_mode != VS::CANVAS_ITEM_SHADING_ONLY_LIGHT) && !ci->light_masked))
 			_canvas_item_render_commands<false>(ci, current_clip, reclip);
 
@@ -10693,6 +10708,12 @@ RasterizerGLES2::RasterizerGLES2(bool p_compress_arrays, bool p_keep_ram_copy, b
 	use_shadow_mapping = true;
 	use_fast_texture_filter = !bool(GLOBAL_DEF("rasterizer/trilinear_mipmap_filter", true));
 	low_memory_2d = bool(GLOBAL_DEF("rasterizer/low_memory_2d_mode", false));
+	canvas_batcher.set_rasterizer(this);
+#ifdef GLES_NO_CLIENT_ARRAYS
+	canvas_batcher.set_enabled(false); //polygons are copied through a fixed size buffer
+#else
+	canvas_batcher.set_enabled(GLOBAL_DEF("rasterizer/canvas_batching", true));
+#endif
 	skel_default.resize(1024 * 4);
 	for (int i = 0; i < 1024 / 3; i++) {
 
@@ -30,6 +30,7 @@
 #define RASTERIZER_GLES2_H
 
 #include "servers/visual/rasterizer.h"
+#include "servers/visual/canvas_batcher.h"
 
 #define MAX_POLYGON_VERTICES 4096 //used for WebGL canvas_draw_polygon call.
 
@@ -1220,6 +1221,7 @@ class RasterizerGLES2 : public Rasterizer {
 	RID canvas_tex;
 	float canvas_opacity;
 	Color canvas_modulate;
+	CanvasBatcher canvas_batcher;
 	bool canvas_use_modulate;
 	bool uses_texpixel_size;
 	bool rebind_texpixel_size;
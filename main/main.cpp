@@ -35,6 +35,7 @@
 #include "message_queue.h"
 #include "modules/register_module_types.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "path_remap.h"
 #include "scene/main/scene_main_loop.h"
 #include "scene/register_scene_types.h"
@@ -106,6 +107,7 @@ static bool force_lowdpi = false;
 static int init_screen = -1;
 static bool use_vsync = true;
 static bool editor = false;
+static String trace_file;
 
 static String unescape_cmdline(const String &p_str) {
 
@@ -170,6 +172,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("\t-rdebug ADDRESS : Remote debug (<ip>:<port> host address).\n");
 	OS::get_singleton()->print("\t-fdelay [msec]: Simulate high CPU load (delay each frame by [msec]).\n");
 	OS::get_singleton()->print("\t-timescale [msec]: Simulate high CPU load (delay each frame by [msec]).\n");
+	OS::get_singleton()->print("\t-trace [file]: Record a timeline of the engine frame and save it to [file] on exit (Chrome trace format).\n");
 	OS::get_singleton()->print("\t-bp : breakpoint list as source::line comma separated pairs, no spaces (%%20,%%2C,etc instead).\n");
 	OS::get_singleton()->print("\t-v : Verbose stdout mode\n");
 	OS::get_singleton()->print("\t-lang [locale]: Use a specific locale\n");
@@ -462,6 +465,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 
+		} else if (I->get() == "-trace") { // timeline trace
+
+			if (I->next()) {
+
+				trace_file = I->next()->get();
+				N = I->next()->next();
+			} else {
+				goto error;
+			}
+
 		} else if (I->get() == "-timescale") { // resolution
 
 			if (I->next()) {
@@ -780,6 +793,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	message_queue = memnew(MessageQueue);
 
+	Trace::initialize();
+	if (trace_file != "") {
+		Trace::set_enabled(true);
+	}
+
+	ResourceLoader::initialize();
+
 	Globals::get_singleton()->register_global_defaults();
 
 	if (p_second_phase)
@@ -1459,6 +1479,8 @@ static uint64_t idle_process_max = 0;
 
 bool Main::iteration() {
 
+	TRACE_ZONE("Main::iteration");
+
 	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	uint64_t ticks_elapsed = ticks - last_ticks;
 
@@ -1488,6 +1510,8 @@ bool Main::iteration() {
 
 	while (time_accum > frame_slice) {
 
+		TRACE_ZONE("Main::fixed_process");
+
 		uint64_t fixed_begin = OS::get_singleton()->get_ticks_usec();
 
 		PhysicsServer::get_singleton()->sync();
@@ -1503,6 +1527,7 @@ bool Main::iteration() {
 
 		message_queue->flush();
 
+		PhysicsServer::get_singleton()->end_sync();
 		PhysicsServer::get_singleton()->step(frame_slice * time_scale);
 
 		Physics2DServer::get_singleton()->end_sync();
@@ -1574,6 +1599,7 @@ bool Main::iteration() {
 		OS::get_singleton()->_fps = frames;
 		performance->set_process_time(USEC_TO_SEC(idle_process_max));
 		performance->set_fixed_process_time(USEC_TO_SEC(fixed_process_max));
+		performance->update_frame_monitors(frame, frames);
 		idle_process_max = 0;
 		fixed_process_max = 0;
 
@@ -1616,6 +1642,15 @@ void Main::cleanup() {
 
 	ERR_FAIL_COND(!_start_success);
 
+	if (trace_file != "") {
+		Error err = OS::get_singleton()->dump_trace_to_file(trace_file.utf8().get_data());
+		if (err == OK)
+			print_line("Trace saved to: " + trace_file);
+	}
+
+	//background loads can't outlive the servers they load into
+	ResourceLoader::finalize();
+
 	if (script_debugger) {
 		if (use_debug_profiler) {
 			script_debugger->profiling_end();
@@ -1658,6 +1693,8 @@ void Main::cleanup() {
 
 	memdelete(message_queue);
 
+	Trace::finalize();
+
 	unregister_core_driver_types();
 	unregister_core_types();
 
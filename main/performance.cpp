@@ -27,9 +27,11 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "performance.h"
+#include "io/resource_loader.h"
 #include "message_queue.h"
 #include "os/os.h"
 #include "scene/main/scene_main_loop.h"
+#include "servers/audio_server.h"
 #include "servers/physics_2d_server.h"
 #include "servers/physics_server.h"
 #include "servers/visual_server.h"
@@ -66,6 +68,17 @@ void Performance::_bind_methods() {
 	BIND_CONSTANT(PHYSICS_3D_ACTIVE_OBJECTS);
 	BIND_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
+	BIND_CONSTANT(PHYSICS_2D_BROAD_PHASE_TIME);
+	BIND_CONSTANT(PHYSICS_2D_NARROW_PHASE_TIME);
+	BIND_CONSTANT(PHYSICS_2D_SOLVE_TIME);
+	BIND_CONSTANT(PHYSICS_3D_BROAD_PHASE_TIME);
+	BIND_CONSTANT(PHYSICS_3D_NARROW_PHASE_TIME);
+	BIND_CONSTANT(PHYSICS_3D_SOLVE_TIME);
+	BIND_CONSTANT(MESSAGE_QUEUE_FLUSH_TIME);
+	BIND_CONSTANT(MESSAGE_QUEUE_DEPTH);
+	BIND_CONSTANT(SCENE_GROUP_CALLS);
+	BIND_CONSTANT(AUDIO_MIX_TIME);
+	BIND_CONSTANT(RESOURCE_LOAD_BYTES_PER_SEC);
 
 	BIND_CONSTANT(MONITOR_MAX);
 }
@@ -102,6 +115,17 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/active_objects",
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
+		"physics_2d/broad_phase_time",
+		"physics_2d/narrow_phase_time",
+		"physics_2d/solve_time",
+		"physics_3d/broad_phase_time",
+		"physics_3d/narrow_phase_time",
+		"physics_3d/solve_time",
+		"message_queue/flush_time",
+		"message_queue/depth",
+		"scene/group_calls",
+		"audio/mix_time",
+		"loader/bytes_per_sec",
 
 	};
 
@@ -147,6 +171,17 @@ float Performance::get_monitor(Monitor p_monitor) const {
 		case PHYSICS_3D_ACTIVE_OBJECTS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ACTIVE_OBJECTS);
 		case PHYSICS_3D_COLLISION_PAIRS: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS);
 		case PHYSICS_3D_ISLAND_COUNT: return PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_ISLAND_COUNT);
+		case PHYSICS_2D_BROAD_PHASE_TIME: return USEC_TO_SEC(Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_BROAD_PHASE_TIME));
+		case PHYSICS_2D_NARROW_PHASE_TIME: return USEC_TO_SEC(Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_NARROW_PHASE_TIME));
+		case PHYSICS_2D_SOLVE_TIME: return USEC_TO_SEC(Physics2DServer::get_singleton()->get_process_info(Physics2DServer::INFO_SOLVE_TIME));
+		case PHYSICS_3D_BROAD_PHASE_TIME: return USEC_TO_SEC(PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_BROAD_PHASE_TIME));
+		case PHYSICS_3D_NARROW_PHASE_TIME: return USEC_TO_SEC(PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_NARROW_PHASE_TIME));
+		case PHYSICS_3D_SOLVE_TIME: return USEC_TO_SEC(PhysicsServer::get_singleton()->get_process_info(PhysicsServer::INFO_SOLVE_TIME));
+		case MESSAGE_QUEUE_FLUSH_TIME: return _message_queue_flush_time;
+		case MESSAGE_QUEUE_DEPTH: return _message_queue_depth;
+		case SCENE_GROUP_CALLS: return _group_calls;
+		case AUDIO_MIX_TIME: return _audio_mix_time;
+		case RESOURCE_LOAD_BYTES_PER_SEC: return _load_bytes_per_sec;
 
 		default: {}
 	}
@@ -164,9 +199,34 @@ void Performance::set_fixed_process_time(float p_pt) {
 	_fixed_process_time = p_pt;
 }
 
+void Performance::update_frame_monitors(uint64_t p_usec, int p_frames) {
+
+	//called once per measuring period, counters are read (and reset) here and averaged per frame
+	if (p_frames < 1)
+		p_frames = 1;
+
+	_message_queue_flush_time = USEC_TO_SEC(MessageQueue::get_singleton()->read_flush_time()) / p_frames;
+	_message_queue_depth = MessageQueue::get_singleton()->read_flush_max_messages();
+
+	_group_calls = 0;
+	MainLoop *ml = OS::get_singleton()->get_main_loop();
+	SceneTree *sml = ml ? ml->cast_to<SceneTree>() : NULL;
+	if (sml) {
+		_group_calls = sml->read_group_call_count() / float(p_frames);
+	}
+
+	_audio_mix_time = AudioServer::get_singleton() ? USEC_TO_SEC(AudioServer::get_singleton()->read_chunk_mix_time()) : 0;
+	_load_bytes_per_sec = p_usec ? ResourceLoader::read_loaded_bytes() / USEC_TO_SEC(p_usec) : 0;
+}
+
 Performance::Performance() {
 
 	_process_time = 0;
 	_fixed_process_time = 0;
+	_message_queue_flush_time = 0;
+	_message_queue_depth = 0;
+	_group_calls = 0;
+	_audio_mix_time = 0;
+	_load_bytes_per_sec = 0;
 	singleton = this;
 }
@@ -44,6 +44,12 @@ class Performance : public Object {
 	float _process_time;
 	float _fixed_process_time;
 
+	float _message_queue_flush_time;
+	int _message_queue_depth;
+	float _group_calls;
+	float _audio_mix_time;
+	float _load_bytes_per_sec;
+
 public:
 	enum Monitor {
 
@@ -74,6 +80,17 @@ public:
 		PHYSICS_3D_ACTIVE_OBJECTS,
 		PHYSICS_3D_COLLISION_PAIRS,
 		PHYSICS_3D_ISLAND_COUNT,
+		PHYSICS_2D_BROAD_PHASE_TIME,
+		PHYSICS_2D_NARROW_PHASE_TIME,
+		PHYSICS_2D_SOLVE_TIME,
+		PHYSICS_3D_BROAD_PHASE_TIME,
+		PHYSICS_3D_NARROW_PHASE_TIME,
+		PHYSICS_3D_SOLVE_TIME,
+		MESSAGE_QUEUE_FLUSH_TIME,
+		MESSAGE_QUEUE_DEPTH,
+		SCENE_GROUP_CALLS,
+		AUDIO_MIX_TIME,
+		RESOURCE_LOAD_BYTES_PER_SEC,
 		//physics
 		MONITOR_MAX
 	};
@@ -83,6 +100,7 @@ public:
 
 	void set_process_time(float p_pt);
 	void set_fixed_process_time(float p_pt);
+	void update_frame_monitors(uint64_t p_usec, int p_frames);
 
 	static Performance *get_singleton() { return singleton; }
 
@@ -0,0 +1,209 @@
+/*************************************************************************/
+/*  test_canvas_batch.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_canvas_batch.h"
+
+#include "print_string.h"
+#include "servers/visual/rasterizer_recording.h"
+
+//checks the draw calls issued for typical canvas item lists once they go through the batching stage,
+//using the recording rasterizer so no GPU is needed.
+//
+//usage: -test canvas_batch
+
+namespace TestCanvasBatch {
+
+typedef Rasterizer::CanvasItem CanvasItem;
+
+enum {
+	SPRITE_COUNT = 5000,
+	ATLAS_SIZE = 1024,
+	FRAME_SIZE = 32
+};
+
+struct Scene {
+
+	Vector<CanvasItem *> items;
+	Rasterizer::CanvasItemMaterial shader_material;
+
+	CanvasItem *get_list() {
+
+		for (int i = 0; i < items.size(); i++) {
+			items[i]->next = i + 1 < items.size() ? items[i + 1] : NULL;
+		}
+		return items.size() ? items[0] : NULL;
+	}
+
+	CanvasItem *add_sprite(int p_index, RID p_texture) {
+
+		CanvasItem *ci = memnew(CanvasItem);
+		ci->final_transform = Matrix32(0.1 * p_index, Vector2((p_index % 100) * 10, (p_index / 100) * 10));
+		ci->final_opacity = 1.0;
+
+		CanvasItem::CommandRect *rect = ci->alloc_command<CanvasItem::CommandRect>();
+		rect->rect = Rect2(-FRAME_SIZE / 2, -FRAME_SIZE / 2, FRAME_SIZE, FRAME_SIZE);
+		rect->texture = p_texture;
+		rect->modulate = Color(1, 1, 1);
+		rect->source = Rect2((p_index % 32) * FRAME_SIZE, ((p_index / 32) % 32) * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE);
+		rect->flags = Rasterizer::CANVAS_RECT_REGION;
+
+		items.push_back(ci);
+		return ci;
+	}
+
+	~Scene() {
+
+		for (int i = 0; i < items.size(); i++) {
+			memdelete(items[i]);
+		}
+	}
+};
+
+static int failed = 0;
+
+static void _check(const String &p_name, RasterizerRecording *p_rasterizer, CanvasItem *p_list, int p_expected_draws) {
+
+	p_rasterizer->clear_draw_calls();
+	p_rasterizer->canvas_render_items(p_list, 0, Color(1, 1, 1), NULL);
+
+	int draws = p_rasterizer->get_draw_call_count();
+	bool ok = draws == p_expected_draws;
+	if (!ok)
+		failed++;
+
+	print_line(p_name + ": " + itos(draws) + " draw calls, " + itos(p_rasterizer->get_batch_count()) + " batches" + (ok ? "" : " FAILED, expected " + itos(p_expected_draws)));
+}
+
+MainLoop *test() {
+
+	RasterizerRecording *rasterizer = memnew(RasterizerRecording);
+
+	RID atlas = rasterizer->texture_create();
+	rasterizer->texture_allocate(atlas, ATLAS_SIZE, ATLAS_SIZE, Image::FORMAT_RGBA, VS::TEXTURE_FLAGS_DEFAULT);
+	RID other = rasterizer->texture_create();
+	rasterizer->texture_allocate(other, ATLAS_SIZE, ATLAS_SIZE, Image::FORMAT_RGBA, VS::TEXTURE_FLAGS_DEFAULT);
+
+	int per_batch = CanvasBatcher::MAX_BATCH_INDICES / 6;
+	int atlas_batches = (SPRITE_COUNT + per_batch - 1) / per_batch;
+
+	failed = 0;
+
+	{
+		Scene scene;
+		for (int i = 0; i < SPRITE_COUNT; i++)
+			scene.add_sprite(i, atlas);
+
+		_check("sprites sharing an atlas", rasterizer, scene.get_list(), atlas_batches);
+
+		//batches are cut at the index limit
+		const RasterizerRecording::DrawCall &dc = rasterizer->get_draw_call(0);
+		if (dc.item_count != per_batch || dc.vertex_count != per_batch * 4 || dc.index_count != per_batch * 6) {
+			print_line("batch size: FAILED, " + itos(dc.item_count) + " items, " + itos(dc.vertex_count) + " vertices, " + itos(dc.index_count) + " indices");
+			failed++;
+		}
+
+		rasterizer->set_canvas_batching(false);
+		_check("sprites sharing an atlas, batching disabled", rasterizer, scene.get_list(), SPRITE_COUNT);
+		rasterizer->set_canvas_batching(true);
+	}
+
+	{
+		Scene scene;
+		for (int i = 0; i < SPRITE_COUNT; i++)
+			scene.add_sprite(i, (i & 1) ? other : atlas);
+
+		_check("sprites alternating textures", rasterizer, scene.get_list(), SPRITE_COUNT);
+	}
+
+	{
+		Scene scene;
+		for (int i = 0; i < SPRITE_COUNT; i++) {
+			CanvasItem *ci = scene.add_sprite(i, atlas);
+			ci->final_clip_owner = scene.items[(i / 100) * 100];
+		}
+
+		_check("sprites in clipped groups of 100", rasterizer, scene.get_list(), SPRITE_COUNT / 100);
+	}
+
+	{
+		Scene scene;
+		for (int i = 0; i < SPRITE_COUNT; i++) {
+			CanvasItem *ci = scene.add_sprite(i, atlas);
+			ci->blend_mode = (i / 1000) & 1 ? VS::MATERIAL_BLEND_MODE_ADD : VS::MATERIAL_BLEND_MODE_MIX;
+		}
+
+		_check("sprites in blend mode groups of 1000", rasterizer, scene.get_list(), SPRITE_COUNT / 1000);
+	}
+
+	{
+		Scene scene;
+		scene.shader_material.shader = atlas; //any valid rid marks the material as shaded
+		for (int i = 0; i < 100; i++) {
+			CanvasItem *ci = scene.add_sprite(i, atlas);
+			ci->material = &scene.shader_material;
+		}
+
+		_check("sprites with a shader material", rasterizer, scene.get_list(), 100);
+	}
+
+	{
+		Scene scene;
+		for (int i = 0; i < 100; i++) {
+			CanvasItem *ci = scene.add_sprite(i, atlas);
+			CanvasItem::CommandPolygon *polygon = ci->alloc_command<CanvasItem::CommandPolygon>();
+			polygon->points.push_back(Vector2(0, 0));
+			polygon->points.push_back(Vector2(10, 0));
+			polygon->points.push_back(Vector2(0, 10));
+			polygon->uvs = polygon->points;
+			polygon->colors.push_back(Color(1, 0, 0));
+			polygon->indices.push_back(0);
+			polygon->indices.push_back(1);
+			polygon->indices.push_back(2);
+			polygon->count = 3;
+			polygon->texture = atlas;
+		}
+
+		_check("sprites with polygons", rasterizer, scene.get_list(), 1);
+
+		scene.items[50]->alloc_command<CanvasItem::CommandLine>();
+		_check("sprites with polygons, one item with a line", rasterizer, scene.get_list(), 1 + 3 + 1);
+	}
+
+	rasterizer->free(atlas);
+	rasterizer->free(other);
+	memdelete(rasterizer);
+
+	if (failed) {
+		print_line("canvas batch test: " + itos(failed) + " checks FAILED");
+	} else {
+		print_line("canvas batch test: passed");
+	}
+
+	return NULL;
+}
+}
@@ -566,10 +566,31 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 			switch (code[ip]) {
 
+				case GDFunction::OPCODE_OPERATOR_ADD_INT:
+				case GDFunction::OPCODE_OPERATOR_SUB_INT:
+				case GDFunction::OPCODE_OPERATOR_MUL_INT:
+				case GDFunction::OPCODE_OPERATOR_DIV_INT:
+				case GDFunction::OPCODE_OPERATOR_MOD_INT:
+				case GDFunction::OPCODE_OPERATOR_EQUAL_INT:
+				case GDFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+				case GDFunction::OPCODE_OPERATOR_LESS_INT:
+				case GDFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+				case GDFunction::OPCODE_OPERATOR_GREATER_INT:
+				case GDFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+				case GDFunction::OPCODE_OPERATOR_ADD_REAL:
+				case GDFunction::OPCODE_OPERATOR_SUB_REAL:
+				case GDFunction::OPCODE_OPERATOR_MUL_REAL:
+				case GDFunction::OPCODE_OPERATOR_DIV_REAL:
+				case GDFunction::OPCODE_OPERATOR_EQUAL_REAL:
+				case GDFunction::OPCODE_OPERATOR_NOT_EQUAL_REAL:
+				case GDFunction::OPCODE_OPERATOR_LESS_REAL:
+				case GDFunction::OPCODE_OPERATOR_LESS_EQUAL_REAL:
+				case GDFunction::OPCODE_OPERATOR_GREATER_REAL:
+				case GDFunction::OPCODE_OPERATOR_GREATER_EQUAL_REAL:
 				case GDFunction::OPCODE_OPERATOR: {
 
 					int op = code[ip + 1];
-					txt += "op ";
+					txt += code[ip] == GDFunction::OPCODE_OPERATOR ? "op " : "typed op ";
 
 					String opname = Variant::get_operator_name(Variant::Operator(op));
 
@@ -611,20 +632,20 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += "[\"";
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]=";
-					txt += DADDR(3);
-					incr += 4;
+					txt += DADDR(4);
+					incr += 5;
 
 				} break;
 				case GDFunction::OPCODE_GET_NAMED: {
 
 					txt += " get_named ";
-					txt += DADDR(3);
+					txt += DADDR(4);
 					txt += "=";
 					txt += DADDR(1);
 					txt += "[\"";
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]";
-					incr += 4;
+					incr += 5;
 
 				} break;
 				case GDFunction::OPCODE_ASSIGN: {
@@ -724,7 +745,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(5 + argc) + "=";
 					}
 
 					txt += DADDR(2) + ".";
@@ -734,11 +755,11 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					for (int i = 0; i < argc; i++) {
 						if (i > 0)
 							txt += ", ";
-						txt += DADDR(4 + i);
+						txt += DADDR(5 + i);
 					}
 					txt += ")";
 
-					incr = 5 + argc;
+					incr = 6 + argc;
 
 				} break;
 				case GDFunction::OPCODE_CALL_BUILT_IN: {
@@ -31,6 +31,7 @@
 
 #ifdef DEBUG_ENABLED
 
+#include "test_canvas_batch.h"
 #include "test_containers.h"
 #include "test_detailer.h"
 #include "test_gdscript.h"
@@ -42,8 +43,10 @@
 #include "test_particles.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
+#include "test_physics_bench.h"
 #include "test_python.h"
 #include "test_render.h"
+#include "test_sat.h"
 #include "test_shader_lang.h"
 #include "test_sound.h"
 #include "test_string.h"
@@ -61,6 +64,9 @@ const char **tests_get_names() {
 		"io",
 		"shaderlang",
 		"physics",
+		"physics_bench",
+		"sat",
+		"canvas_batch",
 		NULL
 	};
 
@@ -94,6 +100,21 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestPhysics2D::test();
 	}
 
+	if (p_test == "physics_bench") {
+
+		return TestPhysicsBench::test(p_args);
+	}
+
+	if (p_test == "canvas_batch") {
+
+		return TestCanvasBatch::test();
+	}
+
+	if (p_test == "sat") {
+
+		return TestSAT::test();
+	}
+
 	if (p_test == "misc") {
 
 		return TestMisc::test();
@@ -0,0 +1,701 @@
+/*************************************************************************/
+/*  test_physics_bench.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_physics_bench.h"
+
+#include "hashfuncs.h"
+#include "math_funcs.h"
+#include "os/os.h"
+#include "print_string.h"
+#include "servers/physics_2d_server.h"
+#include "servers/physics_server.h"
+
+//headless physics benchmark, builds one of the standard scenes, steps it a fixed amount of times
+//and reports the time spent in each phase along with a hash of the body states after every step,
+//so changes to the solver can be checked for speed and for determinism at once.
+//
+//usage: -test physics_bench [-scene=boxes|ragdolls|rays] [-count=N] [-steps=N] [-2d] [-hashes] [-check]
+
+namespace TestPhysicsBench {
+
+enum Scene {
+	SCENE_BOXES,
+	SCENE_RAGDOLLS,
+	SCENE_RAYS
+};
+
+enum {
+	STACK_HEIGHT = 10,
+	PILE_HEIGHT = 5,
+	RAY_SCENE_BOXES = 1000,
+	DEFAULT_STEPS = 300
+};
+
+struct Options {
+
+	Scene scene;
+	int count;
+	int steps;
+	bool use_2d;
+	bool print_hashes;
+	bool check;
+};
+
+struct Stats {
+
+	uint64_t step_time;
+	uint64_t broad_phase_time;
+	uint64_t narrow_phase_time;
+	uint64_t solve_time;
+	uint64_t query_time;
+	int max_active_objects;
+	int max_collision_pairs;
+	int max_island_count;
+	int ray_hits;
+	Vector<uint32_t> hashes;
+};
+
+static uint32_t _hash_vec3(const Vector3 &p_vec, uint32_t p_hash) {
+
+	p_hash = hash_djb2_one_float(p_vec.x, p_hash);
+	p_hash = hash_djb2_one_float(p_vec.y, p_hash);
+	return hash_djb2_one_float(p_vec.z, p_hash);
+}
+
+static uint32_t _hash_vec2(const Vector2 &p_vec, uint32_t p_hash) {
+
+	p_hash = hash_djb2_one_float(p_vec.x, p_hash);
+	return hash_djb2_one_float(p_vec.y, p_hash);
+}
+
+class PhysicsBench {
+
+protected:
+	Options options;
+
+	Vector<RID> bodies; //dynamic bodies, hashed in creation order
+	Vector<RID> static_bodies;
+	Vector<RID> joints;
+	Vector<RID> shapes;
+	RID space;
+
+	virtual void _create_boxes(int p_count) = 0;
+	virtual void _create_ragdolls(int p_count) = 0;
+	virtual int _cast_rays(int p_step, uint32_t &r_hash) = 0;
+	virtual uint32_t _hash_bodies() = 0;
+	virtual void _add_process_info(Stats *r_stats) = 0;
+
+	virtual void _step(float p_delta) = 0;
+	virtual void _sync() = 0;
+	virtual void _clear() = 0;
+
+public:
+	void run(Stats *r_stats) {
+
+		r_stats->step_time = 0;
+		r_stats->broad_phase_time = 0;
+		r_stats->narrow_phase_time = 0;
+		r_stats->solve_time = 0;
+		r_stats->query_time = 0;
+		r_stats->max_active_objects = 0;
+		r_stats->max_collision_pairs = 0;
+		r_stats->max_island_count = 0;
+		r_stats->ray_hits = 0;
+		r_stats->hashes.clear();
+
+		switch (options.scene) {
+			case SCENE_BOXES: _create_boxes(options.count); break;
+			case SCENE_RAGDOLLS: _create_ragdolls(options.count); break;
+			case SCENE_RAYS: _create_boxes(RAY_SCENE_BOXES); break;
+		}
+
+		for (int i = 0; i < options.steps; i++) {
+
+			//same order as the main loop, the space can be queried between sync and the next step
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			_step(1.0 / 60.0);
+			_sync();
+			r_stats->step_time += OS::get_singleton()->get_ticks_usec() - begin;
+
+			_add_process_info(r_stats);
+
+			uint32_t hash = _hash_bodies();
+
+			if (options.scene == SCENE_RAYS) {
+
+				begin = OS::get_singleton()->get_ticks_usec();
+				r_stats->ray_hits += _cast_rays(i, hash);
+				r_stats->query_time += OS::get_singleton()->get_ticks_usec() - begin;
+			}
+
+			r_stats->hashes.push_back(hash);
+		}
+
+		_clear();
+	}
+
+	PhysicsBench(const Options &p_options) { options = p_options; }
+	virtual ~PhysicsBench() {}
+};
+
+class PhysicsBench3D : public PhysicsBench {
+
+	PhysicsServer *ps;
+
+	Vector<Vector3> ray_from;
+	Vector<Vector3> ray_to;
+	Vector<PhysicsDirectSpaceState::RayResult> ray_results;
+
+	RID _create_shape(PhysicsServer::ShapeType p_type, const Variant &p_data) {
+
+		RID shape = ps->shape_create(p_type);
+		ps->shape_set_data(shape, p_data);
+		shapes.push_back(shape);
+		return shape;
+	}
+
+	RID _create_body(RID p_shape, const Transform &p_shape_xform, const Transform &p_xform, bool p_static = false) {
+
+		RID body = ps->body_create(p_static ? PhysicsServer::BODY_MODE_STATIC : PhysicsServer::BODY_MODE_RIGID);
+		ps->body_add_shape(body, p_shape, p_shape_xform);
+		ps->body_set_space(body, space);
+		ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, p_xform);
+		if (p_static)
+			static_bodies.push_back(body);
+		else
+			bodies.push_back(body);
+		return body;
+	}
+
+	void _create_floor(real_t p_extent) {
+
+		RID shape = _create_shape(PhysicsServer::SHAPE_BOX, Vector3(p_extent, 1, p_extent));
+		_create_body(shape, Transform(), Transform(Matrix3(), Vector3(0, -1, 0)), true);
+	}
+
+	virtual void _create_boxes(int p_count) {
+
+		int columns = (p_count + STACK_HEIGHT - 1) / STACK_HEIGHT;
+		int side = MAX(1, int(Math::ceil(Math::sqrt(double(columns)))));
+
+		_create_floor(side * 2 + 4);
+
+		RID box = _create_shape(PhysicsServer::SHAPE_BOX, Vector3(0.5, 0.5, 0.5));
+
+		for (int i = 0; i < p_count; i++) {
+
+			int column = i / STACK_HEIGHT;
+			Vector3 pos((column % side) * 2.0 - side, 0.5 + (i % STACK_HEIGHT), (column / side) * 2.0 - side);
+			_create_body(box, Transform(), Transform(Matrix3(), pos));
+		}
+	}
+
+	void _pin(RID p_body_A, const Vector3 &p_ofs_A, RID p_body_B, const Vector3 &p_ofs_B, const Vector3 &p_anchor) {
+
+		joints.push_back(ps->joint_create_pin(p_body_A, p_anchor - p_ofs_A, p_body_B, p_anchor - p_ofs_B));
+		ps->body_add_collision_exception(p_body_A, p_body_B);
+		ps->body_add_collision_exception(p_body_B, p_body_A);
+	}
+
+	virtual void _create_ragdolls(int p_count) {
+
+		int side = MAX(1, int(Math::ceil(Math::sqrt(double((p_count + PILE_HEIGHT - 1) / PILE_HEIGHT)))));
+
+		_create_floor(side * 1.5 + 4);
+
+		RID torso_shape = _create_shape(PhysicsServer::SHAPE_BOX, Vector3(0.2, 0.3, 0.1));
+		RID head_shape = _create_shape(PhysicsServer::SHAPE_SPHERE, 0.12);
+		Dictionary limb;
+		limb["radius"] = 0.05;
+		limb["height"] = 0.3;
+		RID limb_shape = _create_shape(PhysicsServer::SHAPE_CAPSULE, limb);
+		Transform limb_xform(Matrix3(Vector3(1, 0, 0), Math_PI * 0.5), Vector3()); //capsules run along z
+
+		static const Vector3 limb_ofs[4] = { Vector3(-0.3, 0.05, 0), Vector3(0.3, 0.05, 0), Vector3(-0.1, -0.55, 0), Vector3(0.1, -0.55, 0) };
+		static const Vector3 limb_anchor[4] = { Vector3(-0.25, 0.25, 0), Vector3(0.25, 0.25, 0), Vector3(-0.1, -0.3, 0), Vector3(0.1, -0.3, 0) };
+		Vector3 head_ofs(0, 0.45, 0);
+
+		for (int i = 0; i < p_count; i++) {
+
+			int column = i / PILE_HEIGHT;
+			Vector3 origin((column % side) * 1.5 - side * 0.75, 1.0 + (i % PILE_HEIGHT) * 1.5, (column / side) * 1.5 - side * 0.75);
+			Matrix3 rot = Matrix3(Vector3(0, 1, 0), i * 0.7) * Matrix3(Vector3(1, 0, 0), (i % 3) * 0.4);
+
+			RID torso = _create_body(torso_shape, Transform(), Transform(rot, origin));
+			RID head = _create_body(head_shape, Transform(), Transform(rot, origin + rot.xform(head_ofs)));
+			_pin(torso, Vector3(), head, head_ofs, Vector3(0, 0.3, 0));
+
+			for (int j = 0; j < 4; j++) {
+
+				RID part = _create_body(limb_shape, limb_xform, Transform(rot, origin + rot.xform(limb_ofs[j])));
+				_pin(torso, Vector3(), part, limb_ofs[j], limb_anchor[j]);
+			}
+		}
+	}
+
+	virtual int _cast_rays(int p_step, uint32_t &r_hash) {
+
+		int count = options.count;
+		if (ray_from.size() != count) {
+			ray_from.resize(count);
+			ray_to.resize(count);
+			ray_results.resize(count);
+		}
+
+		//a grid of rays raining over the stacks, shifted a bit every step
+		int side = MAX(1, int(Math::ceil(Math::sqrt(double(count)))));
+		real_t extent = Math::ceil(Math::sqrt(double(RAY_SCENE_BOXES / STACK_HEIGHT))) + 1;
+		real_t shift = (p_step % 16) * (1.0 / 16);
+
+		Vector3 *from = ray_from.ptr();
+		Vector3 *to = ray_to.ptr();
+		for (int i = 0; i < count; i++) {
+
+			real_t x = ((i % side) + shift) / side * 2.0 - 1.0;
+			real_t z = ((i / side) + shift) / side * 2.0 - 1.0;
+			from[i] = Vector3(x * extent, STACK_HEIGHT + 5, z * extent);
+			to[i] = Vector3(x * extent, -0.5, z * extent);
+		}
+
+		PhysicsDirectSpaceState *dss = ps->space_get_direct_state(space);
+		ERR_FAIL_COND_V(!dss, 0);
+
+		PhysicsDirectSpaceState::RayResult *results = ray_results.ptr();
+		int hits = dss->intersect_rays_batch(from, to, count, results);
+
+		for (int i = 0; i < count; i++) {
+
+			if (results[i].shape < 0)
+				continue;
+			r_hash = _hash_vec3(results[i].position, r_hash);
+		}
+
+		return hits;
+	}
+
+	virtual uint32_t _hash_bodies() {
+
+		uint32_t hash = 5381;
+
+		for (int i = 0; i < bodies.size(); i++) {
+
+			Transform xform = ps->body_get_state(bodies[i], PhysicsServer::BODY_STATE_TRANSFORM);
+			for (int j = 0; j < 3; j++) {
+				hash = _hash_vec3(xform.basis[j], hash);
+			}
+			hash = _hash_vec3(xform.origin, hash);
+			hash = _hash_vec3(ps->body_get_state(bodies[i], PhysicsServer::BODY_STATE_LINEAR_VELOCITY), hash);
+			hash = _hash_vec3(ps->body_get_state(bodies[i], PhysicsServer::BODY_STATE_ANGULAR_VELOCITY), hash);
+		}
+
+		return hash;
+	}
+
+	virtual void _add_process_info(Stats *r_stats) {
+
+		r_stats->broad_phase_time += ps->get_process_info(PhysicsServer::INFO_BROAD_PHASE_TIME);
+		r_stats->narrow_phase_time += ps->get_process_info(PhysicsServer::INFO_NARROW_PHASE_TIME);
+		r_stats->solve_time += ps->get_process_info(PhysicsServer::INFO_SOLVE_TIME);
+		r_stats->max_active_objects = MAX(r_stats->max_active_objects, ps->get_process_info(PhysicsServer::INFO_ACTIVE_OBJECTS));
+		r_stats->max_collision_pairs = MAX(r_stats->max_collision_pairs, ps->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS));
+		r_stats->max_island_count = MAX(r_stats->max_island_count, ps->get_process_info(PhysicsServer::INFO_ISLAND_COUNT));
+	}
+
+	virtual void _step(float p_delta) {
+
+		ps->end_sync();
+		ps->step(p_delta);
+	}
+
+	virtual void _sync() {
+
+		ps->sync();
+		ps->flush_queries();
+	}
+
+	virtual void _clear() {
+
+		ps->end_sync();
+
+		for (int i = 0; i < joints.size(); i++)
+			ps->free(joints[i]);
+		for (int i = 0; i < bodies.size(); i++)
+			ps->free(bodies[i]);
+		for (int i = 0; i < static_bodies.size(); i++)
+			ps->free(static_bodies[i]);
+		for (int i = 0; i < shapes.size(); i++)
+			ps->free(shapes[i]);
+
+		joints.clear();
+		bodies.clear();
+		static_bodies.clear();
+		shapes.clear();
+
+		ps->space_set_active(space, false);
+		ps->free(space);
+		ps->set_active(false);
+	}
+
+public:
+	PhysicsBench3D(const Options &p_options)
+		: PhysicsBench(p_options) {
+
+		ps = PhysicsServer::get_singleton();
+		ps->set_active(true);
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+		ps->area_set_param(space, PhysicsServer::AREA_PARAM_GRAVITY, 9.8);
+		ps->area_set_param(space, PhysicsServer::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+	}
+};
+
+class PhysicsBench2D : public PhysicsBench {
+
+	enum {
+		BOX_SIZE = 32
+	};
+
+	Physics2DServer *ps;
+
+	Vector<Vector2> ray_from;
+	Vector<Vector2> ray_to;
+	Vector<Physics2DDirectSpaceState::RayResult> ray_results;
+
+	RID _create_shape(Physics2DServer::ShapeType p_type, const Variant &p_data) {
+
+		RID shape = ps->shape_create(p_type);
+		ps->shape_set_data(shape, p_data);
+		shapes.push_back(shape);
+		return shape;
+	}
+
+	RID _create_body(RID p_shape, const Matrix32 &p_xform, bool p_static = false) {
+
+		RID body = ps->body_create(p_static ? Physics2DServer::BODY_MODE_STATIC : Physics2DServer::BODY_MODE_RIGID);
+		ps->body_add_shape(body, p_shape);
+		ps->body_set_space(body, space);
+		ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, p_xform);
+		if (p_static)
+			static_bodies.push_back(body);
+		else
+			bodies.push_back(body);
+		return body;
+	}
+
+	void _create_floor(real_t p_extent) {
+
+		RID shape = _create_shape(Physics2DServer::SHAPE_RECTANGLE, Vector2(p_extent, BOX_SIZE));
+		_create_body(shape, Matrix32(0, Vector2(0, BOX_SIZE)), true);
+	}
+
+	virtual void _create_boxes(int p_count) {
+
+		int columns = (p_count + STACK_HEIGHT - 1) / STACK_HEIGHT;
+
+		_create_floor(columns * BOX_SIZE + BOX_SIZE * 4);
+
+		RID box = _create_shape(Physics2DServer::SHAPE_RECTANGLE, Vector2(BOX_SIZE / 2, BOX_SIZE / 2));
+
+		for (int i = 0; i < p_count; i++) {
+
+			int column = i / STACK_HEIGHT;
+			Vector2 pos((column * 2 - columns) * BOX_SIZE, -BOX_SIZE / 2 - (i % STACK_HEIGHT) * BOX_SIZE);
+			_create_body(box, Matrix32(0, pos));
+		}
+	}
+
+	void _pin(RID p_body_A, RID p_body_B, const Vector2 &p_anchor) {
+
+		joints.push_back(ps->pin_joint_create(p_anchor, p_body_A, p_body_B));
+		ps->body_add_collision_exception(p_body_A, p_body_B);
+		ps->body_add_collision_exception(p_body_B, p_body_A);
+	}
+
+	virtual void _create_ragdolls(int p_count) {
+
+		int columns = (p_count + PILE_HEIGHT - 1) / PILE_HEIGHT;
+
+		_create_floor(columns * 40 + BOX_SIZE * 4);
+
+		RID torso_shape = _create_shape(Physics2DServer::SHAPE_RECTANGLE, Vector2(8, 12));
+		RID head_shape = _create_shape(Physics2DServer::SHAPE_CIRCLE, 5);
+		RID limb_shape = _create_shape(Physics2DServer::SHAPE_CAPSULE, Vector2(2, 12));
+
+		static const Vector2 limb_ofs[4] = { Vector2(-12, -2), Vector2(12, -2), Vector2(-4, 20), Vector2(4, 20) };
+		static const Vector2 limb_anchor[4] = { Vector2(-10, -10), Vector2(10, -10), Vector2(-4, 12), Vector2(4, 12) };
+		Vector2 head_ofs(0, -17);
+
+		for (int i = 0; i < p_count; i++) {
+
+			int column = i / PILE_HEIGHT;
+			real_t rot = i * 0.7;
+			Matrix32 xform(rot, Vector2((column - columns / 2) * 40, -40 - (i % PILE_HEIGHT) * 50));
+
+			RID torso = _create_body(torso_shape, xform);
+			RID head = _create_body(head_shape, Matrix32(rot, xform.xform(head_ofs)));
+			_pin(torso, head, xform.xform(Vector2(0, -12)));
+
+			for (int j = 0; j < 4; j++) {
+
+				RID part = _create_body(limb_shape, Matrix32(rot, xform.xform(limb_ofs[j])));
+				_pin(torso, part, xform.xform(limb_anchor[j]));
+			}
+		}
+	}
+
+	virtual int _cast_rays(int p_step, uint32_t &r_hash) {
+
+		int count = options.count;
+		if (ray_from.size() != count) {
+			ray_from.resize(count);
+			ray_to.resize(count);
+			ray_results.resize(count);
+		}
+
+		//a row of rays raining over the stacks, shifted a bit every step
+		real_t extent = (RAY_SCENE_BOXES / STACK_HEIGHT + 1) * BOX_SIZE;
+		real_t shift = (p_step % 16) * (1.0 / 16);
+
+		Vector2 *from = ray_from.ptr();
+		Vector2 *to = ray_to.ptr();
+		for (int i = 0; i < count; i++) {
+
+			real_t x = (i + shift) / count * 2.0 - 1.0;
+			from[i] = Vector2(x * extent, -(STACK_HEIGHT + 5) * BOX_SIZE);
+			to[i] = Vector2(x * extent, BOX_SIZE / 2);
+		}
+
+		Physics2DDirectSpaceState *dss = ps->space_get_direct_state(space);
+		ERR_FAIL_COND_V(!dss, 0);
+
+		Physics2DDirectSpaceState::RayResult *results = ray_results.ptr();
+		int hits = dss->intersect_rays_batch(from, to, count, results);
+
+		for (int i = 0; i < count; i++) {
+
+			if (results[i].shape < 0)
+				continue;
+			r_hash = _hash_vec2(results[i].position, r_hash);
+		}
+
+		return hits;
+	}
+
+	virtual uint32_t _hash_bodies() {
+
+		uint32_t hash = 5381;
+
+		for (int i = 0; i < bodies.size(); i++) {
+
+			Matrix32 xform = ps->body_get_state(bodies[i], Physics2DServer::BODY_STATE_TRANSFORM);
+			for (int j = 0; j < 3; j++) {
+				hash = _hash_vec2(xform.elements[j], hash);
+			}
+			hash = _hash_vec2(ps->body_get_state(bodies[i], Physics2DServer::BODY_STATE_LINEAR_VELOCITY), hash);
+			hash = hash_djb2_one_float(ps->body_get_state(bodies[i], Physics2DServer::BODY_STATE_ANGULAR_VELOCITY), hash);
+		}
+
+		return hash;
+	}
+
+	virtual void _add_process_info(Stats *r_stats) {
+
+		r_stats->broad_phase_time += ps->get_process_info(Physics2DServer::INFO_BROAD_PHASE_TIME);
+		r_stats->narrow_phase_time += ps->get_process_info(Physics2DServer::INFO_NARROW_PHASE_TIME);
+		r_stats->solve_time += ps->get_process_info(Physics2DServer::INFO_SOLVE_TIME);
+		r_stats->max_active_objects = MAX(r_stats->max_active_objects, ps->get_process_info(Physics2DServer::INFO_ACTIVE_OBJECTS));
+		r_stats->max_collision_pairs = MAX(r_stats->max_collision_pairs, ps->get_process_info(Physics2DServer::INFO_COLLISION_PAIRS));
+		r_stats->max_island_count = MAX(r_stats->max_island_count, ps->get_process_info(Physics2DServer::INFO_ISLAND_COUNT));
+	}
+
+	virtual void _step(float p_delta) {
+
+		ps->end_sync();
+		ps->step(p_delta);
+	}
+
+	virtual void _sync() {
+
+		ps->sync();
+		ps->flush_queries();
+	}
+
+	virtual void _clear() {
+
+		ps->end_sync();
+
+		for (int i = 0; i < joints.size(); i++)
+			ps->free(joints[i]);
+		for (int i = 0; i < bodies.size(); i++)
+			ps->free(bodies[i]);
+		for (int i = 0; i < static_bodies.size(); i++)
+			ps->free(static_bodies[i]);
+		for (int i = 0; i < shapes.size(); i++)
+			ps->free(shapes[i]);
+
+		joints.clear();
+		bodies.clear();
+		static_bodies.clear();
+		shapes.clear();
+
+		ps->space_set_active(space, false);
+		ps->free(space);
+		ps->set_active(false);
+	}
+
+public:
+	PhysicsBench2D(const Options &p_options)
+		: PhysicsBench(p_options) {
+
+		ps = Physics2DServer::get_singleton();
+		ps->set_active(true);
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+		ps->area_set_param(space, Physics2DServer::AREA_PARAM_GRAVITY, 98);
+		ps->area_set_param(space, Physics2DServer::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+	}
+};
+
+static String _msec(uint64_t p_usec, int p_steps) {
+
+	return rtos(p_usec / 1000.0 / p_steps) + "ms";
+}
+
+static void _run(const Options &p_options, Stats *r_stats) {
+
+	PhysicsBench *bench;
+	if (p_options.use_2d)
+		bench = memnew(PhysicsBench2D(p_options));
+	else
+		bench = memnew(PhysicsBench3D(p_options));
+
+	bench->run(r_stats);
+	memdelete(bench);
+}
+
+MainLoop *test(const List<String> &p_args) {
+
+	Options options;
+	options.scene = SCENE_BOXES;
+	options.count = -1;
+	options.steps = DEFAULT_STEPS;
+	options.use_2d = false;
+	options.print_hashes = false;
+	options.check = false;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+
+		String arg = E->get();
+
+		if (arg.begins_with("-scene=")) {
+
+			String scene = arg.get_slice("=", 1);
+			if (scene == "boxes") {
+				options.scene = SCENE_BOXES;
+			} else if (scene == "ragdolls") {
+				options.scene = SCENE_RAGDOLLS;
+			} else if (scene == "rays") {
+				options.scene = SCENE_RAYS;
+			} else {
+				ERR_EXPLAIN("Unknown benchmark scene: " + scene);
+				ERR_FAIL_V(NULL);
+			}
+		} else if (arg.begins_with("-count=")) {
+			options.count = arg.get_slice("=", 1).to_int();
+		} else if (arg.begins_with("-steps=")) {
+			options.steps = arg.get_slice("=", 1).to_int();
+		} else if (arg == "-2d") {
+			options.use_2d = true;
+		} else if (arg == "-hashes") {
+			options.print_hashes = true;
+		} else if (arg == "-check") {
+			options.check = true;
+		}
+	}
+
+	if (options.count < 0) {
+		//boxes, ragdolls or rays per step
+		static const int default_count[3] = { 1000, 100, 10000 };
+		options.count = default_count[options.scene];
+	}
+
+	ERR_FAIL_COND_V(options.steps <= 0, NULL);
+
+	static const char *scene_name[3] = { "boxes", "ragdolls", "rays" };
+	print_line(String("** Physics benchmark: ") + (options.use_2d ? "2D " : "3D ") + scene_name[options.scene] + ", count " + itos(options.count) + ", " + itos(options.steps) + " steps **");
+
+	Stats stats;
+	_run(options, &stats);
+
+	int steps = options.steps;
+	uint64_t phases = stats.broad_phase_time + stats.narrow_phase_time + stats.solve_time;
+	uint64_t other = stats.step_time > phases ? stats.step_time - phases : 0;
+
+	print_line("step: " + _msec(stats.step_time, steps) + " (broad phase " + _msec(stats.broad_phase_time, steps) + ", narrow phase " + _msec(stats.narrow_phase_time, steps) + ", solve " + _msec(stats.solve_time, steps) + ", other " + _msec(other, steps) + ")");
+	if (options.scene == SCENE_RAYS) {
+		print_line("rays: " + _msec(stats.query_time, steps) + ", " + itos(stats.ray_hits / steps) + " hits per step");
+	}
+	print_line("peak active objects " + itos(stats.max_active_objects) + ", collision pairs " + itos(stats.max_collision_pairs) + ", islands " + itos(stats.max_island_count));
+
+	uint32_t hash = 5381;
+	for (int i = 0; i < steps; i++) {
+
+		if (options.print_hashes) {
+			print_line("step " + itos(i) + ": " + String::num_int64(stats.hashes[i], 16));
+		}
+		hash = hash_djb2_one_32(stats.hashes[i], hash);
+	}
+	print_line("state hash: " + String::num_int64(hash, 16));
+
+	if (options.check) {
+
+		//run again from scratch, both runs must match bit for bit
+		Stats check;
+		_run(options, &check);
+
+		int mismatch = -1;
+		for (int i = 0; i < steps; i++) {
+
+			if (stats.hashes[i] != check.hashes[i]) {
+				mismatch = i;
+				break;
+			}
+		}
+
+		if (mismatch == -1) {
+			print_line("determinism check: passed");
+		} else {
+			print_line("determinism check: FAILED, runs diverge at step " + itos(mismatch));
+		}
+	}
+
+	return NULL;
+}
+}
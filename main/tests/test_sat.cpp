@@ -0,0 +1,266 @@
+/*************************************************************************/
+/*  test_sat.cpp                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "test_sat.h"
+
+#include "math_funcs.h"
+#include "os/os.h"
+#include "print_string.h"
+#include "servers/physics/collision_solver_sat.h"
+#include "servers/physics/shape_sw.h"
+#include "servers/physics_2d/collision_solver_2d_sat.h"
+#include "servers/physics_2d/shape_2d_sw.h"
+
+//times the SAT narrow phase with the batched (SIMD) projection on and off,
+//and checks both paths agree on the result and contacts
+
+namespace TestSAT {
+
+enum {
+	PAIR_COUNT = 2000,
+	REPEATS = 5
+};
+
+struct ContactSum {
+
+	int count;
+	Vector3 sum;
+};
+
+static void _contact_3d(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata) {
+
+	ContactSum *cs = (ContactSum *)p_userdata;
+	cs->count++;
+	cs->sum += p_point_A + p_point_B;
+}
+
+static void _contact_2d(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_userdata) {
+
+	ContactSum *cs = (ContactSum *)p_userdata;
+	cs->count++;
+	Vector2 s = p_point_A + p_point_B;
+	cs->sum += Vector3(s.x, s.y, 0);
+}
+
+static Vector3 _rand_vec3() {
+
+	return Vector3(Math::randf() - 0.5, Math::randf() - 0.5, Math::randf() - 0.5);
+}
+
+static void _report(const String &p_name, int p_hits, int p_mismatches, uint64_t p_scalar, uint64_t p_vectorized) {
+
+	print_line(p_name + ": hits " + itos(p_hits) + " mismatches " + itos(p_mismatches) + " scalar " + itos(p_scalar) + "us vectorized " + itos(p_vectorized) + "us (x" + rtos(p_vectorized ? float(p_scalar) / p_vectorized : 0) + ")");
+}
+
+static void _test_3d(const String &p_name, const ShapeSW *p_A, const ShapeSW *p_B, const Vector<Transform> &p_xform_A, const Vector<Transform> &p_xform_B, float p_margin) {
+
+	uint64_t usec[2];
+
+	for (int v = 0; v < 2; v++) {
+
+		sat_set_vectorized(v == 1);
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < REPEATS; r++) {
+			for (int i = 0; i < p_xform_A.size(); i++) {
+				ContactSum cs;
+				cs.count = 0;
+				sat_calculate_penetration(p_A, p_xform_A[i], p_B, p_xform_B[i], _contact_3d, &cs, false, NULL, p_margin, p_margin);
+			}
+		}
+		usec[v] = OS::get_singleton()->get_ticks_usec() - from;
+	}
+
+	int hits = 0;
+	int mismatches = 0;
+
+	for (int i = 0; i < p_xform_A.size(); i++) {
+
+		ContactSum cs[2];
+		bool res[2];
+		for (int v = 0; v < 2; v++) {
+			sat_set_vectorized(v == 1);
+			cs[v].count = 0;
+			res[v] = sat_calculate_penetration(p_A, p_xform_A[i], p_B, p_xform_B[i], _contact_3d, &cs[v], false, NULL, p_margin, p_margin);
+		}
+
+		if (res[0])
+			hits++;
+		if (res[0] != res[1] || cs[0].count != cs[1].count || cs[0].sum.distance_to(cs[1].sum) > CMP_EPSILON * 100)
+			mismatches++;
+	}
+
+	_report(p_name, hits, mismatches, usec[0], usec[1]);
+}
+
+static void _test_2d(const String &p_name, const Shape2DSW *p_A, const Shape2DSW *p_B, const Vector<Matrix32> &p_xform_A, const Vector<Matrix32> &p_xform_B, const Vector2 &p_motion) {
+
+	uint64_t usec[2];
+
+	for (int v = 0; v < 2; v++) {
+
+		sat_2d_set_vectorized(v == 1);
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int r = 0; r < REPEATS; r++) {
+			for (int i = 0; i < p_xform_A.size(); i++) {
+				ContactSum cs;
+				cs.count = 0;
+				sat_2d_calculate_penetration(p_A, p_xform_A[i], p_motion, p_B, p_xform_B[i], Vector2(), _contact_2d, &cs);
+			}
+		}
+		usec[v] = OS::get_singleton()->get_ticks_usec() - from;
+	}
+
+	int hits = 0;
+	int mismatches = 0;
+
+	for (int i = 0; i < p_xform_A.size(); i++) {
+
+		ContactSum cs[2];
+		bool res[2];
+		for (int v = 0; v < 2; v++) {
+			sat_2d_set_vectorized(v == 1);
+			cs[v].count = 0;
+			res[v] = sat_2d_calculate_penetration(p_A, p_xform_A[i], p_motion, p_B, p_xform_B[i], Vector2(), _contact_2d, &cs[v]);
+		}
+
+		if (res[0])
+			hits++;
+		if (res[0] != res[1] || cs[0].count != cs[1].count || cs[0].sum.distance_to(cs[1].sum) > CMP_EPSILON * 100)
+			mismatches++;
+	}
+
+	_report(p_name, hits, mismatches, usec[0], usec[1]);
+}
+
+static void _test_3d_shapes() {
+
+	BoxShapeSW box;
+	box.set_data(Vector3(1, 0.5, 0.7));
+
+	CapsuleShapeSW capsule;
+	Dictionary d;
+	d["radius"] = 0.4;
+	d["height"] = 1.2;
+	capsule.set_data(d);
+
+	ConvexPolygonShapeSW convex;
+	Vector3Array points;
+	for (int i = 0; i < 16; i++) {
+		points.push_back(_rand_vec3().normalized() * 0.9);
+	}
+	convex.set_data(points);
+
+	FaceShapeSW face;
+	face.vertex[0] = Vector3(-1, 0, -1);
+	face.vertex[1] = Vector3(1, 0, -1);
+	face.vertex[2] = Vector3(0, 0, 1.5);
+
+	Vector<Transform> xform_A;
+	Vector<Transform> xform_B;
+	xform_A.resize(PAIR_COUNT);
+	xform_B.resize(PAIR_COUNT);
+	for (int i = 0; i < PAIR_COUNT; i++) {
+		xform_A[i] = Transform(Matrix3(_rand_vec3().normalized(), Math::randf() * Math_PI * 2), _rand_vec3() * 0.2);
+		xform_B[i] = Transform(Matrix3(_rand_vec3().normalized(), Math::randf() * Math_PI * 2), _rand_vec3() * 2.5);
+	}
+
+	for (int m = 0; m < 2; m++) {
+
+		float margin = m ? 0.04 : 0;
+		String suffix = m ? " (margin)" : "";
+
+		_test_3d("box-box" + suffix, &box, &box, xform_A, xform_B, margin);
+		_test_3d("box-capsule" + suffix, &box, &capsule, xform_A, xform_B, margin);
+		_test_3d("box-convex" + suffix, &box, &convex, xform_A, xform_B, margin);
+		_test_3d("box-face" + suffix, &box, &face, xform_A, xform_B, margin);
+		_test_3d("capsule-capsule" + suffix, &capsule, &capsule, xform_A, xform_B, margin);
+		_test_3d("capsule-convex" + suffix, &capsule, &convex, xform_A, xform_B, margin);
+		_test_3d("capsule-face" + suffix, &capsule, &face, xform_A, xform_B, margin);
+		_test_3d("convex-convex" + suffix, &convex, &convex, xform_A, xform_B, margin);
+		_test_3d("convex-face" + suffix, &convex, &face, xform_A, xform_B, margin);
+	}
+}
+
+static void _test_2d_shapes() {
+
+	RectangleShape2DSW rect;
+	rect.set_data(Vector2(1, 0.5));
+
+	CapsuleShape2DSW capsule;
+	capsule.set_data(Vector2(0.4, 1.2));
+
+	CircleShape2DSW circle;
+	circle.set_data(0.6);
+
+	ConvexPolygonShape2DSW convex;
+	Vector2Array points;
+	for (int i = 0; i < 12; i++) {
+		points.push_back(Vector2(0.9, 0).rotated(-i * Math_PI * 2 / 12));
+	}
+	convex.set_data(points);
+
+	Vector<Matrix32> xform_A;
+	Vector<Matrix32> xform_B;
+	xform_A.resize(PAIR_COUNT);
+	xform_B.resize(PAIR_COUNT);
+	for (int i = 0; i < PAIR_COUNT; i++) {
+		xform_A[i] = Matrix32(Math::randf() * Math_PI * 2, Vector2(Math::randf() - 0.5, Math::randf() - 0.5) * 0.2);
+		xform_B[i] = Matrix32(Math::randf() * Math_PI * 2, Vector2(Math::randf() - 0.5, Math::randf() - 0.5) * 2.5);
+	}
+
+	for (int m = 0; m < 2; m++) {
+
+		//the second pass exercises the motion (cast) variants
+		Vector2 motion = m ? Vector2(0.3, -0.2) : Vector2();
+		String suffix = m ? " (cast)" : "";
+
+		_test_2d("rect-rect" + suffix, &rect, &rect, xform_A, xform_B, motion);
+		_test_2d("rect-capsule" + suffix, &rect, &capsule, xform_A, xform_B, motion);
+		_test_2d("rect-convex" + suffix, &rect, &convex, xform_A, xform_B, motion);
+		_test_2d("capsule-capsule" + suffix, &capsule, &capsule, xform_A, xform_B, motion);
+		_test_2d("capsule-convex" + suffix, &capsule, &convex, xform_A, xform_B, motion);
+		_test_2d("convex-convex" + suffix, &convex, &convex, xform_A, xform_B, motion);
+		_test_2d("circle-rect" + suffix, &circle, &rect, xform_A, xform_B, motion);
+	}
+}
+
+MainLoop *test() {
+
+	Math::seed(7);
+
+	print_line("** SAT 3D **");
+	_test_3d_shapes();
+	print_line("** SAT 2D **");
+	_test_2d_shapes();
+
+	sat_set_vectorized(true);
+	sat_2d_set_vectorized(true);
+
+	return NULL;
+}
+}
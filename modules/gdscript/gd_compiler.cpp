@@ -44,6 +44,143 @@ void GDCompiler::_set_error(const String &p_error, const GDParser::Node *p_node)
 	}
 }
 
+Variant::Type GDCompiler::_guess_expression_type(CodeGen &codegen, const GDParser::Node *p_expression) const {
+
+	//best effort guess of the type an expression evaluates to, NIL when unknown
+
+	switch (p_expression->type) {
+
+		case GDParser::Node::TYPE_CONSTANT: {
+
+			return static_cast<const GDParser::ConstantNode *>(p_expression)->value.get_type();
+		} break;
+		case GDParser::Node::TYPE_IDENTIFIER: {
+
+			StringName identifier = static_cast<const GDParser::IdentifierNode *>(p_expression)->name;
+
+			if (codegen.stack_identifiers.has(identifier)) {
+
+				const Map<int, Variant::Type>::Element *E = codegen.stack_type_hints.find(codegen.stack_identifiers[identifier]);
+				return E ? E->get() : Variant::NIL;
+			}
+
+			if (codegen.script->member_indices.has(identifier))
+				return Variant::NIL;
+
+			GDScript *owner = codegen.script;
+			while (owner) {
+
+				GDScript *scr = owner;
+				while (scr) {
+
+					const Map<StringName, Variant>::Element *E = scr->constants.find(identifier);
+					if (E)
+						return E->get().get_type();
+					scr = scr->_base;
+				}
+				owner = owner->_owner;
+			}
+		} break;
+		case GDParser::Node::TYPE_OPERATOR: {
+
+			const GDParser::OperatorNode *on = static_cast<const GDParser::OperatorNode *>(p_expression);
+
+			switch (on->op) {
+
+				case GDParser::OperatorNode::OP_CALL: {
+
+					//basic type constructor
+					if (on->arguments.size() && on->arguments[0]->type == GDParser::Node::TYPE_TYPE)
+						return static_cast<const GDParser::TypeNode *>(on->arguments[0])->vtype;
+				} break;
+				case GDParser::OperatorNode::OP_NEG: {
+
+					Variant::Type t = _guess_expression_type(codegen, on->arguments[0]);
+					if (t == Variant::INT || t == Variant::REAL)
+						return t;
+				} break;
+				case GDParser::OperatorNode::OP_ADD:
+				case GDParser::OperatorNode::OP_SUB:
+				case GDParser::OperatorNode::OP_MUL:
+				case GDParser::OperatorNode::OP_DIV:
+				case GDParser::OperatorNode::OP_MOD: {
+
+					Variant::Type a = _guess_expression_type(codegen, on->arguments[0]);
+					Variant::Type b = _guess_expression_type(codegen, on->arguments[1]);
+					if (a == Variant::INT && b == Variant::INT)
+						return Variant::INT;
+					if ((a == Variant::INT || a == Variant::REAL) && (b == Variant::INT || b == Variant::REAL) && on->op != GDParser::OperatorNode::OP_MOD)
+						return Variant::REAL;
+				} break;
+				case GDParser::OperatorNode::OP_IN:
+				case GDParser::OperatorNode::OP_EQUAL:
+				case GDParser::OperatorNode::OP_NOT_EQUAL:
+				case GDParser::OperatorNode::OP_LESS:
+				case GDParser::OperatorNode::OP_LESS_EQUAL:
+				case GDParser::OperatorNode::OP_GREATER:
+				case GDParser::OperatorNode::OP_GREATER_EQUAL:
+				case GDParser::OperatorNode::OP_AND:
+				case GDParser::OperatorNode::OP_OR:
+				case GDParser::OperatorNode::OP_NOT: {
+
+					return Variant::BOOL;
+				} break;
+				default: {}
+			}
+		} break;
+		default: {}
+	}
+
+	return Variant::NIL;
+}
+
+int GDCompiler::_get_operator_opcode(Variant::Operator p_op, Variant::Type p_type_a, Variant::Type p_type_b) const {
+
+	//pick a typed operator when the operands look numeric, an unknown type on one side takes the type of the other.
+	//the typed opcodes check the actual types and fall back to the generic operator, so a wrong guess only costs the check
+
+	if (p_type_a == Variant::NIL)
+		p_type_a = p_type_b;
+	if (p_type_b == Variant::NIL)
+		p_type_b = p_type_a;
+
+	if (p_type_a == Variant::INT && p_type_b == Variant::INT) {
+
+		switch (p_op) {
+			case Variant::OP_ADD: return GDFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBSTRACT: return GDFunction::OPCODE_OPERATOR_SUB_INT;
+			case Variant::OP_MULTIPLY: return GDFunction::OPCODE_OPERATOR_MUL_INT;
+			case Variant::OP_DIVIDE: return GDFunction::OPCODE_OPERATOR_DIV_INT;
+			case Variant::OP_MODULE: return GDFunction::OPCODE_OPERATOR_MOD_INT;
+			case Variant::OP_EQUAL: return GDFunction::OPCODE_OPERATOR_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL: return GDFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+			case Variant::OP_LESS: return GDFunction::OPCODE_OPERATOR_LESS_INT;
+			case Variant::OP_LESS_EQUAL: return GDFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+			case Variant::OP_GREATER: return GDFunction::OPCODE_OPERATOR_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL: return GDFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+			default: {}
+		}
+
+	} else if ((p_type_a == Variant::REAL || p_type_a == Variant::INT) && (p_type_b == Variant::REAL || p_type_b == Variant::INT)) {
+
+		switch (p_op) {
+			case Variant::OP_ADD: return GDFunction::OPCODE_OPERATOR_ADD_REAL;
+			case Variant::OP_SUBSTRACT: return GDFunction::OPCODE_OPERATOR_SUB_REAL;
+			case Variant::OP_MULTIPLY: return GDFunction::OPCODE_OPERATOR_MUL_REAL;
+			case Variant::OP_DIVIDE: return GDFunction::OPCODE_OPERATOR_DIV_REAL;
+			case Variant::OP_EQUAL: return GDFunction::OPCODE_OPERATOR_EQUAL_REAL;
+			case Variant::OP_NOT_EQUAL: return GDFunction::OPCODE_OPERATOR_NOT_EQUAL_REAL;
+			case Variant::OP_LESS: return GDFunction::OPCODE_OPERATOR_LESS_REAL;
+			case Variant::OP_LESS_EQUAL: return GDFunction::OPCODE_OPERATOR_LESS_EQUAL_REAL;
+			case Variant::OP_GREATER: return GDFunction::OPCODE_OPERATOR_GREATER_REAL;
+			case Variant::OP_GREATER_EQUAL: return GDFunction::OPCODE_OPERATOR_GREATER_EQUAL_REAL;
+			default: {}
+		}
+	}
+
+	return GDFunction::OPCODE_OPERATOR;
+}
+
 bool GDCompiler::_create_unary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -74,7 +211,9 @@ bool GDCompiler::_create_binary_operator(CodeGen &codegen, const GDParser::Opera
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDFunction::OPCODE_OPERATOR); // perform operator
+	int opcode = _get_operator_opcode(op, _guess_expression_type(codegen, on->arguments[0]), _guess_expression_type(codegen, on->arguments[1]));
+
+	codegen.opcodes.push_back(opcode); // perform operator
 	codegen.opcodes.push_back(op); //which operator
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
@@ -186,7 +325,14 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 
 					if (scr->constants.has(identifier)) {
 
-						//int idx=scr->constants[identifier];
+						const Variant &value = scr->constants[identifier];
+						if (value.get_type() != Variant::ARRAY && value.get_type() != Variant::DICTIONARY) {
+							//resolve now into a local constant, so it is a direct slot at run time instead of a lookup by name
+							int idx = codegen.get_constant_pos(value);
+							return idx | (GDFunction::ADDR_TYPE_LOCAL_CONSTANT << GDFunction::ADDR_BITS); //argument (stack root)
+						}
+
+						//containers may be modified in place through the constant, so keep referencing the class one
 						int idx = codegen.get_name_map_pos(identifier);
 						return idx | (GDFunction::ADDR_TYPE_CLASS_CONSTANT << GDFunction::ADDR_BITS); //argument (stack root)
 					}
@@ -482,8 +628,11 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 						codegen.opcodes.push_back(p_root ? GDFunction::OPCODE_CALL : GDFunction::OPCODE_CALL_RETURN); // perform operator
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < arguments.size(); i++) {
 							codegen.opcodes.push_back(arguments[i]);
+							if (i == 1)
+								codegen.opcodes.push_back(codegen.alloc_inline_cache()); //cache slot goes after the method name
+						}
 					}
 				} break;
 				case GDParser::OperatorNode::OP_YIELD: {
@@ -573,6 +722,8 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 					codegen.opcodes.push_back(named ? GDFunction::OPCODE_GET_NAMED : GDFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					if (named)
+						codegen.opcodes.push_back(codegen.alloc_inline_cache());
 
 				} break;
 				case GDParser::OperatorNode::OP_AND: {
@@ -860,6 +1011,8 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 							codegen.opcodes.push_back(named ? GDFunction::OPCODE_GET_NAMED : GDFunction::OPCODE_GET);
 							codegen.opcodes.push_back(prev_pos);
 							codegen.opcodes.push_back(key_idx);
+							if (named)
+								codegen.opcodes.push_back(codegen.alloc_inline_cache());
 							slevel++;
 							codegen.alloc_stack(slevel);
 							int dst_pos = (GDFunction::ADDR_TYPE_STACK << GDFunction::ADDR_BITS) | slevel;
@@ -868,6 +1021,8 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 
 							//add in reverse order, since it will be reverted
 							setchain.push_back(dst_pos);
+							if (named)
+								setchain.push_back(codegen.alloc_inline_cache());
 							setchain.push_back(key_idx);
 							setchain.push_back(prev_pos);
 							setchain.push_back(named ? GDFunction::OPCODE_SET_NAMED : GDFunction::OPCODE_SET);
@@ -905,14 +1060,14 @@ int GDCompiler::_parse_expression(CodeGen &codegen, const GDParser::Node *p_expr
 						codegen.opcodes.push_back(named ? GDFunction::OPCODE_SET_NAMED : GDFunction::OPCODE_SET);
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
+						if (named)
+							codegen.opcodes.push_back(codegen.alloc_inline_cache());
 						codegen.opcodes.push_back(set_value);
 
-						for (int i = 0; i < setchain.size(); i += 4) {
+						//named sets carry an extra cache slot, so entries are not all the same size
+						for (int i = 0; i < setchain.size(); i++) {
 
-							codegen.opcodes.push_back(setchain[i + 0]);
-							codegen.opcodes.push_back(setchain[i + 1]);
-							codegen.opcodes.push_back(setchain[i + 2]);
-							codegen.opcodes.push_back(setchain[i + 3]);
+							codegen.opcodes.push_back(setchain[i]);
 						}
 
 						return retval;
@@ -1061,8 +1216,23 @@ Error GDCompiler::_parse_block(CodeGen &codegen, const GDParser::BlockNode *p_bl
 						int container_pos = (slevel++) | (GDFunction::ADDR_TYPE_STACK << GDFunction::ADDR_BITS);
 						codegen.alloc_stack(slevel);
 
+						//iterating range() gives ints (it's usually reduced to a constant array by the parser)
+						Variant::Type iter_type = Variant::NIL;
+						if (cf->arguments[1]->type == GDParser::Node::TYPE_CONSTANT) {
+							const Variant &container = static_cast<const GDParser::ConstantNode *>(cf->arguments[1])->value;
+							if (container.get_type() == Variant::ARRAY) {
+								Array array = container;
+								if (array.size() && array[0].get_type() == Variant::INT)
+									iter_type = Variant::INT;
+							}
+						} else if (cf->arguments[1]->type == GDParser::Node::TYPE_OPERATOR) {
+							const GDParser::OperatorNode *on = static_cast<const GDParser::OperatorNode *>(cf->arguments[1]);
+							if (on->op == GDParser::OperatorNode::OP_CALL && on->arguments.size() && on->arguments[0]->type == GDParser::Node::TYPE_BUILT_IN_FUNCTION && static_cast<const GDParser::BuiltInFunctionNode *>(on->arguments[0])->function == GDFunctions::GEN_RANGE)
+								iter_type = Variant::INT;
+						}
+
 						codegen.push_stack_identifiers();
-						codegen.add_stack_identifier(static_cast<const GDParser::IdentifierNode *>(cf->arguments[0])->name, iter_stack_pos);
+						codegen.add_stack_identifier(static_cast<const GDParser::IdentifierNode *>(cf->arguments[0])->name, iter_stack_pos, iter_type);
 
 						int ret = _parse_expression(codegen, cf->arguments[1], slevel, false);
 						if (ret < 0)
@@ -1199,7 +1369,7 @@ Error GDCompiler::_parse_block(CodeGen &codegen, const GDParser::BlockNode *p_bl
 
 				const GDParser::LocalVarNode *lv = static_cast<const GDParser::LocalVarNode *>(s);
 
-				codegen.add_stack_identifier(lv->name, p_stack_level++);
+				codegen.add_stack_identifier(lv->name, p_stack_level++, lv->assign ? _guess_expression_type(codegen, lv->assign) : Variant::NIL);
 				codegen.alloc_stack(p_stack_level);
 				new_identifiers++;
 
@@ -1227,6 +1397,7 @@ Error GDCompiler::_parse_function(GDScript *p_script, const GDParser::ClassNode
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
+	codegen.inline_cache_count = 0;
 	codegen.debug_stack = ScriptDebugger::get_singleton() != NULL;
 	Vector<StringName> argnames;
 
@@ -1379,6 +1550,15 @@ Error GDCompiler::_parse_function(GDScript *p_script, const GDParser::ClassNode
 	gdfunc->_argument_count = p_func ? p_func->arguments.size() : 0;
 	gdfunc->_stack_size = codegen.stack_max;
 	gdfunc->_call_size = codegen.call_max;
+	if (codegen.inline_cache_count) {
+
+		gdfunc->inline_caches.resize(codegen.inline_cache_count);
+		gdfunc->_inline_caches_ptr = &gdfunc->inline_caches[0];
+		for (int i = 0; i < codegen.inline_cache_count; i++) {
+			gdfunc->_inline_caches_ptr[i] = NULL;
+		}
+		gdfunc->_inline_cache_count = codegen.inline_cache_count;
+	}
 	gdfunc->name = func_name;
 #ifdef DEBUG_ENABLED
 	if (ScriptDebugger::get_singleton()) {
@@ -1837,6 +2017,9 @@ Error GDCompiler::compile(const GDParser *p_parser, GDScript *p_script, bool p_k
 
 	source = p_script->get_path();
 
+	//functions and member indices of the script are about to change
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches();
+
 	Error err = _parse_class(p_script, NULL, static_cast<const GDParser::ClassNode *>(root), p_keep_state);
 
 	if (err)
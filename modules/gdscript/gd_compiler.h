@@ -48,8 +48,12 @@ class GDCompiler {
 		List<Map<StringName, int> > block_identifier_stack;
 		Map<StringName, int> block_identifiers;
 
-		void add_stack_identifier(const StringName &p_id, int p_stackpos) {
+		//type a stack slot is expected to hold, only a hint for emitting typed operators (they are guarded at run time)
+		Map<int, Variant::Type> stack_type_hints;
+
+		void add_stack_identifier(const StringName &p_id, int p_stackpos, Variant::Type p_type_hint = Variant::NIL) {
 			stack_identifiers[p_id] = p_stackpos;
+			stack_type_hints[p_stackpos] = p_type_hint;
 			if (debug_stack) {
 				block_identifiers[p_id] = p_stackpos;
 				GDFunction::StackDebug sd;
@@ -119,10 +123,14 @@ class GDCompiler {
 		void alloc_call(int p_params) {
 			if (p_params >= call_max) call_max = p_params;
 		}
+		int alloc_inline_cache() {
+			return inline_cache_count++;
+		}
 
 		int current_line;
 		int stack_max;
 		int call_max;
+		int inline_cache_count;
 	};
 
 #if 0
@@ -138,6 +146,8 @@ class GDCompiler {
 
 	void _set_error(const String &p_error, const GDParser::Node *p_node);
 
+	Variant::Type _guess_expression_type(CodeGen &codegen, const GDParser::Node *p_expression) const;
+	int _get_operator_opcode(Variant::Operator p_op, Variant::Type p_type_a, Variant::Type p_type_b) const;
 	bool _create_unary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level);
 	bool _create_binary_operator(CodeGen &codegen, const GDParser::OperatorNode *on, Variant::Operator op, int p_stack_level, bool p_initializer = false);
 
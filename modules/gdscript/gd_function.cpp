@@ -1,38 +1,153 @@
 #include "gd_function.h"
 #include "gd_functions.h"
+#include "core_string_names.h"
 #include "gd_script.h"
 #include "os/os.h"
 
-Variant *GDFunction::_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const {
+//computed goto dispatch jumps straight from one opcode to the next instead of going back through the
+//switch bounds check and a single shared indirect branch, which predicts a lot better
+#if defined(__GNUC__) && !defined(GDSCRIPT_NO_COMPUTED_GOTO)
+#define GDSCRIPT_COMPUTED_GOTO
+#endif
+
+#ifdef GDSCRIPT_COMPUTED_GOTO
+#define OPCODE(m_op) \
+	m_op:
+#define OPCODE_WHILE(m_test)
+#define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
+#define DISPATCH_OPCODE                      \
+	do {                                     \
+		last_opcode = _code_ptr[ip];         \
+		goto *switch_table_ops[last_opcode]; \
+	} while (0)
+#else
+#define OPCODE(m_op) case m_op:
+#define OPCODE_WHILE(m_test) while (m_test)
+#define OPCODE_SWITCH(m_test) switch (m_test)
+#define DISPATCH_OPCODE continue
+#endif
+
+//leave the current opcode with an error (or exit_ok set), and leave the function
+#define OPCODE_BREAK goto opcode_exit
+#define OPCODE_OUT goto function_exit
+
+#define GD_ERR_BREAK(m_cond)                                                                                           \
+	{                                                                                                                  \
+		if (m_cond) {                                                                                                  \
+			_err_print_error(FUNCTION_STR, __FILE__, __LINE__, "Condition ' " _STR(m_cond) " ' is true. Breaking..:"); \
+			OPCODE_BREAK;                                                                                              \
+		} else                                                                                                         \
+			_err_error_exists = false;                                                                                 \
+	}
+
+//typed operators are emitted by the compiler when it expects numeric operands. They use the operand layout of
+//OPCODE_OPERATOR, so when the type guard fails (or the operation could fail) the generic operator takes over.
+//real operators accept an int on either side, like Variant::evaluate, but two ints give an int so they are left to it.
+#define OPCODE_TYPED_RESULT(m_dst, m_ret_type, m_ret_field, m_value) \
+	if (m_dst->type == Variant::m_ret_type)                          \
+		m_dst->_data.m_ret_field = m_value;                          \
+	else                                                             \
+		*m_dst = m_value;
+
+#define OPCODE_TYPED_INT(m_opcode, m_op, m_ret, m_ret_type, m_ret_field, m_zero_check)                   \
+	OPCODE(m_opcode) {                                                                                   \
+		CHECK_SPACE(5);                                                                                  \
+		GET_VARIANT_PTR(a, 2);                                                                           \
+		GET_VARIANT_PTR(b, 3);                                                                           \
+		if (a->type != Variant::INT || b->type != Variant::INT || (m_zero_check && b->_data._int == 0)) \
+			goto operator_generic;                                                                       \
+		GET_VARIANT_PTR(dst, 4);                                                                         \
+		m_ret result = a->_data._int m_op b->_data._int;                                                 \
+		OPCODE_TYPED_RESULT(dst, m_ret_type, m_ret_field, result);                                       \
+		ip += 5;                                                                                         \
+	}                                                                                                    \
+	DISPATCH_OPCODE
+
+#define OPCODE_TYPED_REAL(m_opcode, m_op, m_ret, m_ret_type, m_ret_field)                                                  \
+	OPCODE(m_opcode) {                                                                                                     \
+		CHECK_SPACE(5);                                                                                                    \
+		GET_VARIANT_PTR(a, 2);                                                                                             \
+		GET_VARIANT_PTR(b, 3);                                                                                             \
+		if ((a->type != Variant::REAL && a->type != Variant::INT) || (b->type != Variant::REAL && b->type != Variant::INT)) \
+			goto operator_generic;                                                                                         \
+		if (a->type == Variant::INT && b->type == Variant::INT)                                                            \
+			goto operator_generic;                                                                                         \
+		GET_VARIANT_PTR(dst, 4);                                                                                           \
+		double ra = a->type == Variant::REAL ? a->_data._real : double(a->_data._int);                                     \
+		double rb = b->type == Variant::REAL ? b->_data._real : double(b->_data._int);                                     \
+		m_ret result = ra m_op rb;                                                                                         \
+		OPCODE_TYPED_RESULT(dst, m_ret_type, m_ret_field, result);                                                         \
+		ip += 5;                                                                                                           \
+	}                                                                                                                      \
+	DISPATCH_OPCODE
+
+void GDFunction::_setup_address_table(AddressTable &r_table, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack) const {
+
+	for (int i = 0; i < ADDR_TYPE_MAX; i++) {
+		r_table.base[i] = NULL;
+#ifdef DEBUG_ENABLED
+		r_table.size[i] = 0;
+#endif
+	}
+
+	//self and members are only valid with an instance, otherwise the slow path reports the error
+	if (p_instance) {
+		r_table.base[ADDR_TYPE_SELF] = &self;
+		r_table.base[ADDR_TYPE_MEMBER] = p_instance->members.ptr();
+#ifdef DEBUG_ENABLED
+		r_table.size[ADDR_TYPE_SELF] = 1;
+		r_table.size[ADDR_TYPE_MEMBER] = p_instance->members.size();
+#endif
+	}
+
+	r_table.base[ADDR_TYPE_CLASS] = &p_script->_static_ref;
+	r_table.base[ADDR_TYPE_LOCAL_CONSTANT] = _constants_ptr;
+	r_table.base[ADDR_TYPE_STACK] = p_stack;
+	r_table.base[ADDR_TYPE_STACK_VARIABLE] = p_stack;
+	r_table.base[ADDR_TYPE_NIL] = &nil;
+#ifdef DEBUG_ENABLED
+	r_table.size[ADDR_TYPE_CLASS] = 1;
+	r_table.size[ADDR_TYPE_LOCAL_CONSTANT] = _constant_count;
+	r_table.size[ADDR_TYPE_STACK] = _stack_size;
+	r_table.size[ADDR_TYPE_STACK_VARIABLE] = _stack_size;
+	r_table.size[ADDR_TYPE_NIL] = 1;
+#endif
+}
+
+Variant *GDFunction::_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, const AddressTable &p_table, String &r_error) const {
+
+	int address = p_address & ADDR_MASK;
+	int type = (p_address & ADDR_TYPE_MASK) >> ADDR_BITS;
+
+	if (type < ADDR_TYPE_MAX && p_table.base[type]) {
+#ifdef DEBUG_ENABLED
+		ERR_FAIL_INDEX_V(address, p_table.size[type], NULL);
+#endif
+		return &p_table.base[type][address];
+	}
+
+	return _get_variant_slow(p_address, p_instance, p_script, r_error);
+}
+
+Variant *GDFunction::_get_variant_slow(int p_address, GDInstance *p_instance, GDScript *p_script, String &r_error) const {
 
 	int address = p_address & ADDR_MASK;
 
-	//sequential table (jump table generated by compiler)
 	switch ((p_address & ADDR_TYPE_MASK) >> ADDR_BITS) {
 
 		case ADDR_TYPE_SELF: {
 
-			if (!p_instance) {
-				r_error = "Cannot access self without instance.";
-				return NULL;
-			}
-			return &self;
-		} break;
-		case ADDR_TYPE_CLASS: {
-
-			return &p_script->_static_ref;
+			r_error = "Cannot access self without instance.";
+			return NULL;
 		} break;
 		case ADDR_TYPE_MEMBER: {
-			//member indexing is O(1)
-			if (!p_instance) {
-				r_error = "Cannot access member without instance.";
-				return NULL;
-			}
-			return &p_instance->members[address];
+
+			r_error = "Cannot access member without instance.";
+			return NULL;
 		} break;
 		case ADDR_TYPE_CLASS_CONSTANT: {
 
-			//todo change to index!
+			//the compiler folds constants it can into local constants, this is only used for containers
 			GDScript *o = p_script;
 			ERR_FAIL_INDEX_V(address, _global_names_count, NULL);
 			const StringName *sn = &_global_names_ptr[address];
@@ -53,24 +168,13 @@ Variant *GDFunction::_get_variant(int p_address, GDInstance *p_instance, GDScrip
 			ERR_EXPLAIN("GDCompiler bug..");
 			ERR_FAIL_V(NULL);
 		} break;
-		case ADDR_TYPE_LOCAL_CONSTANT: {
-			ERR_FAIL_INDEX_V(address, _constant_count, NULL);
-			return &_constants_ptr[address];
-		} break;
-		case ADDR_TYPE_STACK:
-		case ADDR_TYPE_STACK_VARIABLE: {
-			ERR_FAIL_INDEX_V(address, _stack_size, NULL);
-			return &p_stack[address];
-		} break;
 		case ADDR_TYPE_GLOBAL: {
 
+			//not cached in the table, the global array may grow while the function runs
 			ERR_FAIL_INDEX_V(address, GDScriptLanguage::get_singleton()->get_global_array_size(), NULL);
 
 			return &GDScriptLanguage::get_singleton()->get_global_array()[address];
 		} break;
-		case ADDR_TYPE_NIL: {
-			return &nil;
-		} break;
 	}
 
 	ERR_EXPLAIN("Bad Code! (Addressing Mode)");
@@ -131,6 +235,119 @@ static String _get_var_type(const Variant *p_type) {
 	return basestr;
 }
 
+Object *GDFunction::_get_cacheable_object(const Variant *p_base, GDInstance *&r_instance) {
+
+	if (p_base->type != Variant::OBJECT)
+		return NULL;
+
+	Object *obj = p_base->_get_obj().obj;
+	if (!obj)
+		return NULL;
+
+#ifdef DEBUG_ENABLED
+	if (ScriptDebugger::get_singleton() && p_base->_get_obj().ref.is_null() && !ObjectDB::instance_validate(obj))
+		return NULL; //let the regular path report it
+#endif
+
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		//placeholders and other languages resolve names their own way
+		if (si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton())
+			return NULL;
+		r_instance = static_cast<GDInstance *>(si);
+	} else {
+		r_instance = NULL;
+	}
+
+	return obj;
+}
+
+const GDFunction::InlineCache *GDFunction::_get_inline_cache(int p_slot, Object *p_obj, GDInstance *p_instance, const StringName &p_name, InlineCacheKind p_kind) {
+
+	const InlineCache *ic = _inline_caches_ptr[p_slot];
+	GDScript *script = p_instance ? p_instance->script.ptr() : NULL;
+
+	if (ic && ic->script == script && ic->type == p_obj->get_type_name() && ic->version == GDScriptLanguage::get_singleton()->get_inline_cache_version())
+		return ic;
+
+	if (ic && ic->misses >= INLINE_CACHE_MAX_MISSES)
+		return NULL; //polymorphic, don't bother
+
+	return _update_inline_cache(p_slot, p_obj, p_instance, p_name, p_kind);
+}
+
+const GDFunction::InlineCache *GDFunction::_update_inline_cache(int p_slot, Object *p_obj, GDInstance *p_instance, const StringName &p_name, InlineCacheKind p_kind) {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	GDScript *script = p_instance ? p_instance->script.ptr() : NULL;
+
+	//an entry with nothing resolved is cached too, so the lookup is not repeated every time
+	InlineCache *ic = memnew(InlineCache);
+	ic->version = language->get_inline_cache_version();
+	ic->type = p_obj->get_type_name();
+	ic->script = script;
+	ic->function = NULL;
+	ic->method = NULL;
+	ic->member = -1;
+
+	switch (p_kind) {
+
+		case INLINE_CACHE_CALL: {
+
+			if (p_name == CoreStringNames::get_singleton()->_free || p_obj->cast_to<Script>())
+				break; //free is special, scripts override call()
+
+			for (GDScript *sptr = script; sptr; sptr = sptr->_base) {
+
+				const Map<StringName, GDFunction *>::Element *E = sptr->member_functions.find(p_name);
+				if (E) {
+					ic->function = E->get();
+					break;
+				}
+			}
+
+			if (!ic->function) {
+				ic->method = ObjectTypeDB::get_method(ic->type, p_name);
+			}
+		} break;
+		case INLINE_CACHE_GET:
+		case INLINE_CACHE_SET: {
+
+			if (!script)
+				break;
+
+			const Map<StringName, GDScript::MemberInfo>::Element *E = script->member_indices.find(p_name);
+			if (!E)
+				break;
+
+			//members with setget must go through their functions
+			const StringName &accessor = p_kind == INLINE_CACHE_GET ? E->get().getter : E->get().setter;
+			if (accessor == StringName())
+				ic->member = E->get().index;
+		} break;
+	}
+
+	if (language->lock) {
+		language->lock->lock();
+	}
+
+	InlineCache *prev = _inline_caches_ptr[p_slot];
+	ic->misses = 0;
+	ic->prev = prev;
+	if (prev) {
+		//entries invalidated by a script change are not the site's fault
+		ic->misses = prev->version == ic->version ? prev->misses + 1 : prev->misses;
+	}
+	//replaced entries are freed with the function, other threads running it may still be reading them
+	_inline_caches_ptr[p_slot] = ic;
+
+	if (language->lock) {
+		language->lock->unlock();
+	}
+
+	return ic;
+}
+
 Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_argcount, Variant::CallError &r_err, CallState *p_state) {
 
 	if (!_code_ptr) {
@@ -236,25 +453,28 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 	String err_text;
 
+	AddressTable addresses;
+	_setup_address_table(addresses, p_instance, _class, self, stack);
+
 #ifdef DEBUG_ENABLED
 
 	if (ScriptDebugger::get_singleton())
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 
 #define CHECK_SPACE(m_space) \
-	ERR_BREAK((ip + m_space) > _code_size)
+	GD_ERR_BREAK((ip + m_space) > _code_size)
 
-#define GET_VARIANT_PTR(m_v, m_code_ofs)                                                       \
-	Variant *m_v;                                                                              \
-	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, self, stack, err_text); \
-	if (!m_v)                                                                                  \
-		break;
+#define GET_VARIANT_PTR(m_v, m_code_ofs)                                                    \
+	Variant *m_v;                                                                           \
+	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, addresses, err_text); \
+	if (!m_v)                                                                               \
+		OPCODE_BREAK;
 
 #else
 #define CHECK_SPACE(m_space)
 #define GET_VARIANT_PTR(m_v, m_code_ofs) \
 	Variant *m_v;                        \
-	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, self, stack, err_text);
+	m_v = _get_variant(_code_ptr[ip + m_code_ofs], p_instance, _class, addresses, err_text);
 
 #endif
 
@@ -272,18 +492,80 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 #endif
 	bool exit_ok = false;
 
-	while (ip < _code_size) {
+#ifdef GDSCRIPT_COMPUTED_GOTO
+	static const void *switch_table_ops[] = {
+		&&OPCODE_OPERATOR,
+		&&OPCODE_OPERATOR_ADD_INT,
+		&&OPCODE_OPERATOR_SUB_INT,
+		&&OPCODE_OPERATOR_MUL_INT,
+		&&OPCODE_OPERATOR_DIV_INT,
+		&&OPCODE_OPERATOR_MOD_INT,
+		&&OPCODE_OPERATOR_EQUAL_INT,
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,
+		&&OPCODE_OPERATOR_LESS_INT,
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,
+		&&OPCODE_OPERATOR_GREATER_INT,
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		&&OPCODE_OPERATOR_ADD_REAL,
+		&&OPCODE_OPERATOR_SUB_REAL,
+		&&OPCODE_OPERATOR_MUL_REAL,
+		&&OPCODE_OPERATOR_DIV_REAL,
+		&&OPCODE_OPERATOR_EQUAL_REAL,
+		&&OPCODE_OPERATOR_NOT_EQUAL_REAL,
+		&&OPCODE_OPERATOR_LESS_REAL,
+		&&OPCODE_OPERATOR_LESS_EQUAL_REAL,
+		&&OPCODE_OPERATOR_GREATER_REAL,
+		&&OPCODE_OPERATOR_GREATER_EQUAL_REAL,
+		&&OPCODE_EXTENDS_TEST,
+		&&OPCODE_SET,
+		&&OPCODE_GET,
+		&&OPCODE_SET_NAMED,
+		&&OPCODE_GET_NAMED,
+		&&OPCODE_ASSIGN,
+		&&OPCODE_ASSIGN_TRUE,
+		&&OPCODE_ASSIGN_FALSE,
+		&&OPCODE_CONSTRUCT,
+		&&OPCODE_CONSTRUCT_ARRAY,
+		&&OPCODE_CONSTRUCT_DICTIONARY,
+		&&OPCODE_CALL,
+		&&OPCODE_CALL_RETURN,
+		&&OPCODE_CALL_BUILT_IN,
+		&&OPCODE_CALL_SELF,
+		&&OPCODE_CALL_SELF_BASE,
+		&&OPCODE_YIELD,
+		&&OPCODE_YIELD_SIGNAL,
+		&&OPCODE_YIELD_RESUME,
+		&&OPCODE_JUMP,
+		&&OPCODE_JUMP_IF,
+		&&OPCODE_JUMP_IF_NOT,
+		&&OPCODE_JUMP_TO_DEF_ARGUMENT,
+		&&OPCODE_RETURN,
+		&&OPCODE_ITERATE_BEGIN,
+		&&OPCODE_ITERATE,
+		&&OPCODE_ASSERT,
+		&&OPCODE_BREAKPOINT,
+		&&OPCODE_LINE,
+		&&OPCODE_END,
+	};
+	//the table must list every opcode, in enum order
+	enum { SWITCH_TABLE_OPS_CHECK = 1 / int(sizeof(switch_table_ops) / sizeof(switch_table_ops[0]) == OPCODE_MAX) };
+#endif
+
+	int last_opcode = 0;
+
+	OPCODE_WHILE(ip < _code_size) {
 
-		int last_opcode = _code_ptr[ip];
-		switch (_code_ptr[ip]) {
+		last_opcode = _code_ptr[ip];
+		OPCODE_SWITCH(last_opcode) {
 
-			case OPCODE_OPERATOR: {
+			OPCODE(OPCODE_OPERATOR) {
 
+			operator_generic:
 				CHECK_SPACE(5);
 
 				bool valid;
 				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
-				ERR_BREAK(op >= Variant::OP_MAX);
+				GD_ERR_BREAK(op >= Variant::OP_MAX);
 
 				GET_VARIANT_PTR(a, 2);
 				GET_VARIANT_PTR(b, 3);
@@ -307,7 +589,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 						err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
 					}
 #endif
-					break;
+					OPCODE_BREAK;
 				}
 #ifdef DEBUG_ENABLED
 				*dst = ret;
@@ -315,8 +597,29 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 5;
 			}
-				continue;
-			case OPCODE_EXTENDS_TEST: {
+			DISPATCH_OPCODE;
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_ADD_INT, +, int, INT, _int, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_SUB_INT, -, int, INT, _int, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_MUL_INT, *, int, INT, _int, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_DIV_INT, /, int, INT, _int, true);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_MOD_INT, %, int, INT, _int, true);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_EQUAL_INT, ==, bool, BOOL, _bool, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_NOT_EQUAL_INT, !=, bool, BOOL, _bool, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_LESS_INT, <, bool, BOOL, _bool, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_LESS_EQUAL_INT, <=, bool, BOOL, _bool, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_GREATER_INT, >, bool, BOOL, _bool, false);
+			OPCODE_TYPED_INT(OPCODE_OPERATOR_GREATER_EQUAL_INT, >=, bool, BOOL, _bool, false);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_ADD_REAL, +, double, REAL, _real);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_SUB_REAL, -, double, REAL, _real);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_MUL_REAL, *, double, REAL, _real);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_DIV_REAL, /, double, REAL, _real);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_EQUAL_REAL, ==, bool, BOOL, _bool);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_NOT_EQUAL_REAL, !=, bool, BOOL, _bool);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_LESS_REAL, <, bool, BOOL, _bool);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_LESS_EQUAL_REAL, <=, bool, BOOL, _bool);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_GREATER_REAL, >, bool, BOOL, _bool);
+			OPCODE_TYPED_REAL(OPCODE_OPERATOR_GREATER_EQUAL_REAL, >=, bool, BOOL, _bool);
+			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
 
@@ -329,12 +632,12 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (a->get_type() != Variant::OBJECT || a->operator Object *() == NULL) {
 
 					err_text = "Left operand of 'extends' is not an instance of anything.";
-					break;
+					OPCODE_BREAK;
 				}
 				if (b->get_type() != Variant::OBJECT || b->operator Object *() == NULL) {
 
 					err_text = "Right operand of 'extends' is not a class.";
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 
@@ -372,7 +675,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					if (!nc) {
 
 						err_text = "Right operand of 'extends' is not a class (type: '" + obj_B->get_type() + "').";
-						break;
+						OPCODE_BREAK;
 					}
 
 					extends_ok = ObjectTypeDB::is_type(obj_A->get_type_name(), nc->get_name());
@@ -381,8 +684,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				*dst = extends_ok;
 				ip += 4;
 			}
-				continue;
-			case OPCODE_SET: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_SET) {
 
 				CHECK_SPACE(3);
 
@@ -401,13 +704,13 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 						v = "of type '" + _get_var_type(index) + "'";
 					}
 					err_text = "Invalid set index " + v + " (on base: '" + _get_var_type(dst) + "').";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4;
 			}
-				continue;
-			case OPCODE_GET: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_GET) {
 
 				CHECK_SPACE(3);
 
@@ -431,74 +734,104 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 						v = "of type '" + _get_var_type(index) + "'";
 					}
 					err_text = "Invalid get index " + v + " (on base: '" + _get_var_type(src) + "').";
-					break;
+					OPCODE_BREAK;
 				}
 #ifdef DEBUG_ENABLED
 				*dst = ret;
 #endif
 				ip += 4;
 			}
-				continue;
-			case OPCODE_SET_NAMED: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_SET_NAMED) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 1);
-				GET_VARIANT_PTR(value, 3);
+				GET_VARIANT_PTR(value, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
-				ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, &valid);
+				int cache_slot = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_slot < 0 || cache_slot >= _inline_cache_count);
 
-				if (!valid) {
-					String err_type;
-					err_text = "Invalid set index '" + String(*index) + "' (on base: '" + _get_var_type(dst) + "').";
-					break;
+				GDInstance *cache_instance;
+				Object *cache_obj = _get_cacheable_object(dst, cache_instance);
+#ifdef TOOLS_ENABLED
+				if (cache_obj && !cache_obj->is_edited())
+					cache_obj = NULL; //Object::set() flags it as edited
+#endif
+				const InlineCache *ic = cache_obj ? _get_inline_cache(cache_slot, cache_obj, cache_instance, *index, INLINE_CACHE_SET) : NULL;
+
+				if (ic && ic->member >= 0) {
+
+					cache_instance->members[ic->member] = *value;
+				} else {
+
+					bool valid;
+					dst->set_named(*index, *value, &valid);
+
+					if (!valid) {
+						String err_type;
+						err_text = "Invalid set index '" + String(*index) + "' (on base: '" + _get_var_type(dst) + "').";
+						OPCODE_BREAK;
+					}
 				}
 
-				ip += 4;
+				ip += 5;
 			}
-				continue;
-			case OPCODE_GET_NAMED: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_GET_NAMED) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(src, 1);
-				GET_VARIANT_PTR(dst, 3);
+				GET_VARIANT_PTR(dst, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
-				ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_slot = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_slot < 0 || cache_slot >= _inline_cache_count);
+
+				GDInstance *cache_instance;
+				Object *cache_obj = _get_cacheable_object(src, cache_instance);
+				const InlineCache *ic = cache_obj ? _get_inline_cache(cache_slot, cache_obj, cache_instance, *index, INLINE_CACHE_GET) : NULL;
+
+				if (ic && ic->member >= 0) {
+
+					*dst = cache_instance->members[ic->member];
+				} else {
+
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, &valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, &valid);
 
 #else
-				*dst = src->get_named(*index, &valid);
+					*dst = src->get_named(*index, &valid);
 #endif
 
-				if (!valid) {
-					if (src->has_method(*index)) {
-						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "'). Did you mean '." + index->operator String() + "()' ?";
-					} else {
-						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+					if (!valid) {
+						if (src->has_method(*index)) {
+							err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "'). Did you mean '." + index->operator String() + "()' ?";
+						} else {
+							err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+						}
+						OPCODE_BREAK;
 					}
-					break;
-				}
 #ifdef DEBUG_ENABLED
-				*dst = ret;
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 5;
 			}
-				continue;
-			case OPCODE_ASSIGN: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN) {
 
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(dst, 1);
@@ -508,8 +841,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3;
 			}
-				continue;
-			case OPCODE_ASSIGN_TRUE: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN_TRUE) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(dst, 1);
@@ -518,8 +851,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_ASSIGN_FALSE: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSIGN_FALSE) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(dst, 1);
@@ -528,8 +861,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_CONSTRUCT: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT) {
 
 				CHECK_SPACE(2);
 				Variant::Type t = Variant::Type(_code_ptr[ip + 1]);
@@ -548,14 +881,14 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (err.error != Variant::CallError::CALL_OK) {
 
 					err_text = _get_call_error(err, "'" + Variant::get_type_name(t) + "' constructor", (const Variant **)argptrs);
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4 + argc;
 				//construct a basic type
 			}
-				continue;
-			case OPCODE_CONSTRUCT_ARRAY: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT_ARRAY) {
 
 				CHECK_SPACE(1);
 				int argc = _code_ptr[ip + 1];
@@ -574,8 +907,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3 + argc;
 			}
-				continue;
-			case OPCODE_CONSTRUCT_DICTIONARY: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CONSTRUCT_DICTIONARY) {
 
 				CHECK_SPACE(1);
 				int argc = _code_ptr[ip + 1];
@@ -596,9 +929,9 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 				ip += 3 + argc * 2;
 			}
-				continue;
-			case OPCODE_CALL_RETURN:
-			case OPCODE_CALL: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_RETURN)
+			OPCODE(OPCODE_CALL) {
 
 				CHECK_SPACE(4);
 				bool call_ret = _code_ptr[ip] == OPCODE_CALL_RETURN;
@@ -607,11 +940,14 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				GET_VARIANT_PTR(base, 2);
 				int nameg = _code_ptr[ip + 3];
 
-				ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
+				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[nameg];
 
-				ERR_BREAK(argc < 0);
-				ip += 4;
+				int cache_slot = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_slot < 0 || cache_slot >= _inline_cache_count);
+
+				GD_ERR_BREAK(argc < 0);
+				ip += 5;
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -629,13 +965,39 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 #endif
 				Variant::CallError err;
+				Variant *ret = NULL;
 				if (call_ret) {
 
-					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
+					GET_VARIANT_PTR(dst, argc);
+					ret = dst;
+				}
+
+				GDInstance *cache_instance;
+				Object *cache_obj = _get_cacheable_object(base, cache_instance);
+				const InlineCache *ic = cache_obj ? _get_inline_cache(cache_slot, cache_obj, cache_instance, *methodname, INLINE_CACHE_CALL) : NULL;
+
+				if (ic && (ic->function || ic->method)) {
+
+					//same as Object::call(), minus the lookups
+					err.error = Variant::CallError::CALL_OK;
+					Variant r;
+					{
+#ifdef DEBUG_ENABLED
+						_ObjectDebugLock debug_lock(cache_obj);
+#endif
+						if (ic->function) {
+							r = ic->function->call(cache_instance, (const Variant **)argptrs, argc, err);
+						} else {
+							r = ic->method->call(cache_obj, (const Variant **)argptrs, argc, err);
+						}
+					}
+
+					//assigning may free the base if it's the last reference, so it happens after the lock is released
+					if (ret && err.error == Variant::CallError::CALL_OK)
+						*ret = r;
 				} else {
 
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -662,29 +1024,29 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 							if (base->is_ref()) {
 								err_text = "Attempted to free a reference.";
-								break;
+								OPCODE_BREAK;
 							} else if (base->get_type() == Variant::OBJECT) {
 
 								err_text = "Attempted to free a locked object (calling or emitting).";
-								break;
+								OPCODE_BREAK;
 							}
 						}
 					}
 					err_text = _get_call_error(err, "function '" + methodstr + "' in base '" + basestr + "'", (const Variant **)argptrs);
-					break;
+					OPCODE_BREAK;
 				}
 
 				//_call_func(NULL,base,*methodname,ip,argc,p_instance,stack);
 				ip += argc + 1;
 			}
-				continue;
-			case OPCODE_CALL_BUILT_IN: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_BUILT_IN) {
 
 				CHECK_SPACE(4);
 
 				GDFunctions::Function func = GDFunctions::Function(_code_ptr[ip + 1]);
 				int argc = _code_ptr[ip + 2];
-				ERR_BREAK(argc < 0);
+				GD_ERR_BREAK(argc < 0);
 
 				ip += 3;
 				CHECK_SPACE(argc + 1);
@@ -710,15 +1072,16 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					} else {
 						err_text = _get_call_error(err, "built-in function '" + methodstr + "'", (const Variant **)argptrs);
 					}
-					break;
+					OPCODE_BREAK;
 				}
 				ip += argc + 1;
 			}
-				continue;
-			case OPCODE_CALL_SELF: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_CALL_SELF) {
 
-			} break;
-			case OPCODE_CALL_SELF_BASE: {
+			}
+			OPCODE_BREAK;
+			OPCODE(OPCODE_CALL_SELF_BASE) {
 
 				CHECK_SPACE(2);
 				int self_fun = _code_ptr[ip + 1];
@@ -727,7 +1090,7 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (self_fun < 0 || self_fun >= _global_names_count) {
 
 					err_text = "compiler bug, function name not found";
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				const StringName *methodname = &_global_names_ptr[self_fun];
@@ -787,14 +1150,14 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					String methodstr = *methodname;
 					err_text = _get_call_error(err, "function '" + methodstr + "'", (const Variant **)argptrs);
 
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 4 + argc;
 			}
-				continue;
-			case OPCODE_YIELD:
-			case OPCODE_YIELD_SIGNAL: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_YIELD)
+			OPCODE(OPCODE_YIELD_SIGNAL) {
 
 				int ipofs = 1;
 				if (_code_ptr[ip] == OPCODE_YIELD_SIGNAL) {
@@ -834,11 +1197,11 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 					if (argobj->get_type() != Variant::OBJECT) {
 						err_text = "First argument of yield() not of type object.";
-						break;
+						OPCODE_BREAK;
 					}
 					if (argname->get_type() != Variant::STRING) {
 						err_text = "Second argument of yield() not a string (for signal name).";
-						break;
+						OPCODE_BREAK;
 					}
 					Object *obj = argobj->operator Object *();
 					String signal = argname->operator String();
@@ -846,53 +1209,54 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 
 					if (!obj) {
 						err_text = "First argument of yield() is null.";
-						break;
+						OPCODE_BREAK;
 					}
 					if (ScriptDebugger::get_singleton()) {
 						if (!ObjectDB::instance_validate(obj)) {
 							err_text = "First argument of yield() is a previously freed instance.";
-							break;
+							OPCODE_BREAK;
 						}
 					}
 					if (signal.length() == 0) {
 
 						err_text = "Second argument of yield() is an empty string (for signal name).";
-						break;
+						OPCODE_BREAK;
 					}
 
 #endif
 					Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + signal + " during yield().";
-						break;
+						OPCODE_BREAK;
 					}
 				}
 
 				exit_ok = true;
 
-			} break;
-			case OPCODE_YIELD_RESUME: {
+			}
+			OPCODE_BREAK;
+			OPCODE(OPCODE_YIELD_RESUME) {
 
 				CHECK_SPACE(2);
 				if (!p_state) {
 					err_text = ("Invalid Resume (bug?)");
-					break;
+					OPCODE_BREAK;
 				}
 				GET_VARIANT_PTR(result, 1);
 				*result = p_state->result;
 				ip += 2;
 			}
-				continue;
-			case OPCODE_JUMP: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP) {
 
 				CHECK_SPACE(2);
 				int to = _code_ptr[ip + 1];
 
-				ERR_BREAK(to < 0 || to > _code_size);
+				GD_ERR_BREAK(to < 0 || to > _code_size);
 				ip = to;
 			}
-				continue;
-			case OPCODE_JUMP_IF: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_IF) {
 
 				CHECK_SPACE(3);
 
@@ -904,19 +1268,19 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				if (result) {
 					int to = _code_ptr[ip + 2];
-					ERR_BREAK(to < 0 || to > _code_size);
+					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				ip += 3;
 			}
-				continue;
-			case OPCODE_JUMP_IF_NOT: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_IF_NOT) {
 
 				CHECK_SPACE(3);
 
@@ -928,33 +1292,34 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 #endif
 				if (!result) {
 					int to = _code_ptr[ip + 2];
-					ERR_BREAK(to < 0 || to > _code_size);
+					GD_ERR_BREAK(to < 0 || to > _code_size);
 					ip = to;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				ip += 3;
 			}
-				continue;
-			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
 			}
-				continue;
-			case OPCODE_RETURN: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_RETURN) {
 
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(r, 1);
 				retvalue = *r;
 				exit_ok = true;
 
-			} break;
-			case OPCODE_ITERATE_BEGIN: {
+			}
+			OPCODE_BREAK;
+			OPCODE(OPCODE_ITERATE_BEGIN) {
 
 				CHECK_SPACE(8); //space for this an regular iterate
 
@@ -965,25 +1330,25 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!container->iter_init(*counter, valid)) {
 					if (!valid) {
 						err_text = "Unable to iterate on object of type  " + Variant::get_type_name(container->get_type()) + "'.";
-						break;
+						OPCODE_BREAK;
 					}
 					int jumpto = _code_ptr[ip + 3];
-					ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				GET_VARIANT_PTR(iterator, 4);
 
 				*iterator = container->iter_get(*counter, valid);
 				if (!valid) {
 					err_text = "Unable to obtain iterator object of type  " + Variant::get_type_name(container->get_type()) + "'.";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 5; //skip regular iterate which is always next
 			}
-				continue;
-			case OPCODE_ITERATE: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_ITERATE) {
 
 				CHECK_SPACE(4);
 
@@ -994,25 +1359,25 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!container->iter_next(*counter, valid)) {
 					if (!valid) {
 						err_text = "Unable to iterate on object of type  " + Variant::get_type_name(container->get_type()) + "' (type changed since first iteration?).";
-						break;
+						OPCODE_BREAK;
 					}
 					int jumpto = _code_ptr[ip + 3];
-					ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
-					continue;
+					DISPATCH_OPCODE;
 				}
 				GET_VARIANT_PTR(iterator, 4);
 
 				*iterator = container->iter_get(*counter, valid);
 				if (!valid) {
 					err_text = "Unable to obtain iterator object of type  " + Variant::get_type_name(container->get_type()) + "' (but was obtained on first iteration?).";
-					break;
+					OPCODE_BREAK;
 				}
 
 				ip += 5; //loop again
 			}
-				continue;
-			case OPCODE_ASSERT: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(2);
 				GET_VARIANT_PTR(test, 1);
 
@@ -1023,21 +1388,21 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 				if (!valid) {
 
 					err_text = "cannot evaluate conditional expression of type: " + Variant::get_type_name(test->get_type());
-					break;
+					OPCODE_BREAK;
 				}
 
 				if (!result) {
 
 					err_text = "Assertion failed.";
-					break;
+					OPCODE_BREAK;
 				}
 
 #endif
 
 				ip += 2;
 			}
-				continue;
-			case OPCODE_BREAKPOINT: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_BREAKPOINT) {
 #ifdef DEBUG_ENABLED
 				if (ScriptDebugger::get_singleton()) {
 					GDScriptLanguage::get_singleton()->debug_break("Breakpoint Statement", true);
@@ -1045,8 +1410,8 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 #endif
 				ip += 1;
 			}
-				continue;
-			case OPCODE_LINE: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
 				line = _code_ptr[ip + 1];
@@ -1074,21 +1439,25 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 					ScriptDebugger::get_singleton()->line_poll();
 				}
 			}
-				continue;
-			case OPCODE_END: {
+			DISPATCH_OPCODE;
+			OPCODE(OPCODE_END) {
 
 				exit_ok = true;
-				break;
-
-			} break;
+			}
+			OPCODE_BREAK;
+#ifndef GDSCRIPT_COMPUTED_GOTO
 			default: {
 
 				err_text = "Illegal opcode " + itos(_code_ptr[ip]) + " at address " + itos(ip);
-			} break;
+			}
+			OPCODE_BREAK;
+#endif
 		}
 
+	opcode_exit:
+
 		if (exit_ok)
-			break;
+			OPCODE_OUT;
 		//error
 		// function, file, line, error, explanation
 		String err_file;
@@ -1112,9 +1481,11 @@ Variant GDFunction::call(GDInstance *p_instance, const Variant **p_args, int p_a
 			_err_print_error(err_func.utf8().get_data(), err_file.utf8().get_data(), err_line, err_text.utf8().get_data(), ERR_HANDLER_SCRIPT);
 		}
 
-		break;
+		OPCODE_OUT;
 	}
 
+function_exit:
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -1270,6 +1641,8 @@ GDFunction::GDFunction()
 
 	_stack_size = 0;
 	_call_size = 0;
+	_inline_caches_ptr = NULL;
+	_inline_cache_count = 0;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
 	_func_cname = NULL;
@@ -1297,6 +1670,17 @@ GDFunction::GDFunction()
 }
 
 GDFunction::~GDFunction() {
+
+	for (int i = 0; i < _inline_cache_count; i++) {
+
+		InlineCache *ic = _inline_caches_ptr[i];
+		while (ic) {
+			InlineCache *prev = ic->prev;
+			memdelete(ic);
+			ic = prev;
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->lock) {
 		GDScriptLanguage::get_singleton()->lock->lock();
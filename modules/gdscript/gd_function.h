@@ -10,11 +10,33 @@
 
 class GDInstance;
 class GDScript;
+class MethodBind;
 
 class GDFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUB_INT,
+		OPCODE_OPERATOR_MUL_INT,
+		OPCODE_OPERATOR_DIV_INT,
+		OPCODE_OPERATOR_MOD_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_REAL,
+		OPCODE_OPERATOR_SUB_REAL,
+		OPCODE_OPERATOR_MUL_REAL,
+		OPCODE_OPERATOR_DIV_REAL,
+		OPCODE_OPERATOR_EQUAL_REAL,
+		OPCODE_OPERATOR_NOT_EQUAL_REAL,
+		OPCODE_OPERATOR_LESS_REAL,
+		OPCODE_OPERATOR_LESS_EQUAL_REAL,
+		OPCODE_OPERATOR_GREATER_REAL,
+		OPCODE_OPERATOR_GREATER_EQUAL_REAL,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_SET,
 		OPCODE_GET,
@@ -44,7 +66,8 @@ public:
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
-		OPCODE_END
+		OPCODE_END,
+		OPCODE_MAX
 	};
 
 	enum Address {
@@ -59,7 +82,8 @@ public:
 		ADDR_TYPE_STACK = 5,
 		ADDR_TYPE_STACK_VARIABLE = 6,
 		ADDR_TYPE_GLOBAL = 7,
-		ADDR_TYPE_NIL = 8
+		ADDR_TYPE_NIL = 8,
+		ADDR_TYPE_MAX = 9
 	};
 
 	struct StackDebug {
@@ -97,13 +121,55 @@ private:
 	Vector<int> default_arguments;
 	Vector<int> code;
 
+	//monomorphic inline cache of a call or named get/set site, keyed on the receiver's native type and script
+	struct InlineCache {
+
+		uint32_t version;
+		StringName type;
+		GDScript *script;
+		GDFunction *function;
+		MethodBind *method;
+		int member;
+		int misses;
+		InlineCache *prev; //replaced entries stay alive until the function is freed, other threads may still read them
+	};
+
+	enum InlineCacheKind {
+		INLINE_CACHE_CALL,
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+	};
+
+	enum {
+		INLINE_CACHE_MAX_MISSES = 4 //polymorphic sites stop being cached
+	};
+
+	Vector<InlineCache *> inline_caches;
+	InlineCache **_inline_caches_ptr;
+	int _inline_cache_count;
+
+	static _FORCE_INLINE_ Object *_get_cacheable_object(const Variant *p_base, GDInstance *&r_instance);
+	_FORCE_INLINE_ const InlineCache *_get_inline_cache(int p_slot, Object *p_obj, GDInstance *p_instance, const StringName &p_name, InlineCacheKind p_kind);
+	const InlineCache *_update_inline_cache(int p_slot, Object *p_obj, GDInstance *p_instance, const StringName &p_name, InlineCacheKind p_kind);
+
 #ifdef TOOLS_ENABLED
 	Vector<StringName> arg_names;
 #endif
 
 	List<StackDebug> stack_debug;
 
-	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
+	//base slot of every addressing mode, resolved once per call so operands are a single indexed load
+	struct AddressTable {
+
+		Variant *base[ADDR_TYPE_MAX];
+#ifdef DEBUG_ENABLED
+		int size[ADDR_TYPE_MAX];
+#endif
+	};
+
+	_FORCE_INLINE_ void _setup_address_table(AddressTable &r_table, GDInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack) const;
+	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDInstance *p_instance, GDScript *p_script, const AddressTable &p_table, String &r_error) const;
+	Variant *_get_variant_slow(int p_address, GDInstance *p_instance, GDScript *p_script, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
 	friend class GDScriptLanguage;
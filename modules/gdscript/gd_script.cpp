@@ -821,6 +821,10 @@ GDScript::GDScript()
 }
 
 GDScript::~GDScript() {
+
+	//call sites may have cached this script or its functions
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches();
+
 	for (Map<StringName, GDFunction *>::Element *E = member_functions.front(); E; E = E->next()) {
 		memdelete(E->get());
 	}
@@ -1702,6 +1706,7 @@ GDScriptLanguage::GDScriptLanguage() {
 #endif
 	profiling = false;
 	script_frame_time = 0;
+	inline_cache_version = 1;
 
 	_debug_call_stack_pos = 0;
 	int dmcs = GLOBAL_DEF("debug/script_max_call_stack", 1024);
@@ -264,9 +264,15 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	uint64_t script_frame_time;
 
+	uint32_t inline_cache_version;
+
 public:
 	int calls;
 
+	//inline caches of call sites are only valid for the version they were filled in
+	_FORCE_INLINE_ uint32_t get_inline_cache_version() const { return inline_cache_version; }
+	_FORCE_INLINE_ void invalidate_inline_caches() { inline_cache_version++; }
+
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
@@ -1034,7 +1034,7 @@ void OS_Windows::initialize(const VideoMode &p_desired, int p_video_driver, int
 	}
 
 	//
-	physics_server = memnew(PhysicsServerSW);
+	physics_server = PhysicsServerWrapMT::init_server<PhysicsServerSW>();
 	physics_server->init();
 
 	physics_2d_server = Physics2DServerWrapMT::init_server<Physics2DServerSW>();
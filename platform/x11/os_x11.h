@@ -41,6 +41,7 @@
 #include "servers/audio/audio_server_sw.h"
 #include "servers/audio/sample_manager_sw.h"
 #include "servers/physics_2d/physics_2d_server_sw.h"
+#include "servers/physics/physics_server_wrap_mt.h"
 #include "servers/physics_2d/physics_2d_server_wrap_mt.h"
 #include "servers/physics_server.h"
 #include "servers/spatial_sound/spatial_sound_server_sw.h"
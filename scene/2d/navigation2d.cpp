@@ -36,6 +36,8 @@ void Navigation2D::_navpoly_link(int p_id) {
 	NavMesh &nm = navpoly_map[p_id];
 	ERR_FAIL_COND(nm.linked);
 
+	_path_cache_clear();
+
 	DVector<Vector2> vertices = nm.navpoly->get_vertices();
 	int len = vertices.size();
 	if (len == 0)
@@ -144,6 +146,8 @@ void Navigation2D::_navpoly_unlink(int p_id) {
 
 	//print_line("UNLINK");
 
+	_path_cache_clear();
+
 	for (List<Polygon>::Element *E = nm.polygons.front(); E; E = E->next()) {
 
 		Polygon &p = E->get();
@@ -272,6 +276,214 @@ void Navigation2D::_clip_path(Vector<Vector2>& path, Polygon *from_poly, const V
 }
 #endif
 
+void Navigation2D::_heap_sift_up(int p_index) {
+
+	Polygon *p = open_heap[p_index];
+
+	while (p_index > 0) {
+		int parent = (p_index - 1) >> 1;
+		if (open_heap[parent]->cost <= p->cost)
+			break;
+		_heap_set(p_index, open_heap[parent]);
+		p_index = parent;
+	}
+
+	_heap_set(p_index, p);
+}
+
+void Navigation2D::_heap_sift_down(int p_index) {
+
+	Polygon *p = open_heap[p_index];
+
+	while (true) {
+		int child = (p_index << 1) + 1;
+		if (child >= open_count)
+			break;
+		if (child + 1 < open_count && open_heap[child + 1]->cost < open_heap[child]->cost)
+			child++;
+		if (p->cost <= open_heap[child]->cost)
+			break;
+		_heap_set(p_index, open_heap[child]);
+		p_index = child;
+	}
+
+	_heap_set(p_index, p);
+}
+
+void Navigation2D::_heap_push(Polygon *p_poly) {
+
+	if (open_count == open_heap.size()) {
+		open_heap.resize(MAX(open_count * 2, 64));
+	}
+
+	_heap_set(open_count, p_poly);
+	open_count++;
+	_heap_sift_up(open_count - 1);
+}
+
+Navigation2D::Polygon *Navigation2D::_heap_pop() {
+
+	Polygon *p = open_heap[0];
+	open_count--;
+
+	if (open_count > 0) {
+		_heap_set(0, open_heap[open_count]);
+		_heap_sift_down(0);
+	}
+
+	p->heap_index = -1;
+	return p;
+}
+
+bool Navigation2D::_solve(Polygon *begin_poly, Polygon *end_poly, const Vector2 &p_end_point) {
+
+	//expects prev_edge and heap_index of all polygons to be reset to -1, and the begin entry to be set
+
+	open_count = 0;
+
+	for (int i = 0; i < begin_poly->edges.size(); i++) {
+
+		Polygon *C = begin_poly->edges[i].C;
+
+		if (!C || C == begin_poly)
+			continue;
+
+#ifdef USE_ENTRY_POINT
+		Vector2 edge[2] = {
+			_get_vertex(begin_poly->edges[i].point),
+			_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
+		};
+
+		Vector2 entry = Geometry::get_closest_point_to_segment_2d(begin_poly->entry, edge);
+		float distance = begin_poly->entry.distance_to(entry);
+#else
+		float distance = begin_poly->center.distance_to(C->center);
+#endif
+
+		if (C->prev_edge != -1 && C->distance <= distance)
+			continue; //also reachable through another edge
+
+		C->prev_edge = begin_poly->edges[i].C_edge;
+		C->distance = distance;
+		C->cost = distance + C->center.distance_to(p_end_point);
+#ifdef USE_ENTRY_POINT
+		C->entry = entry;
+#endif
+
+		if (C->heap_index == -1)
+			_heap_push(C);
+		else
+			_heap_sift_up(C->heap_index);
+	}
+
+	bool found_route = false;
+
+	while (open_count) {
+
+		Polygon *p = _heap_pop();
+
+		if (p == end_poly) {
+			found_route = true;
+			break;
+		}
+
+		//open the neighbours for search
+		int es = p->edges.size();
+
+		for (int i = 0; i < es; i++) {
+
+			Polygon::Edge &e = p->edges[i];
+
+			if (!e.C || e.C == begin_poly)
+				continue;
+
+			if (e.C->prev_edge != -1 && e.C->heap_index == -1)
+				continue; //already closed
+
+#ifdef USE_ENTRY_POINT
+			Vector2 edge[2] = {
+				_get_vertex(p->edges[i].point),
+				_get_vertex(p->edges[(i + 1) % es].point)
+			};
+
+			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
+			float distance = p->entry.distance_to(edge_entry) + p->distance;
+
+#else
+
+			float distance = p->center.distance_to(e.C->center) + p->distance;
+
+#endif
+
+			if (e.C->prev_edge != -1) {
+				//still open, can we win the cost?
+
+				if (e.C->distance > distance) {
+
+					e.C->prev_edge = e.C_edge;
+					e.C->distance = distance;
+					e.C->cost = distance + e.C->center.distance_to(p_end_point);
+#ifdef USE_ENTRY_POINT
+					e.C->entry = edge_entry;
+#endif
+					_heap_sift_up(e.C->heap_index);
+				}
+			} else {
+				//add to open neighbours
+
+				e.C->prev_edge = e.C_edge;
+				e.C->distance = distance;
+				e.C->cost = distance + e.C->center.distance_to(p_end_point);
+#ifdef USE_ENTRY_POINT
+				e.C->entry = edge_entry;
+#endif
+				_heap_push(e.C);
+			}
+		}
+	}
+
+	//leftovers are stale for the next search
+	while (open_count) {
+		_heap_pop();
+	}
+
+	return found_route;
+}
+
+void Navigation2D::_path_cache_store(Polygon *begin_poly, Polygon *end_poly, bool p_found) {
+
+	PathCorridor corridor;
+	corridor.key.from = begin_poly;
+	corridor.key.to = end_poly;
+	corridor.found = p_found;
+
+	if (p_found) {
+
+		Polygon *p = end_poly;
+		while (p != begin_poly) {
+			PathCorridor::Step step;
+			step.polygon = p;
+			step.prev_edge = p->prev_edge;
+			corridor.steps.push_back(step);
+			p = p->edges[p->prev_edge].C;
+		}
+	}
+
+	if (path_cache.size() >= PATH_CACHE_MAX) {
+		//evict the least recently used
+		path_cache_map.erase(path_cache.back()->get().key);
+		path_cache.pop_back();
+	}
+
+	path_cache_map[corridor.key] = path_cache.push_front(corridor);
+}
+
+void Navigation2D::_path_cache_clear() {
+
+	path_cache.clear();
+	path_cache_map.clear();
+}
+
 Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vector2 &p_end, bool p_optimize) {
 
 	Polygon *begin_poly = NULL;
@@ -320,6 +532,7 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 			}
 
 			p.prev_edge = -1;
+			p.heap_index = -1;
 		}
 	}
 
@@ -381,122 +594,31 @@ Vector<Vector2> Navigation2D::get_simple_path(const Vector2 &p_start, const Vect
 
 	bool found_route = false;
 
-	List<Polygon *> open_list;
-
-	begin_poly->entry = p_start;
+	PathKey key;
+	key.from = begin_poly;
+	key.to = end_poly;
 
-	for (int i = 0; i < begin_poly->edges.size(); i++) {
-
-		if (begin_poly->edges[i].C) {
-
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
-#ifdef USE_ENTRY_POINT
-			Vector2 edge[2] = {
-				_get_vertex(begin_poly->edges[i].point),
-				_get_vertex(begin_poly->edges[(i + 1) % begin_poly->edges.size()].point)
-			};
-
-			Vector2 entry = Geometry::get_closest_point_to_segment_2d(begin_poly->entry, edge);
-			begin_poly->edges[i].C->distance = begin_poly->entry.distance_to(entry);
-			begin_poly->edges[i].C->entry = entry;
-#else
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
-#endif
-			open_list.push_back(begin_poly->edges[i].C);
-
-			if (begin_poly->edges[i].C == end_poly) {
-				found_route = true;
-			}
-		}
-	}
+	Map<PathKey, List<PathCorridor>::Element *>::Element *C = path_cache_map.find(key);
 
-	while (!found_route) {
+	if (C) {
+		//same polygons were searched recently, just restore the corridor
+		path_cache.move_to_front(C->get());
+		const PathCorridor &corridor = C->get()->get();
 
-		if (open_list.size() == 0) {
-			//	print_line("NOU OPEN LIST");
-			break;
+		for (int i = 0; i < corridor.steps.size(); i++) {
+			corridor.steps[i].polygon->prev_edge = corridor.steps[i].prev_edge;
 		}
-		//check open list
-
-		List<Polygon *>::Element *least_cost_poly = NULL;
-		float least_cost = 1e30;
-
-		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
-
-			Polygon *p = E->get();
-
-			float cost = p->distance;
-			cost += p->center.distance_to(end_point);
 
-			if (cost < least_cost) {
+		found_route = corridor.found;
 
-				least_cost_poly = E;
-				least_cost = cost;
-			}
-		}
-
-		Polygon *p = least_cost_poly->get();
-		//open the neighbours for search
-		int es = p->edges.size();
+	} else {
 
-		for (int i = 0; i < es; i++) {
+		begin_poly->entry = p_start;
 
-			Polygon::Edge &e = p->edges[i];
-
-			if (!e.C)
-				continue;
-
-#ifdef USE_ENTRY_POINT
-			Vector2 edge[2] = {
-				_get_vertex(p->edges[i].point),
-				_get_vertex(p->edges[(i + 1) % es].point)
-			};
-
-			Vector2 edge_entry = Geometry::get_closest_point_to_segment_2d(p->entry, edge);
-			float distance = p->entry.distance_to(edge_entry) + p->distance;
-
-#else
-
-			float distance = p->center.distance_to(e.C->center) + p->distance;
-
-#endif
-
-			if (e.C->prev_edge != -1) {
-				//oh this was visited already, can we win the cost?
-
-				if (e.C->distance > distance) {
-
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
-#ifdef USE_ENTRY_POINT
-					e.C->entry = edge_entry;
-#endif
-				}
-			} else {
-				//add to open neighbours
-
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
-#ifdef USE_ENTRY_POINT
-				e.C->entry = edge_entry;
-#endif
-
-				open_list.push_back(e.C);
-
-				if (e.C == end_poly) {
-					//oh my reached end! stop algorithm
-					found_route = true;
-					break;
-				}
-			}
-		}
-
-		if (found_route)
-			break;
-
-		open_list.erase(least_cost_poly);
+		found_route = _solve(begin_poly, end_poly, end_point);
+		_path_cache_store(begin_poly, end_poly, found_route);
 	}
+
 #if 0
 debug path
 	{
@@ -776,4 +898,5 @@ Navigation2D::Navigation2D() {
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 1; // one pixel
 	last_id = 1;
+	open_count = 0;
 }
@@ -94,6 +94,8 @@ class Navigation2D : public Node2D {
 		Vector2 entry;
 
 		float distance;
+		float cost; //distance plus the estimate to the goal, the open list is sorted by it
+		int heap_index;
 		int prev_edge;
 
 		bool clockwise;
@@ -149,6 +151,55 @@ class Navigation2D : public Node2D {
 	void _navpoly_link(int p_id);
 	void _navpoly_unlink(int p_id);
 
+	//polygons open for search, a binary min-heap on cost indexed by Polygon::heap_index
+	Vector<Polygon *> open_heap;
+	int open_count;
+
+	_FORCE_INLINE_ void _heap_set(int p_index, Polygon *p_poly) {
+		open_heap[p_index] = p_poly;
+		p_poly->heap_index = p_index;
+	}
+
+	void _heap_sift_up(int p_index);
+	void _heap_sift_down(int p_index);
+	void _heap_push(Polygon *p_poly);
+	Polygon *_heap_pop();
+
+	bool _solve(Polygon *begin_poly, Polygon *end_poly, const Vector2 &p_end_point);
+
+	//recently found polygon corridors, so agents heading to the same places don't search again
+	enum {
+		PATH_CACHE_MAX = 64
+	};
+
+	struct PathKey {
+
+		Polygon *from;
+		Polygon *to;
+
+		bool operator<(const PathKey &p_key) const {
+			return (from == p_key.from) ? (to < p_key.to) : (from < p_key.from);
+		}
+	};
+
+	struct PathCorridor {
+
+		struct Step {
+			Polygon *polygon;
+			int prev_edge;
+		};
+
+		PathKey key;
+		bool found;
+		Vector<Step> steps; //from the end polygon back to the begin one (not included)
+	};
+
+	List<PathCorridor> path_cache; //most recently used first
+	Map<PathKey, List<PathCorridor>::Element *> path_cache_map;
+
+	void _path_cache_store(Polygon *begin_poly, Polygon *end_poly, bool p_found);
+	void _path_cache_clear();
+
 	float cell_size;
 	Map<int, NavMesh> navpoly_map;
 	int last_id;
@@ -36,6 +36,8 @@ void Navigation::_navmesh_link(int p_id) {
 
 	print_line("LINK");
 
+	_path_cache_clear();
+
 	DVector<Vector3> vertices = nm.navmesh->get_vertices();
 	int len = vertices.size();
 	if (len == 0)
@@ -145,6 +147,8 @@ void Navigation::_navmesh_unlink(int p_id) {
 
 	print_line("UNLINK");
 
+	_path_cache_clear();
+
 	for (List<Polygon>::Element *E = nm.polygons.front(); E; E = E->next()) {
 
 		Polygon &p = E->get();
@@ -271,6 +275,181 @@ void Navigation::_clip_path(Vector<Vector3> &path, Polygon *from_poly, const Vec
 	}
 }
 
+void Navigation::_heap_sift_up(int p_index) {
+
+	Polygon *p = open_heap[p_index];
+
+	while (p_index > 0) {
+		int parent = (p_index - 1) >> 1;
+		if (open_heap[parent]->cost <= p->cost)
+			break;
+		_heap_set(p_index, open_heap[parent]);
+		p_index = parent;
+	}
+
+	_heap_set(p_index, p);
+}
+
+void Navigation::_heap_sift_down(int p_index) {
+
+	Polygon *p = open_heap[p_index];
+
+	while (true) {
+		int child = (p_index << 1) + 1;
+		if (child >= open_count)
+			break;
+		if (child + 1 < open_count && open_heap[child + 1]->cost < open_heap[child]->cost)
+			child++;
+		if (p->cost <= open_heap[child]->cost)
+			break;
+		_heap_set(p_index, open_heap[child]);
+		p_index = child;
+	}
+
+	_heap_set(p_index, p);
+}
+
+void Navigation::_heap_push(Polygon *p_poly) {
+
+	if (open_count == open_heap.size()) {
+		open_heap.resize(MAX(open_count * 2, 64));
+	}
+
+	_heap_set(open_count, p_poly);
+	open_count++;
+	_heap_sift_up(open_count - 1);
+}
+
+Navigation::Polygon *Navigation::_heap_pop() {
+
+	Polygon *p = open_heap[0];
+	open_count--;
+
+	if (open_count > 0) {
+		_heap_set(0, open_heap[open_count]);
+		_heap_sift_down(0);
+	}
+
+	p->heap_index = -1;
+	return p;
+}
+
+bool Navigation::_solve(Polygon *begin_poly, Polygon *end_poly, const Vector3 &p_end_point) {
+
+	//expects prev_edge and heap_index of all polygons to be reset to -1
+
+	open_count = 0;
+
+	for (int i = 0; i < begin_poly->edges.size(); i++) {
+
+		Polygon *C = begin_poly->edges[i].C;
+
+		if (!C || C == begin_poly)
+			continue;
+
+		float distance = begin_poly->center.distance_to(C->center);
+
+		if (C->prev_edge != -1 && C->distance <= distance)
+			continue; //also reachable through another edge
+
+		C->prev_edge = begin_poly->edges[i].C_edge;
+		C->distance = distance;
+		C->cost = distance + C->center.distance_to(p_end_point);
+
+		if (C->heap_index == -1)
+			_heap_push(C);
+		else
+			_heap_sift_up(C->heap_index);
+	}
+
+	bool found_route = false;
+
+	while (open_count) {
+
+		Polygon *p = _heap_pop();
+
+		if (p == end_poly) {
+			found_route = true;
+			break;
+		}
+
+		//open the neighbours for search
+
+		for (int i = 0; i < p->edges.size(); i++) {
+
+			Polygon::Edge &e = p->edges[i];
+
+			if (!e.C || e.C == begin_poly)
+				continue;
+
+			if (e.C->prev_edge != -1 && e.C->heap_index == -1)
+				continue; //already closed
+
+			float distance = p->center.distance_to(e.C->center) + p->distance;
+
+			if (e.C->prev_edge != -1) {
+				//still open, can we win the cost?
+
+				if (e.C->distance > distance) {
+
+					e.C->prev_edge = e.C_edge;
+					e.C->distance = distance;
+					e.C->cost = distance + e.C->center.distance_to(p_end_point);
+					_heap_sift_up(e.C->heap_index);
+				}
+			} else {
+				//add to open neighbours
+
+				e.C->prev_edge = e.C_edge;
+				e.C->distance = distance;
+				e.C->cost = distance + e.C->center.distance_to(p_end_point);
+				_heap_push(e.C);
+			}
+		}
+	}
+
+	//leftovers are stale for the next search
+	while (open_count) {
+		_heap_pop();
+	}
+
+	return found_route;
+}
+
+void Navigation::_path_cache_store(Polygon *begin_poly, Polygon *end_poly, bool p_found) {
+
+	PathCorridor corridor;
+	corridor.key.from = begin_poly;
+	corridor.key.to = end_poly;
+	corridor.found = p_found;
+
+	if (p_found) {
+
+		Polygon *p = end_poly;
+		while (p != begin_poly) {
+			PathCorridor::Step step;
+			step.polygon = p;
+			step.prev_edge = p->prev_edge;
+			corridor.steps.push_back(step);
+			p = p->edges[p->prev_edge].C;
+		}
+	}
+
+	if (path_cache.size() >= PATH_CACHE_MAX) {
+		//evict the least recently used
+		path_cache_map.erase(path_cache.back()->get().key);
+		path_cache.pop_back();
+	}
+
+	path_cache_map[corridor.key] = path_cache.push_front(corridor);
+}
+
+void Navigation::_path_cache_clear() {
+
+	path_cache.clear();
+	path_cache_map.clear();
+}
+
 Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector3 &p_end, bool p_optimize) {
 
 	Polygon *begin_poly = NULL;
@@ -308,6 +487,7 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 			}
 
 			p.prev_edge = -1;
+			p.heap_index = -1;
 		}
 	}
 
@@ -329,87 +509,27 @@ Vector<Vector3> Navigation::get_simple_path(const Vector3 &p_start, const Vector
 
 	bool found_route = false;
 
-	List<Polygon *> open_list;
-
-	for (int i = 0; i < begin_poly->edges.size(); i++) {
-
-		if (begin_poly->edges[i].C) {
-
-			begin_poly->edges[i].C->prev_edge = begin_poly->edges[i].C_edge;
-			begin_poly->edges[i].C->distance = begin_poly->center.distance_to(begin_poly->edges[i].C->center);
-			open_list.push_back(begin_poly->edges[i].C);
-
-			if (begin_poly->edges[i].C == end_poly) {
-				found_route = true;
-			}
-		}
-	}
-
-	while (!found_route) {
-
-		if (open_list.size() == 0) {
-			//	print_line("NOU OPEN LIST");
-			break;
-		}
-		//check open list
-
-		List<Polygon *>::Element *least_cost_poly = NULL;
-		float least_cost = 1e30;
-
-		//this could be faster (cache previous results)
-		for (List<Polygon *>::Element *E = open_list.front(); E; E = E->next()) {
-
-			Polygon *p = E->get();
+	PathKey key;
+	key.from = begin_poly;
+	key.to = end_poly;
 
-			float cost = p->distance;
-			cost += p->center.distance_to(end_point);
+	Map<PathKey, List<PathCorridor>::Element *>::Element *C = path_cache_map.find(key);
 
-			if (cost < least_cost) {
+	if (C) {
+		//same polygons were searched recently, just restore the corridor
+		path_cache.move_to_front(C->get());
+		const PathCorridor &corridor = C->get()->get();
 
-				least_cost_poly = E;
-				least_cost = cost;
-			}
+		for (int i = 0; i < corridor.steps.size(); i++) {
+			corridor.steps[i].polygon->prev_edge = corridor.steps[i].prev_edge;
 		}
 
-		Polygon *p = least_cost_poly->get();
-		//open the neighbours for search
-
-		for (int i = 0; i < p->edges.size(); i++) {
-
-			Polygon::Edge &e = p->edges[i];
-
-			if (!e.C)
-				continue;
-
-			float distance = p->center.distance_to(e.C->center) + p->distance;
-
-			if (e.C->prev_edge != -1) {
-				//oh this was visited already, can we win the cost?
-
-				if (e.C->distance > distance) {
+		found_route = corridor.found;
 
-					e.C->prev_edge = e.C_edge;
-					e.C->distance = distance;
-				}
-			} else {
-				//add to open neighbours
-
-				e.C->prev_edge = e.C_edge;
-				e.C->distance = distance;
-				open_list.push_back(e.C);
-
-				if (e.C == end_poly) {
-					//oh my reached end! stop algorithm
-					found_route = true;
-					break;
-				}
-			}
-		}
-
-		if (found_route)
-			break;
+	} else {
 
-		open_list.erase(least_cost_poly);
+		found_route = _solve(begin_poly, end_poly, end_point);
+		_path_cache_store(begin_poly, end_poly, found_route);
 	}
 
 	if (found_route) {
@@ -710,5 +830,6 @@ Navigation::Navigation() {
 	ERR_FAIL_COND(sizeof(Point) != 8);
 	cell_size = 0.01; //one centimeter
 	last_id = 1;
+	open_count = 0;
 	up = Vector3(0, 1, 0);
 }
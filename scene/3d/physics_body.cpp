@@ -675,13 +675,23 @@ void RigidBody::apply_impulse(const Vector3 &p_pos, const Vector3 &p_impulse) {
 
 void RigidBody::set_use_continuous_collision_detection(bool p_enable) {
 
-	ccd = p_enable;
-	PhysicsServer::get_singleton()->body_set_enable_continuous_collision_detection(get_rid(), p_enable);
+	set_continuous_collision_detection_mode(p_enable ? CCD_MODE_CAST_RAY : CCD_MODE_DISABLED);
 }
 
 bool RigidBody::is_using_continuous_collision_detection() const {
 
-	return ccd;
+	return ccd_mode != CCD_MODE_DISABLED;
+}
+
+void RigidBody::set_continuous_collision_detection_mode(CCDMode p_mode) {
+
+	ccd_mode = p_mode;
+	PhysicsServer::get_singleton()->body_set_continuous_collision_detection_mode(get_rid(), PhysicsServer::CCDMode(p_mode));
+}
+
+RigidBody::CCDMode RigidBody::get_continuous_collision_detection_mode() const {
+
+	return ccd_mode;
 }
 
 void RigidBody::set_contact_monitor(bool p_enabled) {
@@ -789,6 +799,9 @@ void RigidBody::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("set_use_continuous_collision_detection", "enable"), &RigidBody::set_use_continuous_collision_detection);
 	ObjectTypeDB::bind_method(_MD("is_using_continuous_collision_detection"), &RigidBody::is_using_continuous_collision_detection);
 
+	ObjectTypeDB::bind_method(_MD("set_continuous_collision_detection_mode", "mode"), &RigidBody::set_continuous_collision_detection_mode);
+	ObjectTypeDB::bind_method(_MD("get_continuous_collision_detection_mode"), &RigidBody::get_continuous_collision_detection_mode);
+
 	ObjectTypeDB::bind_method(_MD("set_axis_velocity", "axis_velocity"), &RigidBody::set_axis_velocity);
 	ObjectTypeDB::bind_method(_MD("apply_impulse", "pos", "impulse"), &RigidBody::apply_impulse);
 
@@ -816,7 +829,7 @@ void RigidBody::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "bounce", PROPERTY_HINT_RANGE, "0,1,0.01"), _SCS("set_bounce"), _SCS("get_bounce"));
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "gravity_scale", PROPERTY_HINT_RANGE, "-128,128,0.01"), _SCS("set_gravity_scale"), _SCS("get_gravity_scale"));
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "custom_integrator"), _SCS("set_use_custom_integrator"), _SCS("is_using_custom_integrator"));
-	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "continuous_cd"), _SCS("set_use_continuous_collision_detection"), _SCS("is_using_continuous_collision_detection"));
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "continuous_cd", PROPERTY_HINT_ENUM, "Disabled,Cast Ray,Cast Shape"), _SCS("set_continuous_collision_detection_mode"), _SCS("get_continuous_collision_detection_mode"));
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "contacts_reported"), _SCS("set_max_contacts_reported"), _SCS("get_max_contacts_reported"));
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "contact_monitor"), _SCS("set_contact_monitor"), _SCS("is_contact_monitor_enabled"));
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sleeping"), _SCS("set_sleeping"), _SCS("is_sleeping"));
@@ -837,6 +850,10 @@ void RigidBody::_bind_methods() {
 	BIND_CONSTANT(MODE_KINEMATIC);
 	BIND_CONSTANT(MODE_RIGID);
 	BIND_CONSTANT(MODE_CHARACTER);
+
+	BIND_CONSTANT(CCD_MODE_DISABLED);
+	BIND_CONSTANT(CCD_MODE_CAST_RAY);
+	BIND_CONSTANT(CCD_MODE_CAST_SHAPE);
 }
 
 RigidBody::RigidBody()
@@ -856,7 +873,7 @@ RigidBody::RigidBody()
 
 	//angular_velocity=0;
 	sleeping = false;
-	ccd = false;
+	ccd_mode = CCD_MODE_DISABLED;
 
 	custom_integrator = false;
 	contact_monitor = NULL;
@@ -120,6 +120,12 @@ public:
 		AXIS_LOCK_Z,
 	};
 
+	enum CCDMode {
+		CCD_MODE_DISABLED,
+		CCD_MODE_CAST_RAY,
+		CCD_MODE_CAST_SHAPE,
+	};
+
 private:
 	bool can_sleep;
 	PhysicsDirectBodyState *state;
@@ -136,7 +142,7 @@ private:
 	real_t angular_damp;
 
 	bool sleeping;
-	bool ccd;
+	CCDMode ccd_mode;
 
 	AxisLock axis_lock;
 
@@ -244,6 +250,9 @@ public:
 	void set_use_continuous_collision_detection(bool p_enable);
 	bool is_using_continuous_collision_detection() const;
 
+	void set_continuous_collision_detection_mode(CCDMode p_mode);
+	CCDMode get_continuous_collision_detection_mode() const;
+
 	void set_axis_lock(AxisLock p_lock);
 	AxisLock get_axis_lock() const;
 
@@ -257,6 +266,7 @@ public:
 
 VARIANT_ENUM_CAST(RigidBody::Mode);
 VARIANT_ENUM_CAST(RigidBody::AxisLock);
+VARIANT_ENUM_CAST(RigidBody::CCDMode);
 
 class KinematicBody : public PhysicsBody {
 
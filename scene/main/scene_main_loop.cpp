@@ -34,6 +34,7 @@
 #include "node.h"
 #include "os/keyboard.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "print_string.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -138,6 +139,8 @@ void SceneTree::_update_group_order(Group &g) {
 
 void SceneTree::call_group(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
 
+	group_call_count++;
+
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	if (!E)
 		return;
@@ -217,6 +220,8 @@ void SceneTree::call_group(uint32_t p_call_flags, const StringName &p_group, con
 
 void SceneTree::notify_group(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
 
+	group_call_count++;
+
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	if (!E)
 		return;
@@ -266,6 +271,8 @@ void SceneTree::notify_group(uint32_t p_call_flags, const StringName &p_group, i
 
 void SceneTree::set_group(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
 
+	group_call_count++;
+
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	if (!E)
 		return;
@@ -467,6 +474,8 @@ void SceneTree::init() {
 
 bool SceneTree::iteration(float p_time) {
 
+	TRACE_ZONE("SceneTree::iteration");
+
 	root_lock++;
 
 	current_frame++;
@@ -491,6 +500,8 @@ bool SceneTree::iteration(float p_time) {
 
 bool SceneTree::idle(float p_time) {
 
+	TRACE_ZONE("SceneTree::idle");
+
 	//	print_line("ram: "+itos(OS::get_singleton()->get_static_memory_usage())+" sram: "+itos(OS::get_singleton()->get_dynamic_memory_usage()));
 	//	print_line("node count: "+itos(get_node_count()));
 	//	print_line("TEXTURE RAM: "+itos(VS::get_singleton()->get_render_info(VS::INFO_TEXTURE_MEM_USED)));
@@ -998,6 +1009,13 @@ int SceneTree::get_node_count() const {
 	return node_count;
 }
 
+int SceneTree::read_group_call_count() {
+
+	int count = group_call_count;
+	group_call_count = 0;
+	return count;
+}
+
 void SceneTree::_update_root_rect() {
 
 	if (stretch_mode == STRETCH_MODE_DISABLED) {
@@ -1640,6 +1658,7 @@ SceneTree::SceneTree() {
 	call_lock = 0;
 	root_lock = 0;
 	node_count = 0;
+	group_call_count = 0;
 
 	//create with mainloop
 
@@ -100,6 +100,7 @@ private:
 
 	int64_t current_frame;
 	int node_count;
+	uint32_t group_call_count;
 
 #ifdef TOOLS_ENABLED
 	Node *edited_scene_root;
@@ -304,6 +305,7 @@ public:
 	int64_t get_frame() const;
 
 	int get_node_count() const;
+	int read_group_call_count(); //group calls since the previous read
 
 	void queue_delete(Object *p_object);
 
@@ -29,6 +29,7 @@
 #include "audio_server_sw.h"
 #include "globals.h"
 #include "os/os.h"
+#include "os/trace.h"
 
 struct _AudioDriverLock {
 
@@ -77,6 +78,7 @@ void AudioServerSW::_mixer_callback(void *p_udata) {
 
 void AudioServerSW::driver_process_chunk(int p_frames, int32_t *p_buffer) {
 
+	uint64_t mix_begin = OS::get_singleton()->get_ticks_usec();
 	int samples = p_frames * internal_buffer_channels;
 
 	for (int i = 0; i < samples; i++) {
@@ -318,10 +320,18 @@ void AudioServerSW::driver_process_chunk(int p_frames, int32_t *p_buffer) {
 
 	if (peak > max_peak)
 		max_peak = peak;
+
+	uint64_t mix_time = OS::get_singleton()->get_ticks_usec() - mix_begin;
+	if (mix_time > max_chunk_mix_time)
+		max_chunk_mix_time = mix_time;
 }
 
 void AudioServerSW::driver_process(int p_frames, int32_t *p_buffer) {
 
+	TRACE_ZONE("AudioServer::mix");
+	if (Trace::is_enabled())
+		Trace::set_thread_name("audio");
+
 	_output_delay = p_frames / double(AudioDriverSW::get_singleton()->get_mix_rate());
 	//process in chunks to make sure to never process more than INTERNAL_BUFFER_SIZE
 	int todo = p_frames;
@@ -882,6 +892,13 @@ uint32_t AudioServerSW::read_output_peak() const {
 	return val;
 }
 
+uint64_t AudioServerSW::read_chunk_mix_time() const {
+
+	uint64_t val = max_chunk_mix_time;
+	const_cast<AudioServerSW *>(this)->max_chunk_mix_time = 0;
+	return val;
+}
+
 AudioServerSW::AudioServerSW(SampleManagerSW *p_sample_manager) {
 
 	sample_manager = p_sample_manager;
@@ -898,6 +915,7 @@ AudioServerSW::AudioServerSW(SampleManagerSW *p_sample_manager) {
 	fx_volume_scale = GLOBAL_DEF("audio/fx_volume_scale", 1.0);
 	event_voice_volume_scale = GLOBAL_DEF("audio/event_voice_volume_scale", 0.5);
 	max_peak = 0;
+	max_chunk_mix_time = 0;
 }
 
 AudioServerSW::~AudioServerSW() {
@@ -94,6 +94,7 @@ class AudioServerSW : public AudioServer {
 	float event_voice_volume_scale;
 	float peak_left, peak_right;
 	uint32_t max_peak;
+	uint64_t max_chunk_mix_time;
 
 	double _output_delay;
 
@@ -206,6 +207,7 @@ public:
 	virtual float get_event_voice_global_volume_scale() const;
 
 	virtual uint32_t read_output_peak() const;
+	virtual uint64_t read_chunk_mix_time() const;
 
 	virtual double get_mix_time() const; //useful for video -> audio sync
 
@@ -266,6 +266,7 @@ public:
 	virtual float get_event_voice_global_volume_scale() const = 0;
 
 	virtual uint32_t read_output_peak() const = 0;
+	virtual uint64_t read_chunk_mix_time() const { return 0; } //slowest chunk mixed since the previous read, in usec
 
 	static AudioServer *get_singleton();
 
@@ -28,6 +28,7 @@
 /*************************************************************************/
 #include "body_pair_sw.h"
 #include "collision_solver_sw.h"
+#include "island_solver_sw.h"
 #include "os/os.h"
 #include "space_sw.h"
 
@@ -205,6 +206,83 @@ bool BodyPairSW::_test_ccd(float p_step, BodySW *p_A, int p_shape_A, const Trans
 	return true;
 }
 
+bool BodyPairSW::_test_ccd_shape(float p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
+
+	//cast A relative to B, so bodies moving against each other are caught too
+	bool dynamic_B = p_B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC;
+	Vector3 velocity_B = p_B->get_mode() == PhysicsServer::BODY_MODE_STATIC ? Vector3() : p_B->get_linear_velocity();
+
+	Vector3 motion = (p_A->get_linear_velocity() - velocity_B) * p_step;
+	real_t mlen = motion.length();
+	if (mlen < CMP_EPSILON)
+		return false;
+
+	Vector3 mnormal = motion / mlen;
+
+	ShapeSW *shape_A_ptr = p_A->get_shape(p_shape_A);
+	ShapeSW *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	real_t min, max;
+	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
+	if (mlen < (max - min) * 0.3) { //slow enough for regular contacts to catch it
+		return false;
+	}
+
+	Matrix3 xform_inv_basis = p_xform_A.affine_inverse().basis;
+
+	MotionShapeSW mshape;
+	mshape.shape = shape_A_ptr;
+	mshape.motion = xform_inv_basis.xform(motion);
+
+	Vector3 point_A, point_B;
+	Vector3 sep_axis = mnormal;
+
+	if (CollisionSolverSW::solve_distance(&mshape, p_xform_A, shape_B_ptr, p_xform_B, point_A, point_B, AABB(), &sep_axis)) {
+		return false; //nothing in the way for the whole step
+	}
+
+	//find the time of impact
+	real_t low = 0;
+	real_t hi = 1;
+	Vector3 normal = mnormal;
+
+	for (int i = 0; i < 8; i++) {
+
+		real_t ofs = (low + hi) * 0.5;
+
+		Vector3 sep = mnormal;
+		mshape.motion = xform_inv_basis.xform(motion * ofs);
+
+		if (CollisionSolverSW::solve_distance(&mshape, p_xform_A, shape_B_ptr, p_xform_B, point_A, point_B, AABB(), &sep)) {
+			low = ofs;
+			if (point_A.distance_squared_to(point_B) > CMP_EPSILON2) {
+				normal = (point_B - point_A).normalized();
+			}
+		} else {
+			hi = ofs;
+		}
+	}
+
+	//both stop right after they meet, keeping their velocities, so contacts are found and solved next step
+	p_A->clamp_ccd_motion(hi);
+
+	if (dynamic_B && p_B->is_active()) {
+
+		p_B->clamp_ccd_motion(hi);
+
+		//two fast bodies overlap deeply after a single step, remove the approaching velocity at the time of impact instead
+		real_t inv_mass = p_A->get_inv_mass() + p_B->get_inv_mass();
+		real_t approach = (p_A->get_linear_velocity() - p_B->get_linear_velocity()).dot(normal);
+		if (approach > 0 && inv_mass > 0) {
+			Vector3 j = normal * (approach / inv_mass);
+			p_A->set_linear_velocity(p_A->get_linear_velocity() - j * p_A->get_inv_mass());
+			p_B->set_linear_velocity(p_B->get_linear_velocity() + j * p_B->get_inv_mass());
+		}
+	}
+
+	return true;
+}
+
 bool BodyPairSW::setup(float p_step) {
 
 	//cannot collide
@@ -233,13 +311,19 @@ bool BodyPairSW::setup(float p_step) {
 
 	if (!collided) {
 
-		//test ccd (currently just a raycast)
+		//test ccd, a raycast against static and kinematic bodies or a shape cast against anything
 
-		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
+		if (A->get_continuous_collision_detection_mode() == PhysicsServer::CCD_MODE_CAST_SHAPE && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC) {
+			_test_ccd_shape(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
+		} else if (B->get_continuous_collision_detection_mode() == PhysicsServer::CCD_MODE_CAST_SHAPE && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC) {
+			_test_ccd_shape(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
+		}
+
+		if (A->get_continuous_collision_detection_mode() == PhysicsServer::CCD_MODE_CAST_RAY && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
 			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
 		}
 
-		if (B->is_continuous_collision_detection_enabled() && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
+		if (B->get_continuous_collision_detection_mode() == PhysicsServer::CCD_MODE_CAST_RAY && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
 			_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
 		}
 
@@ -282,6 +366,7 @@ bool BodyPairSW::setup(float p_step) {
 #ifdef DEBUG_ENABLED
 
 		if (space->is_debugging_contacts()) {
+			MutexLock lock(space->get_step_mutex());
 			space->add_debug_contact(global_A + offset_A);
 			space->add_debug_contact(global_B + offset_A);
 		}
@@ -303,11 +388,13 @@ bool BodyPairSW::setup(float p_step) {
 #endif
 
 		if (A->can_report_contacts()) {
+			MutexLock lock(space->get_step_mutex()); //static bodies can be shared with other islands
 			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
 			A->add_contact(global_A, -c.normal, depth, shape_A, global_B, shape_B, B->get_instance_id(), B->get_self(), crA);
 		}
 
 		if (B->can_report_contacts()) {
+			MutexLock lock(space->get_step_mutex());
 			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
 			B->add_contact(global_B, c.normal, depth, shape_B, global_A, shape_A, A->get_instance_id(), A->get_self(), crB);
 		}
@@ -466,6 +553,67 @@ void BodyPairSW::solve(float p_step) {
 	}
 }
 
+bool BodyPairSW::pack(IslandSolverSW *p_solver) {
+
+	if (!collided)
+		return true;
+
+	int active_count = 0;
+	for (int i = 0; i < contact_count; i++) {
+		if (contacts[i].active)
+			active_count++;
+	}
+
+	if (active_count == 0)
+		return true;
+
+	int body_A = p_solver->add_body(A);
+	int body_B = p_solver->add_body(B);
+	real_t friction = A->get_friction() * B->get_friction();
+
+	IslandSolverSW::Contact *sc = p_solver->add_contacts(active_count);
+
+	for (int i = 0; i < contact_count; i++) {
+
+		const Contact &c = contacts[i];
+		if (!c.active)
+			continue;
+
+		sc->body_A = body_A;
+		sc->body_B = body_B;
+		sc->normal = c.normal;
+		sc->rA = c.rA;
+		sc->rB = c.rB;
+		sc->mass_normal = c.mass_normal;
+		sc->bias = c.bias;
+		sc->bounce = c.bounce;
+		sc->friction = friction;
+		sc->acc_normal_impulse = c.acc_normal_impulse;
+		sc->acc_tangent_impulse = c.acc_tangent_impulse;
+		sc->acc_bias_impulse = c.acc_bias_impulse;
+		sc->active = true;
+		sc++;
+	}
+
+	return true;
+}
+
+void BodyPairSW::unpack(const IslandSolverSW *p_solver, int p_from) {
+
+	for (int i = 0; i < contact_count; i++) {
+
+		Contact &c = contacts[i];
+		if (!c.active)
+			continue;
+
+		const IslandSolverSW::Contact &sc = p_solver->get_contact(p_from++);
+		c.acc_normal_impulse = sc.acc_normal_impulse;
+		c.acc_tangent_impulse = sc.acc_tangent_impulse;
+		c.acc_bias_impulse = sc.acc_bias_impulse;
+		c.active = sc.active;
+	}
+}
+
 BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B)
 	: ConstraintSW(_arr, 2) {
 
@@ -81,6 +81,7 @@ class BodyPairSW : public ConstraintSW {
 
 	void validate_contacts();
 	bool _test_ccd(float p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
+	bool _test_ccd_shape(float p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
 
 	SpaceSW *space;
 
@@ -88,6 +89,9 @@ public:
 	bool setup(float p_step);
 	void solve(float p_step);
 
+	bool pack(IslandSolverSW *p_solver);
+	void unpack(const IslandSolverSW *p_solver, int p_from);
+
 	BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B);
 	~BodyPairSW();
 };
@@ -108,6 +108,7 @@ void BodySW::set_active(bool p_active) {
 		return;
 
 	active = p_active;
+	_set_sleeping(!p_active);
 	if (!p_active) {
 		if (get_space())
 			get_space()->body_remove_from_active_list(&active_list);
@@ -119,17 +120,6 @@ void BodySW::set_active(bool p_active) {
 
 		//still_time=0;
 	}
-	/*
-	if (!space)
-		return;
-
-	for(int i=0;i<get_shape_count();i++) {
-		Shape &s=shapes[i];
-		if (s.bpid>0) {
-			get_space()->get_broadphase()->set_active(s.bpid,active);
-		}
-	}
-*/
 }
 
 void BodySW::set_param(PhysicsServer::BodyParameter p_param, float p_value) {
@@ -485,7 +475,7 @@ void BodySW::integrate_forces(real_t p_step) {
 			angular_velocity += _inv_inertia_tensor.xform(torque) * p_step;
 		}
 
-		if (continuous_cd) {
+		if (continuous_cd_mode != PhysicsServer::CCD_MODE_DISABLED) {
 			motion = linear_velocity * p_step;
 			do_motion = true;
 		}
@@ -501,7 +491,8 @@ void BodySW::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		shapes_pending = true;
+		shapes_pending_motion = motion;
 	}
 
 	def_area = NULL; // clear the area, so it is set in the next frame
@@ -561,10 +552,14 @@ void BodySW::integrate_velocities(real_t p_step) {
 		}
 	}*/
 
-	transform.origin += total_linear_velocity * p_step;
+	//velocity is kept when the motion is shortened, so the impact is solved by regular contacts next step
+	transform.origin += total_linear_velocity * (p_step * ccd_motion_scale);
+	ccd_motion_scale = 1.0;
 
-	_set_transform(transform);
+	_set_transform(transform, false);
 	_set_inv_transform(get_transform().inverse());
+	shapes_pending = true;
+	shapes_pending_motion = Vector3();
 
 	_update_inertia_tensor();
 
@@ -610,7 +605,7 @@ void BodySW::simulate_motion(const Transform& p_xform,real_t p_step) {
 
 void BodySW::wakeup_neighbours() {
 
-	for (Map<ConstraintSW *, int>::Element *E = constraint_map.front(); E; E = E->next()) {
+	for (Map<ConstraintSW *, int, ConstraintOrderSW>::Element *E = constraint_map.front(); E; E = E->next()) {
 
 		const ConstraintSW *c = E->key();
 		BodySW **n = c->get_body_ptr();
@@ -691,6 +686,13 @@ void BodySW::set_force_integration_callback(ObjectID p_id, const StringName &p_m
 	}
 }
 
+uint64_t ConstraintSW::creation_count = 0;
+
+bool ConstraintOrderSW::operator()(const ConstraintSW *p_a, const ConstraintSW *p_b) const {
+
+	return p_a->get_creation_id() < p_b->get_creation_id();
+}
+
 BodySW::BodySW()
 	: CollisionObjectSW(TYPE_BODY), active_list(this), inertia_update_list(this), direct_state_query_list(this) {
 
@@ -707,8 +709,10 @@ BodySW::BodySW()
 	island_step = 0;
 	island_next = NULL;
 	island_list_next = NULL;
+	solver_index = -1;
 	first_time_kinematic = false;
 	first_integration = false;
+	shapes_pending = false;
 	_set_static(false);
 
 	contact_count = 0;
@@ -716,9 +720,12 @@ BodySW::BodySW()
 
 	area_angular_damp = 0;
 	area_linear_damp = 0;
+	linear_damp = -1;
+	angular_damp = -1;
 
 	still_time = 0;
-	continuous_cd = false;
+	continuous_cd_mode = PhysicsServer::CCD_MODE_DISABLED;
+	ccd_motion_scale = 1.0;
 	can_sleep = false;
 	fi_callback = NULL;
 	axis_lock = PhysicsServer::BODY_AXIS_LOCK_DISABLED;
@@ -35,6 +35,11 @@
 
 class ConstraintSW;
 
+//constraints are kept in creation order rather than by address, so islands are solved the same way on every run
+struct ConstraintOrderSW {
+	bool operator()(const ConstraintSW *p_a, const ConstraintSW *p_b) const;
+};
+
 class BodySW : public CollisionObjectSW {
 
 	PhysicsServer::BodyMode mode;
@@ -77,15 +82,18 @@ class BodySW : public CollisionObjectSW {
 	bool active;
 
 	bool first_integration;
+	bool shapes_pending; //moved by the step after integrating, so it can time broad phase moves apart
+	Vector3 shapes_pending_motion;
 
-	bool continuous_cd;
+	PhysicsServer::CCDMode continuous_cd_mode;
+	real_t ccd_motion_scale; //fraction of the step the body moves, shortened by shape cast ccd
 	bool can_sleep;
 	bool first_time_kinematic;
 	void _update_inertia();
 	virtual void _shapes_changed();
 	Transform new_transform;
 
-	Map<ConstraintSW *, int> constraint_map;
+	Map<ConstraintSW *, int, ConstraintOrderSW> constraint_map;
 
 	struct AreaCMP {
 
@@ -130,6 +138,7 @@ class BodySW : public CollisionObjectSW {
 	uint64_t island_step;
 	BodySW *island_next;
 	BodySW *island_list_next;
+	int solver_index; //slot in the packed island solver while it runs, -1 otherwise
 
 	_FORCE_INLINE_ void _compute_area_gravity_and_dampenings(const AreaSW *p_area);
 
@@ -182,9 +191,12 @@ public:
 	_FORCE_INLINE_ BodySW *get_island_list_next() const { return island_list_next; }
 	_FORCE_INLINE_ void set_island_list_next(BodySW *p_next) { island_list_next = p_next; }
 
+	_FORCE_INLINE_ int get_solver_index() const { return solver_index; }
+	_FORCE_INLINE_ void set_solver_index(int p_index) { solver_index = p_index; }
+
 	_FORCE_INLINE_ void add_constraint(ConstraintSW *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(ConstraintSW *p_constraint) { constraint_map.erase(p_constraint); }
-	const Map<ConstraintSW *, int> &get_constraint_map() const { return constraint_map; }
+	const Map<ConstraintSW *, int, ConstraintOrderSW> &get_constraint_map() const { return constraint_map; }
 
 	_FORCE_INLINE_ void set_omit_force_integration(bool p_omit_force_integration) { omit_force_integration = p_omit_force_integration; }
 	_FORCE_INLINE_ bool get_omit_force_integration() const { return omit_force_integration; }
@@ -195,23 +207,36 @@ public:
 	_FORCE_INLINE_ void set_angular_velocity(const Vector3 &p_velocity) { angular_velocity = p_velocity; }
 	_FORCE_INLINE_ Vector3 get_angular_velocity() const { return angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_impulse(const Vector3 &p_pos, const Vector3 &p_j) {
 
+		//static and kinematic bodies don't respond to impulses, and joints in islands solved in parallel can share them, so don't write them
+		if (mode <= PhysicsServer::BODY_MODE_KINEMATIC)
+			return;
+
 		linear_velocity += p_j * _inv_mass;
 		angular_velocity += _inv_inertia_tensor.xform(p_pos.cross(p_j));
 	}
 
 	_FORCE_INLINE_ void apply_bias_impulse(const Vector3 &p_pos, const Vector3 &p_j) {
 
+		if (mode <= PhysicsServer::BODY_MODE_KINEMATIC)
+			return;
+
 		biased_linear_velocity += p_j * _inv_mass;
 		biased_angular_velocity += _inv_inertia_tensor.xform(p_pos.cross(p_j));
 	}
 
 	_FORCE_INLINE_ void apply_torque_impulse(const Vector3 &p_j) {
 
+		if (mode <= PhysicsServer::BODY_MODE_KINEMATIC)
+			return;
+
 		angular_velocity += _inv_inertia_tensor.xform(p_j);
 	}
 
@@ -245,8 +270,13 @@ public:
 	void set_applied_torque(const Vector3 &p_torque) { applied_torque = p_torque; }
 	Vector3 get_applied_torque() const { return applied_torque; }
 
-	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
-	_FORCE_INLINE_ bool is_continuous_collision_detection_enabled() const { return continuous_cd; }
+	_FORCE_INLINE_ void set_continuous_collision_detection_mode(PhysicsServer::CCDMode p_mode) { continuous_cd_mode = p_mode; }
+	_FORCE_INLINE_ PhysicsServer::CCDMode get_continuous_collision_detection_mode() const { return continuous_cd_mode; }
+
+	_FORCE_INLINE_ void clamp_ccd_motion(real_t p_scale) {
+		if (p_scale < ccd_motion_scale)
+			ccd_motion_scale = p_scale;
+	}
 
 	void set_space(SpaceSW *p_space);
 
@@ -265,6 +295,17 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	_FORCE_INLINE_ void update_pending_shapes() {
+
+		if (!shapes_pending)
+			return;
+		shapes_pending = false;
+		if (shapes_pending_motion == Vector3())
+			_update_shapes();
+		else
+			_update_shapes_with_motion(shapes_pending_motion);
+	}
+
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 
 		return linear_velocity + angular_velocity.cross(rel_pos);
@@ -0,0 +1,192 @@
+/*************************************************************************/
+/*  broad_phase_bvh.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef BROAD_PHASE_BVH_H
+#define BROAD_PHASE_BVH_H
+
+#include "broad_phase_sw.h"
+#include "vector.h"
+
+/**
+	Dynamic AABB tree broadphase.
+
+	Leaves store a fattened AABB, so objects that move a little don't touch the tree at all,
+	and the ones that leave it get reinserted and rebalanced locally. Moves are only recorded,
+	pairs for all moved objects are found in update() and kept in an open addressing hash table.
+
+	Static objects, sleeping objects and active objects are kept in separate trees sharing the
+	same node pool. Active objects are the only ones reinserted every step, so the tree they
+	live in stays small regardless of level size, and moved static objects never have to visit
+	the static tree to find their pairs.
+*/
+
+class BroadPhaseBVH : public BroadPhaseSW {
+
+	enum Tree {
+		TREE_STATIC,
+		TREE_SLEEPING,
+		TREE_DYNAMIC,
+		TREE_MAX
+	};
+
+	struct Node {
+
+		AABB aabb;
+		int parent;
+		int children[2];
+		int height; //0 for leaves
+		ID element; //leaves only
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == -1; }
+	};
+
+	struct Element {
+
+		CollisionObjectSW *owner; //NULL if free
+		bool _static;
+		bool active;
+		bool moved;
+		AABB aabb;
+		int subindex;
+		int node;
+		int tree; //the one node is in, if any
+		Vector<ID> paired;
+	};
+
+	struct PairKey {
+
+		union {
+			struct {
+				ID a;
+				ID b;
+			};
+			uint64_t key;
+		};
+
+		PairKey() { key = 0; }
+		PairKey(ID p_a, ID p_b) {
+			if (p_a > p_b) {
+				a = p_b;
+				b = p_a;
+			} else {
+				a = p_a;
+				b = p_b;
+			}
+		}
+	};
+
+	struct Pair {
+
+		uint64_t key; //0 if empty
+		void *ud;
+	};
+
+	Vector<Node> nodes;
+	int root[TREE_MAX];
+	int free_node;
+
+	Vector<Element> elements;
+	Vector<ID> free_elements;
+	Vector<ID> move_buffer;
+
+	Pair *pair_table;
+	uint32_t pair_table_size;
+	uint32_t pair_count;
+
+	real_t margin;
+
+	PairCallback pair_callback;
+	void *pair_userdata;
+	UnpairCallback unpair_callback;
+	void *unpair_userdata;
+
+	_FORCE_INLINE_ static real_t _cost(const AABB &p_aabb) {
+		//half the surface area, good enough to compare
+		return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
+	}
+
+	_FORCE_INLINE_ static uint32_t _hash_key(uint64_t p_key) {
+		uint64_t k = p_key;
+		k = (~k) + (k << 18);
+		k = k ^ (k >> 31);
+		k = k * 21;
+		k = k ^ (k >> 11);
+		k = k + (k << 6);
+		k = k ^ (k >> 22);
+		return k;
+	}
+
+	_FORCE_INLINE_ static int _get_tree(const Element &p_element) {
+		if (p_element._static)
+			return TREE_STATIC;
+		return p_element.active ? TREE_DYNAMIC : TREE_SLEEPING;
+	}
+
+	int _alloc_node();
+	void _free_node(int p_node);
+	void _insert_leaf(int p_leaf, int p_tree);
+	void _remove_leaf(int p_leaf, int p_tree);
+	int _balance(int p_node, int p_tree);
+	void _fix_upwards(int p_node, int p_tree);
+	void _update_tree(ID p_id);
+
+	int _pair_find(uint64_t p_key) const;
+	void _pair_insert(uint64_t p_key, void *p_ud);
+	void _pair_erase(int p_index);
+	void _pair_table_resize(uint32_t p_size);
+
+	void _pair(ID p_a, ID p_b);
+	void _unpair(ID p_a, ID p_b);
+	void _mark_moved(ID p_id);
+
+public:
+	// 0 is an invalid ID
+	virtual ID create(CollisionObjectSW *p_object_, int p_subindex = 0);
+	virtual void move(ID p_id, const AABB &p_aabb);
+	virtual void set_static(ID p_id, bool p_static);
+	virtual void set_active(ID p_id, bool p_active);
+	virtual void remove(ID p_id);
+
+	virtual CollisionObjectSW *get_object(ID p_id) const;
+	virtual bool is_static(ID p_id) const;
+	virtual int get_subindex(ID p_id) const;
+
+	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, CollisionObjectSW **p_results, int p_max_results, int *p_result_indices = NULL);
+	virtual int cull_aabb(const AABB &p_aabb, CollisionObjectSW **p_results, int p_max_results, int *p_result_indices = NULL);
+
+	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata);
+	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata);
+
+	virtual void update();
+
+	static BroadPhaseSW *_create();
+	BroadPhaseBVH();
+	~BroadPhaseBVH();
+};
+
+#endif // BROAD_PHASE_BVH_H
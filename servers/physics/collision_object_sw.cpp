@@ -107,6 +107,21 @@ void CollisionObjectSW::_set_static(bool p_static) {
 	}
 }
 
+void CollisionObjectSW::_set_sleeping(bool p_sleeping) {
+	if (_sleeping == p_sleeping)
+		return;
+	_sleeping = p_sleeping;
+
+	if (!space)
+		return;
+	for (int i = 0; i < get_shape_count(); i++) {
+		Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			space->get_broadphase()->set_active(s.bpid, !_sleeping);
+		}
+	}
+}
+
 void CollisionObjectSW::_unregister_shapes() {
 
 	for (int i = 0; i < shapes.size(); i++) {
@@ -130,6 +145,8 @@ void CollisionObjectSW::_update_shapes() {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_sleeping)
+				space->get_broadphase()->set_active(s.bpid, false);
 		}
 
 		//not quite correct, should compute the next matrix..
@@ -154,6 +171,8 @@ void CollisionObjectSW::_update_shapes_with_motion(const Vector3 &p_motion) {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_sleeping)
+				space->get_broadphase()->set_active(s.bpid, false);
 		}
 
 		//not quite correct, should compute the next matrix..
@@ -201,6 +220,7 @@ void CollisionObjectSW::_shape_changed() {
 CollisionObjectSW::CollisionObjectSW(Type p_type) {
 
 	_static = true;
+	_sleeping = false;
 	type = p_type;
 	space = NULL;
 	instance_id = 0;
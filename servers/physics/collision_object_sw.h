@@ -72,10 +72,10 @@ private:
 	Transform transform;
 	Transform inv_transform;
 	bool _static;
-
-	void _update_shapes();
+	bool _sleeping;
 
 protected:
+	void _update_shapes();
 	void _update_shapes_with_motion(const Vector3 &p_motion);
 	void _unregister_shapes();
 
@@ -94,6 +94,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(SpaceSW *space);
@@ -27,6 +27,7 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "collision_solver_sat.h"
+#include "float4.h"
 #include "geometry.h"
 
 #define _EDGE_IS_VALID_SUPPORT_TRESHOLD 0.02
@@ -285,6 +286,124 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+/****** BATCHED PROJECTION *******/
+
+//separator axes are projected four at a time, each shape type projects all of them in a single pass over its points
+
+static bool sat_vectorized = true;
+
+void sat_set_vectorized(bool p_enable) {
+
+	sat_vectorized = p_enable;
+}
+
+bool sat_is_vectorized() {
+
+	return sat_vectorized;
+}
+
+struct _SATAxes4 {
+
+	real_t x[4];
+	real_t y[4];
+	real_t z[4];
+};
+
+//n.(B*v+o) == (Bt*n).v+n.o, so the axes are brought to shape space once and points are used untransformed
+_FORCE_INLINE_ static void _sat_local_axes4(const _SATAxes4 &p_axes, const Transform &p_transform, Float4 &r_x, Float4 &r_y, Float4 &r_z, Float4 &r_ofs) {
+
+	Float4 nx = Float4::load(p_axes.x);
+	Float4 ny = Float4::load(p_axes.y);
+	Float4 nz = Float4::load(p_axes.z);
+	const Matrix3 &b = p_transform.basis;
+
+	r_x = nx * b.elements[0][0] + ny * b.elements[1][0] + nz * b.elements[2][0];
+	r_y = nx * b.elements[0][1] + ny * b.elements[1][1] + nz * b.elements[2][1];
+	r_z = nx * b.elements[0][2] + ny * b.elements[1][2] + nz * b.elements[2][2];
+	r_ofs = nx * p_transform.origin.x + ny * p_transform.origin.y + nz * p_transform.origin.z;
+}
+
+_FORCE_INLINE_ static void _sat_project_points4(const Vector3 *p_points, int p_count, const _SATAxes4 &p_axes, const Transform &p_transform, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, lz, ofs;
+	_sat_local_axes4(p_axes, p_transform, lx, ly, lz, ofs);
+
+	if (p_count == 0) {
+		ofs.store(r_min);
+		ofs.store(r_max);
+		return;
+	}
+
+	Float4 d = lx * p_points[0].x + ly * p_points[0].y + lz * p_points[0].z;
+	Float4 mn = d;
+	Float4 mx = d;
+
+	for (int i = 1; i < p_count; i++) {
+
+		d = lx * p_points[i].x + ly * p_points[i].y + lz * p_points[i].z;
+		mn = Float4::min(mn, d);
+		mx = Float4::max(mx, d);
+	}
+
+	(mn + ofs).store(r_min);
+	(mx + ofs).store(r_max);
+}
+
+template <class T>
+_FORCE_INLINE_ static void _sat_project_range4(const T *p_shape, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	//no batched version, project one by one
+	for (int i = 0; i < 4; i++) {
+		p_shape->project_range(Vector3(p_axes.x[i], p_axes.y[i], p_axes.z[i]), p_transform, r_min[i], r_max[i]);
+	}
+}
+
+_FORCE_INLINE_ static void _sat_project_range4(const SphereShapeSW *p_sphere, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, lz, ofs;
+	_sat_local_axes4(p_axes, p_transform, lx, ly, lz, ofs);
+
+	Float4 length = Float4::sqrt(lx * lx + ly * ly + lz * lz) * p_sphere->get_radius();
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_project_range4(const BoxShapeSW *p_box, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, lz, ofs;
+	_sat_local_axes4(p_axes, p_transform, lx, ly, lz, ofs);
+
+	const Vector3 &he = p_box->get_half_extents();
+	Float4 length = Float4::abs(lx) * he.x + Float4::abs(ly) * he.y + Float4::abs(lz) * he.z;
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_project_range4(const CapsuleShapeSW *p_capsule, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, lz, ofs;
+	_sat_local_axes4(p_axes, p_transform, lx, ly, lz, ofs);
+
+	//ball radius along the axis plus half the segment
+	Float4 length = Float4::sqrt(lx * lx + ly * ly + lz * lz) * p_capsule->get_radius() + Float4::abs(lz) * (p_capsule->get_height() * 0.5);
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_project_range4(const ConvexPolygonShapeSW *p_convex, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	const Geometry::MeshData &mesh = p_convex->get_mesh();
+	_sat_project_points4(mesh.vertices.ptr(), mesh.vertices.size(), p_axes, p_transform, r_min, r_max);
+}
+
+_FORCE_INLINE_ static void _sat_project_range4(const FaceShapeSW *p_face, const Transform &p_transform, const _SATAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	_sat_project_points4(p_face->vertex, 3, p_axes, p_transform, r_min, r_max);
+}
+
 template <class ShapeA, class ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
 
@@ -299,6 +418,48 @@ class SeparatorAxisTest {
 	real_t margin_B;
 	Vector3 separator_axis;
 
+	Vector3 queued_axes[4];
+	int queued_count;
+
+	_FORCE_INLINE_ bool _test_range(const Vector3 &p_axis, real_t p_min_A, real_t p_max_A, real_t p_min_B, real_t p_max_B) {
+
+		if (withMargin) {
+			p_min_A -= margin_A;
+			p_max_A += margin_A;
+			p_min_B -= margin_B;
+			p_max_B += margin_B;
+		}
+
+		p_min_B -= (p_max_A - p_min_A) * 0.5;
+		p_max_B += (p_max_A - p_min_A) * 0.5;
+
+		real_t dmin = p_min_B - (p_min_A + p_max_A) * 0.5;
+		real_t dmax = p_max_B - (p_min_A + p_max_A) * 0.5;
+
+		if (dmin > 0.0 || dmax < 0.0) {
+			separator_axis = p_axis;
+			return false; // doesn't contain 0
+		}
+
+		//use the smallest depth
+
+		dmin = Math::abs(dmin);
+
+		if (dmax < dmin) {
+			if (dmax < best_depth) {
+				best_depth = dmax;
+				best_axis = p_axis;
+			}
+		} else {
+			if (dmin < best_depth) {
+				best_depth = dmin;
+				best_axis = -p_axis; // keep it as A axis
+			}
+		}
+
+		return true;
+	}
+
 public:
 	_FORCE_INLINE_ bool test_previous_axis() {
 
@@ -324,38 +485,56 @@ public:
 		shape_A->project_range(axis, *transform_A, min_A, max_A);
 		shape_B->project_range(axis, *transform_B, min_B, max_B);
 
-		if (withMargin) {
-			min_A -= margin_A;
-			max_A += margin_A;
-			min_B -= margin_B;
-			max_B += margin_B;
-		}
+		return _test_range(axis, min_A, max_A, min_B, max_B);
+	}
 
-		min_B -= (max_A - min_A) * 0.5;
-		max_B += (max_A - min_A) * 0.5;
+	//same as test_axis, but axes are projected in groups of four. flush_axes() must be called before generate_contacts()
+	_FORCE_INLINE_ bool queue_axis(const Vector3 &p_axis) {
 
-		real_t dmin = min_B - (min_A + max_A) * 0.5;
-		real_t dmax = max_B - (min_A + max_A) * 0.5;
+		if (!sat_vectorized)
+			return test_axis(p_axis);
 
-		if (dmin > 0.0 || dmax < 0.0) {
-			separator_axis = axis;
-			return false; // doesn't contain 0
-		}
+		queued_axes[queued_count++] = p_axis;
+		if (queued_count < 4)
+			return true;
 
-		//use the smallest depth
+		return flush_axes();
+	}
 
-		dmin = Math::abs(dmin);
+	bool flush_axes() {
 
-		if (dmax < dmin) {
-			if (dmax < best_depth) {
-				best_depth = dmax;
-				best_axis = axis;
-			}
-		} else {
-			if (dmin < best_depth) {
-				best_depth = dmin;
-				best_axis = -axis; // keep it as A axis
+		if (queued_count == 0)
+			return true;
+
+		int count = queued_count;
+		queued_count = 0;
+
+		_SATAxes4 axes;
+		for (int i = 0; i < 4; i++) {
+
+			Vector3 axis = queued_axes[i < count ? i : count - 1];
+
+			if (Math::abs(axis.x) < CMP_EPSILON &&
+					Math::abs(axis.y) < CMP_EPSILON &&
+					Math::abs(axis.z) < CMP_EPSILON) {
+				// strange case, try an upwards separator
+				axis = Vector3(0.0, 1.0, 0.0);
 			}
+
+			axes.x[i] = axis.x;
+			axes.y[i] = axis.y;
+			axes.z[i] = axis.z;
+		}
+
+		real_t min_A[4], max_A[4], min_B[4], max_B[4];
+		_sat_project_range4(shape_A, *transform_A, axes, min_A, max_A);
+		_sat_project_range4(shape_B, *transform_B, axes, min_B, max_B);
+
+		//results are evaluated in order, so the outcome matches testing one by one
+		for (int i = 0; i < count; i++) {
+
+			if (!_test_range(Vector3(axes.x[i], axes.y[i], axes.z[i]), min_A[i], max_A[i], min_B[i], max_B[i]))
+				return false;
 		}
 
 		return true;
@@ -435,6 +614,7 @@ public:
 		callback = p_callback;
 		margin_A = p_margin_A;
 		margin_B = p_margin_B;
+		queued_count = 0;
 	}
 };
 
@@ -668,7 +848,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 
 		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -678,7 +858,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 
 		Vector3 axis = p_transform_b.basis.get_axis(i).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -693,7 +873,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 				continue;
 			axis.normalize();
 
-			if (!separator.test_axis(axis)) {
+			if (!separator.queue_axis(axis)) {
 				return;
 			}
 		}
@@ -724,7 +904,7 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 
 		Vector3 axis_ab = (support_a - support_b);
 
-		if (!separator.test_axis(axis_ab.normalized())) {
+		if (!separator.queue_axis(axis_ab.normalized())) {
 			return;
 		}
 
@@ -735,17 +915,20 @@ static void _collision_box_box(const ShapeSW *p_a, const Transform &p_transform_
 			//a ->b
 			Vector3 axis_a = p_transform_a.basis.get_axis(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
+			if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
 				return;
 
 			//b ->a
 			Vector3 axis_b = p_transform_b.basis.get_axis(i);
 
-			if (!separator.test_axis(axis_ab.cross(axis_b).cross(axis_b).normalized()))
+			if (!separator.queue_axis(axis_ab.cross(axis_b).cross(axis_b).normalized()))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -765,7 +948,7 @@ static void _collision_box_capsule(const ShapeSW *p_a, const Transform &p_transf
 
 		Vector3 axis = p_transform_a.basis.get_axis(i);
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -781,7 +964,7 @@ static void _collision_box_capsule(const ShapeSW *p_a, const Transform &p_transf
 		if (axis.length_squared() < CMP_EPSILON)
 			continue;
 
-		if (!separator.test_axis(axis.normalized()))
+		if (!separator.queue_axis(axis.normalized()))
 			return;
 	}
 
@@ -802,7 +985,7 @@ static void _collision_box_capsule(const ShapeSW *p_a, const Transform &p_transf
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
 				Vector3 axis = Plane(cyl_axis, 0).project(point).normalized();
 
-				if (!separator.test_axis(axis))
+				if (!separator.queue_axis(axis))
 					return;
 			}
 		}
@@ -827,7 +1010,7 @@ static void _collision_box_capsule(const ShapeSW *p_a, const Transform &p_transf
 		// use point to test axis
 		Vector3 point_axis = (sphere_pos - cpoint).normalized();
 
-		if (!separator.test_axis(point_axis))
+		if (!separator.queue_axis(point_axis))
 			return;
 
 		// test edges of A
@@ -836,11 +1019,14 @@ static void _collision_box_capsule(const ShapeSW *p_a, const Transform &p_transf
 
 			Vector3 axis = point_axis.cross(p_transform_a.basis.get_axis(i)).cross(p_transform_a.basis.get_axis(i)).normalized();
 
-			if (!separator.test_axis(axis))
+			if (!separator.queue_axis(axis))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -869,7 +1055,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 
 		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -878,7 +1064,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 
 		Vector3 axis = p_transform_b.xform(faces[i].plane).normal;
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -893,7 +1079,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis))
+			if (!separator.queue_axis(axis))
 				return;
 		}
 	}
@@ -916,7 +1102,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 
 			Vector3 axis_ab = support_a - vtxb;
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -927,7 +1113,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 				//a ->b
 				Vector3 axis_a = p_transform_a.basis.get_axis(i);
 
-				if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
+				if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
 					return;
 			}
 		}
@@ -950,7 +1136,7 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 						Vector3 p2 = p_transform_b.xform(vertices[edges[e].b]);
 						Vector3 n = (p2 - p1);
 
-						if (!separator.test_axis((point - p2).cross(n).cross(n).normalized()))
+						if (!separator.queue_axis((point - p2).cross(n).cross(n).normalized()))
 							return;
 					}
 				}
@@ -958,6 +1144,9 @@ static void _collision_box_convex_polygon(const ShapeSW *p_a, const Transform &p
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -975,7 +1164,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 		p_transform_b.xform(face_B->vertex[2]),
 	};
 
-	if (!separator.test_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
+	if (!separator.queue_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
 		return;
 
 	// faces of A
@@ -983,7 +1172,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 
 		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -997,7 +1186,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 
 			Vector3 axis = p_transform_a.basis.get_axis(j);
 
-			if (!separator.test_axis(e.cross(axis).normalized()))
+			if (!separator.queue_axis(e.cross(axis).normalized()))
 				return;
 		}
 	}
@@ -1019,7 +1208,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 
 			Vector3 axis_ab = support_a - vertex[v];
 
-			if (!separator.test_axis(axis_ab.normalized())) {
+			if (!separator.queue_axis(axis_ab.normalized())) {
 				return;
 			}
 
@@ -1030,7 +1219,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 				//a ->b
 				Vector3 axis_a = p_transform_a.basis.get_axis(i);
 
-				if (!separator.test_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
+				if (!separator.queue_axis(axis_ab.cross(axis_a).cross(axis_a).normalized()))
 					return;
 			}
 		}
@@ -1054,7 +1243,7 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 
 						Vector3 n = (p2 - p1);
 
-						if (!separator.test_axis((point - p2).cross(n).cross(n).normalized()))
+						if (!separator.queue_axis((point - p2).cross(n).cross(n).normalized()))
 							return;
 					}
 				}
@@ -1062,6 +1251,9 @@ static void _collision_box_face(const ShapeSW *p_a, const Transform &p_transform
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1088,33 +1280,36 @@ static void _collision_capsule_capsule(const ShapeSW *p_a, const Transform &p_tr
 
 	//balls-balls
 
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_1).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_1 - capsule_B_ball_1).normalized()))
 		return;
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_2).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_1 - capsule_B_ball_2).normalized()))
 		return;
 
-	if (!separator.test_axis((capsule_A_ball_2 - capsule_B_ball_1).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_2 - capsule_B_ball_1).normalized()))
 		return;
-	if (!separator.test_axis((capsule_A_ball_2 - capsule_B_ball_2).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_2 - capsule_B_ball_2).normalized()))
 		return;
 
 	// edges-balls
 
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_1).cross(capsule_A_axis).cross(capsule_A_axis).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_1 - capsule_B_ball_1).cross(capsule_A_axis).cross(capsule_A_axis).normalized()))
 		return;
 
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_2).cross(capsule_A_axis).cross(capsule_A_axis).normalized()))
+	if (!separator.queue_axis((capsule_A_ball_1 - capsule_B_ball_2).cross(capsule_A_axis).cross(capsule_A_axis).normalized()))
 		return;
 
-	if (!separator.test_axis((capsule_B_ball_1 - capsule_A_ball_1).cross(capsule_B_axis).cross(capsule_B_axis).normalized()))
+	if (!separator.queue_axis((capsule_B_ball_1 - capsule_A_ball_1).cross(capsule_B_axis).cross(capsule_B_axis).normalized()))
 		return;
 
-	if (!separator.test_axis((capsule_B_ball_1 - capsule_A_ball_2).cross(capsule_B_axis).cross(capsule_B_axis).normalized()))
+	if (!separator.queue_axis((capsule_B_ball_1 - capsule_A_ball_2).cross(capsule_B_axis).cross(capsule_B_axis).normalized()))
 		return;
 
 	// edges
 
-	if (!separator.test_axis(capsule_A_axis.cross(capsule_B_axis).normalized()))
+	if (!separator.queue_axis(capsule_A_axis.cross(capsule_B_axis).normalized()))
+		return;
+
+	if (!separator.flush_axes())
 		return;
 
 	separator.generate_contacts();
@@ -1144,7 +1339,7 @@ static void _collision_capsule_convex_polygon(const ShapeSW *p_a, const Transfor
 
 		Vector3 axis = p_transform_b.xform(faces[i].plane).normal;
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -1156,7 +1351,7 @@ static void _collision_capsule_convex_polygon(const ShapeSW *p_a, const Transfor
 		Vector3 edge_axis = p_transform_b.basis.xform(vertices[edges[i].a]) - p_transform_b.basis.xform(vertices[edges[i].b]);
 		Vector3 axis = edge_axis.cross(p_transform_a.basis.get_axis(2)).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -1177,11 +1372,14 @@ static void _collision_capsule_convex_polygon(const ShapeSW *p_a, const Transfor
 
 			Vector3 axis = n1.cross(n2).cross(n2).normalized();
 
-			if (!separator.test_axis(axis))
+			if (!separator.queue_axis(axis))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1199,7 +1397,7 @@ static void _collision_capsule_face(const ShapeSW *p_a, const Transform &p_trans
 		p_transform_b.xform(face_B->vertex[2]),
 	};
 
-	if (!separator.test_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
+	if (!separator.queue_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
 		return;
 
 	// edges of B, capsule cylinder
@@ -1212,10 +1410,10 @@ static void _collision_capsule_face(const ShapeSW *p_a, const Transform &p_trans
 		Vector3 edge_axis = vertex[i] - vertex[(i + 1) % 3];
 		Vector3 axis = edge_axis.cross(capsule_axis).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 
-		if (!separator.test_axis((p_transform_a.origin - vertex[i]).cross(capsule_axis).cross(capsule_axis).normalized()))
+		if (!separator.queue_axis((p_transform_a.origin - vertex[i]).cross(capsule_axis).cross(capsule_axis).normalized()))
 			return;
 
 		for (int j = 0; j < 2; j++) {
@@ -1225,18 +1423,21 @@ static void _collision_capsule_face(const ShapeSW *p_a, const Transform &p_trans
 
 			Vector3 n1 = sphere_pos - vertex[i];
 
-			if (!separator.test_axis(n1.normalized()))
+			if (!separator.queue_axis(n1.normalized()))
 				return;
 
 			Vector3 n2 = edge_axis;
 
 			axis = n1.cross(n2).cross(n2);
 
-			if (!separator.test_axis(axis.normalized()))
+			if (!separator.queue_axis(axis.normalized()))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1275,7 +1476,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 		Vector3 axis = p_transform_a.xform(faces_A[i].plane).normal;
 		//		Vector3 axis = p_transform_a.basis.xform( faces_A[i].plane.normal ).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -1285,7 +1486,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 		Vector3 axis = p_transform_b.xform(faces_B[i].plane).normal;
 		//		Vector3 axis = p_transform_b.basis.xform( faces_B[i].plane.normal ).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -1300,7 +1501,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis))
+			if (!separator.queue_axis(axis))
 				return;
 		}
 	}
@@ -1314,7 +1515,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 			for (int j = 0; j < vertex_count_B; j++) {
 
-				if (!separator.test_axis((va - p_transform_b.xform(vertices_B[j])).normalized()))
+				if (!separator.queue_axis((va - p_transform_b.xform(vertices_B[j])).normalized()))
 					return;
 			}
 		}
@@ -1330,7 +1531,7 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 				Vector3 e3 = p_transform_b.xform(vertices_B[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
 			}
 		}
@@ -1345,12 +1546,15 @@ static void _collision_convex_polygon_convex_polygon(const ShapeSW *p_a, const T
 
 				Vector3 e3 = p_transform_a.xform(vertices_A[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1377,7 +1581,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 		p_transform_b.xform(face_B->vertex[2]),
 	};
 
-	if (!separator.test_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
+	if (!separator.queue_axis((vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized()))
 		return;
 
 	// faces of A
@@ -1386,7 +1590,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 		//		Vector3 axis = p_transform_a.xform( faces[i].plane ).normal;
 		Vector3 axis = p_transform_a.basis.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis))
+		if (!separator.queue_axis(axis))
 			return;
 	}
 
@@ -1401,7 +1605,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 			Vector3 axis = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis))
+			if (!separator.queue_axis(axis))
 				return;
 		}
 	}
@@ -1415,7 +1619,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 			for (int j = 0; j < 3; j++) {
 
-				if (!separator.test_axis((va - vertex[j]).normalized()))
+				if (!separator.queue_axis((va - vertex[j]).normalized()))
 					return;
 			}
 		}
@@ -1431,7 +1635,7 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 				Vector3 e3 = vertex[j];
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
 			}
 		}
@@ -1446,12 +1650,15 @@ static void _collision_convex_polygon_face(const ShapeSW *p_a, const Transform &
 
 				Vector3 e3 = p_transform_a.xform(vertices[j]);
 
-				if (!separator.test_axis((e1 - e3).cross(n).cross(n).normalized()))
+				if (!separator.queue_axis((e1 - e3).cross(n).cross(n).normalized()))
 					return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
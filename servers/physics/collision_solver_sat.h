@@ -33,4 +33,8 @@
 
 bool sat_calculate_penetration(const ShapeSW *p_shape_A, const Transform &p_transform_A, const ShapeSW *p_shape_B, const Transform &p_transform_B, CollisionSolverSW::CallbackResult p_result_callback, void *p_userdata, bool p_swap = false, Vector3 *r_prev_axis = NULL, float p_margin_a = 0, float p_margin_b = 0);
 
+//separator axes are projected in groups of four (SSE2 when available), disabling it falls back to one axis at a time
+void sat_set_vectorized(bool p_enable);
+bool sat_is_vectorized();
+
 #endif // COLLISION_SOLVER_SAT_H
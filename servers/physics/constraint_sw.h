@@ -31,6 +31,8 @@
 
 #include "body_sw.h"
 
+class IslandSolverSW;
+
 class ConstraintSW {
 
 	BodySW **_body_ptr;
@@ -39,15 +41,19 @@ class ConstraintSW {
 	ConstraintSW *island_next;
 	ConstraintSW *island_list_next;
 	int priority;
+	uint64_t creation_id;
 
 	RID self;
 
+	static uint64_t creation_count;
+
 protected:
 	ConstraintSW(BodySW **p_body_ptr = NULL, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
 		priority = 1;
+		creation_id = creation_count++;
 	}
 
 public:
@@ -69,9 +75,16 @@ public:
 	_FORCE_INLINE_ void set_priority(int p_priority) { priority = p_priority; }
 	_FORCE_INLINE_ int get_priority() const { return priority; }
 
+	_FORCE_INLINE_ uint64_t get_creation_id() const { return creation_id; }
+
 	virtual bool setup(float p_step) = 0;
 	virtual void solve(float p_step) = 0;
 
+	//contact constraints copy themselves into the island solver arrays and read the impulses back after solving,
+	//returning false leaves the constraint to solve()
+	virtual bool pack(IslandSolverSW *p_solver) { return false; }
+	virtual void unpack(const IslandSolverSW *p_solver, int p_from) {}
+
 	virtual ~ConstraintSW() {}
 };
 
@@ -0,0 +1,314 @@
+/*************************************************************************/
+/*  island_solver_sw.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "island_solver_sw.h"
+
+#define MIN_VELOCITY 0.0001
+
+template <class T>
+static _FORCE_INLINE_ T *_island_alloc(Vector<T> &p_vector, int &r_count, int p_amount) {
+
+	if (r_count + p_amount > p_vector.size()) {
+		p_vector.resize(MAX(r_count + p_amount, p_vector.size() * 2));
+	}
+
+	T *ret = p_vector.ptr() + r_count;
+	r_count += p_amount;
+	return ret;
+}
+
+int IslandSolverSW::add_body(BodySW *p_body) {
+
+	//dynamic bodies belong to a single island, static and kinematic ones can be shared so each pair gets its own read-only copy
+	bool dynamic = p_body->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC;
+	if (dynamic && p_body->get_solver_index() >= 0)
+		return p_body->get_solver_index();
+
+	int index = body_count;
+	Body *b = _island_alloc(bodies, body_count, 1);
+	b->linear_velocity = p_body->get_linear_velocity();
+	b->angular_velocity = p_body->get_angular_velocity();
+	b->biased_linear_velocity = p_body->get_biased_linear_velocity();
+	b->biased_angular_velocity = p_body->get_biased_angular_velocity();
+	b->inv_mass = p_body->get_inv_mass();
+	b->inv_inertia_tensor = p_body->get_inv_inertia_tensor();
+
+	if (dynamic) {
+		b->body = p_body;
+		p_body->set_solver_index(index);
+	} else {
+		b->body = NULL;
+	}
+
+	return index;
+}
+
+IslandSolverSW::Contact *IslandSolverSW::add_contacts(int p_count) {
+
+	return _island_alloc(contacts, contact_count, p_count);
+}
+
+void IslandSolverSW::setup(ConstraintSW *p_island) {
+
+	body_count = 0;
+	contact_count = 0;
+	run_count = 0;
+	packed_count = 0;
+	max_priority = 1;
+
+	for (ConstraintSW *ci = p_island; ci; ci = ci->get_island_next()) {
+
+		int from = contact_count;
+		int priority = ci->get_priority();
+		max_priority = MAX(max_priority, priority);
+
+		if (ci->pack(this)) {
+
+			if (contact_count == from)
+				continue; //nothing to solve
+
+			Packed *p = _island_alloc(packed, packed_count, 1);
+			p->constraint = ci;
+			p->from = from;
+
+			//consecutive contact constraints are solved as a single flat run
+			if (run_count > 0 && runs[run_count - 1].constraint == NULL && runs[run_count - 1].priority == priority) {
+				runs[run_count - 1].to = contact_count;
+				continue;
+			}
+
+			Run *r = _island_alloc(runs, run_count, 1);
+			r->constraint = NULL;
+			r->from = from;
+			r->to = contact_count;
+			r->priority = priority;
+
+		} else {
+
+			Run *r = _island_alloc(runs, run_count, 1);
+			r->constraint = ci;
+			r->from = 0;
+			r->to = 0;
+			r->priority = priority;
+		}
+	}
+}
+
+void IslandSolverSW::_solve_contacts(int p_from, int p_to) {
+
+	Body *b = bodies.ptr();
+	Contact *contact = contacts.ptr();
+
+	for (int i = p_from; i < p_to; i++) {
+
+		Contact &c = contact[i];
+		if (!c.active)
+			continue;
+
+		Body &A = b[c.body_A];
+		Body &B = b[c.body_B];
+
+		c.active = false; //try to deactivate, will activate itself if still needed
+
+		//bias impule
+
+		Vector3 crbA = A.biased_angular_velocity.cross(c.rA);
+		Vector3 crbB = B.biased_angular_velocity.cross(c.rB);
+		Vector3 dbv = B.biased_linear_velocity + crbB - A.biased_linear_velocity - crbA;
+
+		real_t vbn = dbv.dot(c.normal);
+
+		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+
+			real_t jbn = (-vbn + c.bias) * c.mass_normal;
+			real_t jbnOld = c.acc_bias_impulse;
+			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
+
+			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
+
+			A.apply_bias_impulse(c.rA, -jb);
+			B.apply_bias_impulse(c.rB, jb);
+
+			c.active = true;
+		}
+
+		Vector3 crA = A.angular_velocity.cross(c.rA);
+		Vector3 crB = B.angular_velocity.cross(c.rB);
+		Vector3 dv = B.linear_velocity + crB - A.linear_velocity - crA;
+
+		//normal impule
+		real_t vn = dv.dot(c.normal);
+
+		if (Math::abs(vn) > MIN_VELOCITY) {
+
+			real_t jn = -(c.bounce + vn) * c.mass_normal;
+			real_t jnOld = c.acc_normal_impulse;
+			c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
+
+			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
+
+			A.apply_impulse(c.rA, -j);
+			B.apply_impulse(c.rB, j);
+
+			c.active = true;
+		}
+
+		//friction impule
+
+		Vector3 lvA = A.linear_velocity + A.angular_velocity.cross(c.rA);
+		Vector3 lvB = B.linear_velocity + B.angular_velocity.cross(c.rB);
+
+		Vector3 dtv = lvB - lvA;
+		real_t tn = c.normal.dot(dtv);
+
+		// tangential velocity
+		Vector3 tv = dtv - c.normal * tn;
+		real_t tvl = tv.length();
+
+		if (tvl > MIN_VELOCITY) {
+
+			tv /= tvl;
+
+			Vector3 temp1 = A.inv_inertia_tensor.xform(c.rA.cross(tv));
+			Vector3 temp2 = B.inv_inertia_tensor.xform(c.rB.cross(tv));
+
+			real_t t = -tvl /
+					   (A.inv_mass + B.inv_mass + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+
+			Vector3 jt = t * tv;
+
+			Vector3 jtOld = c.acc_tangent_impulse;
+			c.acc_tangent_impulse += jt;
+
+			real_t fi_len = c.acc_tangent_impulse.length();
+			real_t jtMax = c.acc_normal_impulse * c.friction;
+
+			if (fi_len > CMP_EPSILON && fi_len > jtMax) {
+
+				c.acc_tangent_impulse *= jtMax / fi_len;
+			}
+
+			jt = c.acc_tangent_impulse - jtOld;
+
+			A.apply_impulse(c.rA, -jt);
+			B.apply_impulse(c.rB, jt);
+
+			c.active = true;
+		}
+	}
+}
+
+void IslandSolverSW::_solve_constraint(ConstraintSW *p_constraint, float p_step) {
+
+	//joints work on the bodies directly, so hand them the packed state and take it back afterwards
+	BodySW **body_ptr = p_constraint->get_body_ptr();
+	int body_ptr_count = p_constraint->get_body_count();
+	Body *b = bodies.ptr();
+
+	for (int i = 0; i < body_ptr_count; i++) {
+
+		int index = body_ptr[i]->get_solver_index();
+		if (index < 0)
+			continue;
+
+		body_ptr[i]->set_linear_velocity(b[index].linear_velocity);
+		body_ptr[i]->set_angular_velocity(b[index].angular_velocity);
+		body_ptr[i]->set_biased_linear_velocity(b[index].biased_linear_velocity);
+		body_ptr[i]->set_biased_angular_velocity(b[index].biased_angular_velocity);
+	}
+
+	p_constraint->solve(p_step);
+
+	for (int i = 0; i < body_ptr_count; i++) {
+
+		int index = body_ptr[i]->get_solver_index();
+		if (index < 0)
+			continue;
+
+		b[index].linear_velocity = body_ptr[i]->get_linear_velocity();
+		b[index].angular_velocity = body_ptr[i]->get_angular_velocity();
+		b[index].biased_linear_velocity = body_ptr[i]->get_biased_linear_velocity();
+		b[index].biased_angular_velocity = body_ptr[i]->get_biased_angular_velocity();
+	}
+}
+
+void IslandSolverSW::solve(int p_iterations, float p_step) {
+
+	const Run *r = runs.ptr();
+
+	//the first pass solves everything, each following one only what has a priority at least that high
+	for (int at_priority = 1; at_priority <= max_priority; at_priority++) {
+
+		for (int i = 0; i < p_iterations; i++) {
+
+			for (int j = 0; j < run_count; j++) {
+
+				if (at_priority > 1 && r[j].priority < at_priority)
+					continue;
+
+				if (r[j].constraint) {
+					_solve_constraint(r[j].constraint, p_step);
+				} else {
+					_solve_contacts(r[j].from, r[j].to);
+				}
+			}
+		}
+	}
+}
+
+void IslandSolverSW::finish() {
+
+	Body *b = bodies.ptr();
+
+	for (int i = 0; i < body_count; i++) {
+
+		if (!b[i].body)
+			continue;
+
+		b[i].body->set_linear_velocity(b[i].linear_velocity);
+		b[i].body->set_angular_velocity(b[i].angular_velocity);
+		b[i].body->set_biased_linear_velocity(b[i].biased_linear_velocity);
+		b[i].body->set_biased_angular_velocity(b[i].biased_angular_velocity);
+		b[i].body->set_solver_index(-1);
+	}
+
+	const Packed *p = packed.ptr();
+
+	for (int i = 0; i < packed_count; i++) {
+		p[i].constraint->unpack(this, p[i].from);
+	}
+}
+
+IslandSolverSW::IslandSolverSW() {
+
+	body_count = 0;
+	contact_count = 0;
+	run_count = 0;
+	packed_count = 0;
+	max_priority = 1;
+}
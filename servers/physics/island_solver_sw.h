@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  island_solver_sw.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef ISLAND_SOLVER_SW_H
+#define ISLAND_SOLVER_SW_H
+
+#include "body_sw.h"
+#include "constraint_sw.h"
+
+//iterates an island over packed copies of its bodies and contacts instead of chasing BodySW pointers,
+//constraints that can't be packed (joints) are still solved through ConstraintSW::solve()
+class IslandSolverSW {
+public:
+	struct Body {
+
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 biased_linear_velocity;
+		Vector3 biased_angular_velocity;
+		real_t inv_mass;
+		Matrix3 inv_inertia_tensor;
+		BodySW *body; //NULL for static and kinematic bodies, which are never written back
+
+		_FORCE_INLINE_ void apply_impulse(const Vector3 &p_pos, const Vector3 &p_j) {
+
+			linear_velocity += p_j * inv_mass;
+			angular_velocity += inv_inertia_tensor.xform(p_pos.cross(p_j));
+		}
+
+		_FORCE_INLINE_ void apply_bias_impulse(const Vector3 &p_pos, const Vector3 &p_j) {
+
+			biased_linear_velocity += p_j * inv_mass;
+			biased_angular_velocity += inv_inertia_tensor.xform(p_pos.cross(p_j));
+		}
+	};
+
+	struct Contact {
+
+		int body_A;
+		int body_B;
+		Vector3 normal;
+		Vector3 rA, rB;
+		real_t mass_normal;
+		real_t bias;
+		real_t bounce;
+		real_t friction;
+		real_t acc_normal_impulse;
+		Vector3 acc_tangent_impulse;
+		real_t acc_bias_impulse;
+		bool active;
+	};
+
+private:
+	struct Run {
+
+		ConstraintSW *constraint; //NULL for a run of packed contacts
+		int from;
+		int to;
+		int priority;
+	};
+
+	struct Packed {
+
+		ConstraintSW *constraint;
+		int from;
+	};
+
+	//these only grow, so the buffers are reused from step to step
+	Vector<Body> bodies;
+	Vector<Contact> contacts;
+	Vector<Run> runs;
+	Vector<Packed> packed;
+
+	int body_count;
+	int contact_count;
+	int run_count;
+	int packed_count;
+	int max_priority;
+
+	void _solve_contacts(int p_from, int p_to);
+	void _solve_constraint(ConstraintSW *p_constraint, float p_step);
+
+public:
+	int add_body(BodySW *p_body);
+	Contact *add_contacts(int p_count);
+	_FORCE_INLINE_ const Contact &get_contact(int p_index) const { return contacts[p_index]; }
+
+	void setup(ConstraintSW *p_island);
+	void solve(int p_iterations, float p_step);
+	void finish();
+
+	IslandSolverSW();
+};
+
+#endif // ISLAND_SOLVER_SW_H
@@ -28,6 +28,7 @@
 /*************************************************************************/
 #include "physics_server_sw.h"
 #include "broad_phase_basic.h"
+#include "broad_phase_bvh.h"
 #include "broad_phase_octree.h"
 #include "joints/cone_twist_joint_sw.h"
 #include "joints/generic_6dof_joint_sw.h"
@@ -35,6 +36,7 @@
 #include "joints/pin_joint_sw.h"
 #include "joints/slider_joint_sw.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "script_language.h"
 
 RID PhysicsServerSW::shape_create(ShapeType p_shape) {
@@ -597,7 +599,7 @@ void PhysicsServerSW::body_set_enable_continuous_collision_detection(RID p_body,
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
 
-	body->set_continuous_collision_detection(p_enable);
+	body->set_continuous_collision_detection_mode(p_enable ? CCD_MODE_CAST_RAY : CCD_MODE_DISABLED);
 }
 
 bool PhysicsServerSW::body_is_continuous_collision_detection_enabled(RID p_body) const {
@@ -605,7 +607,23 @@ bool PhysicsServerSW::body_is_continuous_collision_detection_enabled(RID p_body)
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, false);
 
-	return body->is_continuous_collision_detection_enabled();
+	return body->get_continuous_collision_detection_mode() != CCD_MODE_DISABLED;
+}
+
+void PhysicsServerSW::body_set_continuous_collision_detection_mode(RID p_body, CCDMode p_mode) {
+
+	BodySW *body = body_owner.get(p_body);
+	ERR_FAIL_COND(!body);
+
+	body->set_continuous_collision_detection_mode(p_mode);
+}
+
+PhysicsServerSW::CCDMode PhysicsServerSW::body_get_continuous_collision_detection_mode(RID p_body) const {
+
+	const BodySW *body = body_owner.get(p_body);
+	ERR_FAIL_COND_V(!body, CCD_MODE_DISABLED);
+
+	return body->get_continuous_collision_detection_mode();
 }
 
 void PhysicsServerSW::body_set_layer_mask(RID p_body, uint32_t p_mask) {
@@ -1377,11 +1395,18 @@ void PhysicsServerSW::init() {
 	last_step = 0.001;
 	iterations = 8; // 8?
 	stepper = memnew(StepSW);
+	//0 solves islands on the physics thread only, -1 uses one thread per core
+	stepper->set_thread_count(GLOBAL_DEF("physics/island_solver_threads", 0));
+	Globals::get_singleton()->set_custom_property_info("physics/island_solver_threads", PropertyInfo(Variant::INT, "physics/island_solver_threads", PROPERTY_HINT_RANGE, "-1,64,1"));
+	query_work_pool.init(GLOBAL_DEF("physics/batch_query_threads", 0));
+	Globals::get_singleton()->set_custom_property_info("physics/batch_query_threads", PropertyInfo(Variant::INT, "physics/batch_query_threads", PROPERTY_HINT_RANGE, "-1,64,1"));
 	direct_state = memnew(PhysicsDirectBodyStateSW);
 };
 
 void PhysicsServerSW::step(float p_step) {
 
+	TRACE_ZONE("PhysicsServer::step");
+
 	if (!active)
 		return;
 
@@ -1393,12 +1418,19 @@ void PhysicsServerSW::step(float p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	broad_phase_time = 0;
+	narrow_phase_time = 0;
+	solve_time = 0;
 	for (Set<const SpaceSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
 
 		stepper->step((SpaceSW *)E->get(), p_step, iterations);
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
 		collision_pairs += E->get()->get_collision_pairs();
+		broad_phase_time += E->get()->get_elapsed_time(SpaceSW::ELAPSED_TIME_BROAD_PHASE);
+		//contacts are generated when the pair constraints are set up
+		narrow_phase_time += E->get()->get_elapsed_time(SpaceSW::ELAPSED_TIME_SETUP_CONSTRAINTS);
+		solve_time += E->get()->get_elapsed_time(SpaceSW::ELAPSED_TIME_SOLVE_CONSTRAINTS);
 	}
 }
 
@@ -1429,7 +1461,8 @@ void PhysicsServerSW::flush_queries() {
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"broad_phase"
 		};
 
 		for (int i = 0; i < SpaceSW::ELAPSED_TIME_MAX; i++) {
@@ -1456,8 +1489,14 @@ void PhysicsServerSW::flush_queries() {
 	}
 };
 
+void PhysicsServerSW::end_sync() {
+
+	doing_sync = false;
+}
+
 void PhysicsServerSW::finish() {
 
+	query_work_pool.finish();
 	memdelete(stepper);
 	memdelete(direct_state);
 };
@@ -1477,6 +1516,19 @@ int PhysicsServerSW::get_process_info(ProcessInfo p_info) {
 
 			return island_count;
 		} break;
+		case INFO_BROAD_PHASE_TIME: {
+
+			return broad_phase_time;
+		} break;
+		case INFO_NARROW_PHASE_TIME: {
+
+			return narrow_phase_time;
+		} break;
+		case INFO_SOLVE_TIME: {
+
+			return solve_time;
+		} break;
+		default: {}
 	}
 
 	return 0;
@@ -1516,12 +1568,24 @@ void PhysicsServerSW::_shape_col_cbk(const Vector3 &p_point_A, const Vector3 &p_
 	}
 }
 
+PhysicsServerSW *PhysicsServerSW::singletonsw = NULL;
+
 PhysicsServerSW::PhysicsServerSW() {
 
-	BroadPhaseSW::create_func = BroadPhaseOctree::_create;
+	singletonsw = this;
+	String broad_phase = GLOBAL_DEF("physics/broad_phase", "Octree");
+	Globals::get_singleton()->set_custom_property_info("physics/broad_phase", PropertyInfo(Variant::STRING, "physics/broad_phase", PROPERTY_HINT_ENUM, "Octree,BVH"));
+
+	if (broad_phase == "BVH")
+		BroadPhaseSW::create_func = BroadPhaseBVH::_create;
+	else
+		BroadPhaseSW::create_func = BroadPhaseOctree::_create;
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	broad_phase_time = 0;
+	narrow_phase_time = 0;
+	solve_time = 0;
 
 	active = true;
 };
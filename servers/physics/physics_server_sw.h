@@ -30,6 +30,7 @@
 #define PHYSICS_SERVER_SW
 
 #include "joints_sw.h"
+#include "os/thread_work_pool.h"
 #include "servers/physics_server.h"
 #include "shape_sw.h"
 #include "space_sw.h"
@@ -48,10 +49,15 @@ class PhysicsServerSW : public PhysicsServer {
 	int island_count;
 	int active_objects;
 	int collision_pairs;
+	uint64_t broad_phase_time;
+	uint64_t narrow_phase_time;
+	uint64_t solve_time;
 
 	StepSW *stepper;
 	Set<const SpaceSW *> active_spaces;
 
+	ThreadWorkPool query_work_pool; //splits batched space queries
+
 	PhysicsDirectBodyStateSW *direct_state;
 
 	mutable RID_Owner<ShapeSW> shape_owner;
@@ -60,6 +66,8 @@ class PhysicsServerSW : public PhysicsServer {
 	mutable RID_Owner<BodySW> body_owner;
 	mutable RID_Owner<JointSW> joint_owner;
 
+	static PhysicsServerSW *singletonsw;
+
 	//	void _clear_query(QuerySW *p_query);
 public:
 	struct CollCbkData {
@@ -167,6 +175,9 @@ public:
 	virtual void body_set_enable_continuous_collision_detection(RID p_body, bool p_enable);
 	virtual bool body_is_continuous_collision_detection_enabled(RID p_body) const;
 
+	virtual void body_set_continuous_collision_detection_mode(RID p_body, CCDMode p_mode);
+	virtual CCDMode body_get_continuous_collision_detection_mode(RID p_body) const;
+
 	virtual void body_set_layer_mask(RID p_body, uint32_t p_mask);
 	virtual uint32_t body_get_layer_mask(RID p_body, uint32_t p_mask) const;
 
@@ -278,6 +289,7 @@ public:
 	virtual void step(float p_step);
 	virtual void sync();
 	virtual void flush_queries();
+	virtual void end_sync();
 	virtual void finish();
 
 	int get_process_info(ProcessInfo p_info);
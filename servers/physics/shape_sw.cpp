@@ -1437,7 +1437,13 @@ ConcavePolygonShapeSW::ConcavePolygonShapeSW() {
 
 DVector<float> HeightMapShapeSW::get_heights() const {
 
-	return heights;
+	DVector<float> ret;
+	ret.resize(heights.size());
+	DVector<float>::Write w = ret.write();
+	for (int i = 0; i < heights.size(); i++) {
+		w[i] = heights[i];
+	}
+	return ret;
 }
 int HeightMapShapeSW::get_width() const {
 
@@ -1464,12 +1470,174 @@ Vector3 HeightMapShapeSW::get_support(const Vector3 &p_normal) const {
 	return get_aabb().get_support(p_normal);
 }
 
+void HeightMapShapeSW::_get_cell(int p_x, int p_z, Vector3 *r_points, real_t &r_min_height, real_t &r_max_height) const {
+
+	r_points[0] = _get_point(p_x, p_z);
+	r_points[1] = _get_point(p_x + 1, p_z);
+	r_points[2] = _get_point(p_x, p_z + 1);
+	r_points[3] = _get_point(p_x + 1, p_z + 1);
+
+	r_min_height = MIN(MIN(r_points[0].y, r_points[1].y), MIN(r_points[2].y, r_points[3].y));
+	r_max_height = MAX(MAX(r_points[0].y, r_points[1].y), MAX(r_points[2].y, r_points[3].y));
+}
+
+//cell triangles, wound so the normal points up
+static const int _heightmap_cell_triangles[2][3] = { { 0, 1, 2 }, { 1, 3, 2 } };
+
+bool HeightMapShapeSW::_intersect_cell(int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, real_t &r_min_d, Vector3 &r_point, Vector3 &r_normal) const {
+
+	Vector3 points[4];
+	real_t min_height, max_height;
+	_get_cell(p_x, p_z, points, min_height, max_height);
+
+	if (MAX(p_begin.y, p_end.y) < min_height || MIN(p_begin.y, p_end.y) > max_height)
+		return false;
+
+	Vector3 dir = p_end - p_begin;
+	bool found = false;
+
+	for (int i = 0; i < 2; i++) {
+
+		const Vector3 &v0 = points[_heightmap_cell_triangles[i][0]];
+		const Vector3 &v1 = points[_heightmap_cell_triangles[i][1]];
+		const Vector3 &v2 = points[_heightmap_cell_triangles[i][2]];
+
+		Vector3 res;
+		if (!Geometry::segment_intersects_triangle(p_begin, p_end, v0, v1, v2, &res))
+			continue;
+
+		real_t d = dir.dot(res - p_begin);
+		if (d < r_min_d) {
+			r_min_d = d;
+			r_point = res;
+			r_normal = Plane(v0, v1, v2).normal;
+			if (r_normal.dot(dir) > 0)
+				r_normal = -r_normal;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
 bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
 
+	if (width < 2 || depth < 2)
+		return false;
+
+	Vector3 dir = p_end - p_begin;
+
+	//clip the segment to the grid on the xz plane
+	real_t t_begin = 0;
+	real_t t_end = 1;
+	real_t grid_size[3] = { (width - 1) * cell_size, 0, (depth - 1) * cell_size };
+
+	for (int i = 0; i < 3; i += 2) {
+
+		if (Math::abs(dir[i]) < CMP_EPSILON) {
+			if (p_begin[i] < 0 || p_begin[i] > grid_size[i])
+				return false;
+			continue;
+		}
+
+		real_t t0 = -p_begin[i] / dir[i];
+		real_t t1 = (grid_size[i] - p_begin[i]) / dir[i];
+		if (t0 > t1)
+			SWAP(t0, t1);
+		t_begin = MAX(t_begin, t0);
+		t_end = MIN(t_end, t1);
+		if (t_begin > t_end)
+			return false;
+	}
+
+	//walk the cells crossed by the segment in order, the first one hit holds the closest point
+	Vector3 from = p_begin + dir * t_begin;
+	int x = CLAMP(int(Math::floor(from.x / cell_size)), 0, width - 2);
+	int z = CLAMP(int(Math::floor(from.z / cell_size)), 0, depth - 2);
+
+	int step_x = dir.x > 0 ? 1 : -1;
+	int step_z = dir.z > 0 ? 1 : -1;
+
+	real_t t_next_x = 1e20;
+	real_t t_delta_x = 1e20;
+	if (Math::abs(dir.x) >= CMP_EPSILON) {
+		t_next_x = ((x + (step_x > 0 ? 1 : 0)) * cell_size - p_begin.x) / dir.x;
+		t_delta_x = cell_size / Math::abs(dir.x);
+	}
+
+	real_t t_next_z = 1e20;
+	real_t t_delta_z = 1e20;
+	if (Math::abs(dir.z) >= CMP_EPSILON) {
+		t_next_z = ((z + (step_z > 0 ? 1 : 0)) * cell_size - p_begin.z) / dir.z;
+		t_delta_z = cell_size / Math::abs(dir.z);
+	}
+
+	real_t min_d = 1e20;
+	real_t t_cell = t_begin;
+
+	while (true) {
+
+		real_t t_cell_end = MIN(MIN(t_next_x, t_next_z), t_end);
+
+		if (_intersect_cell(x, z, p_begin + dir * t_cell, p_begin + dir * t_cell_end, min_d, r_point, r_normal)) {
+			return true;
+		}
+
+		if (t_cell_end >= t_end)
+			break;
+
+		if (t_next_x < t_next_z) {
+			x += step_x;
+			t_cell = t_next_x;
+			t_next_x += t_delta_x;
+		} else {
+			z += step_z;
+			t_cell = t_next_z;
+			t_next_z += t_delta_z;
+		}
+
+		if (x < 0 || x >= width - 1 || z < 0 || z >= depth - 1)
+			break;
+	}
+
 	return false;
 }
 
 void HeightMapShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+
+	if (width < 2 || depth < 2)
+		return;
+
+	//only the cells under the aabb
+	Vector3 end = p_local_aabb.pos + p_local_aabb.size;
+	int from_x = MAX(int(Math::floor(p_local_aabb.pos.x / cell_size)), 0);
+	int from_z = MAX(int(Math::floor(p_local_aabb.pos.z / cell_size)), 0);
+	int to_x = MIN(int(Math::floor(end.x / cell_size)), width - 2);
+	int to_z = MIN(int(Math::floor(end.z / cell_size)), depth - 2);
+
+	FaceShapeSW face; // use this to send in the callback
+	Vector3 points[4];
+
+	for (int z = from_z; z <= to_z; z++) {
+
+		for (int x = from_x; x <= to_x; x++) {
+
+			real_t min_height, max_height;
+			_get_cell(x, z, points, min_height, max_height);
+
+			if (end.y < min_height || p_local_aabb.pos.y > max_height)
+				continue;
+
+			for (int i = 0; i < 2; i++) {
+
+				face.vertex[0] = points[_heightmap_cell_triangles[i][0]];
+				face.vertex[1] = points[_heightmap_cell_triangles[i][1]];
+				face.vertex[2] = points[_heightmap_cell_triangles[i][2]];
+				face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+				p_callback(p_userdata, &face);
+			}
+		}
+	}
 }
 
 Vector3 HeightMapShapeSW::get_moment_of_inertia(float p_mass) const {
@@ -1485,12 +1653,13 @@ Vector3 HeightMapShapeSW::get_moment_of_inertia(float p_mass) const {
 
 void HeightMapShapeSW::_setup(DVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size) {
 
-	heights = p_heights;
 	width = p_width;
 	depth = p_depth;
 	cell_size = p_cell_size;
 
-	DVector<real_t>::Read r = heights.read();
+	heights.resize(p_heights.size());
+
+	DVector<real_t>::Read r = p_heights.read();
 
 	AABB aabb;
 
@@ -1499,9 +1668,10 @@ void HeightMapShapeSW::_setup(DVector<real_t> p_heights, int p_width, int p_dept
 		for (int j = 0; j < width; j++) {
 
 			float h = r[i * width + j];
+			heights[i * width + j] = h;
 
 			Vector3 pos(j * cell_size, h, i * cell_size);
-			if (i == 0 || j == 0)
+			if (i == 0 && j == 0)
 				aabb.pos = pos;
 			else
 				aabb.expand_to(pos);
@@ -1534,7 +1704,12 @@ void HeightMapShapeSW::set_data(const Variant &p_data) {
 
 Variant HeightMapShapeSW::get_data() const {
 
-	ERR_FAIL_V(Variant());
+	Dictionary d;
+	d["width"] = width;
+	d["depth"] = depth;
+	d["cell_size"] = cell_size;
+	d["heights"] = get_heights();
+	return d;
 }
 
 HeightMapShapeSW::HeightMapShapeSW() {
@@ -341,13 +341,20 @@ public:
 
 struct HeightMapShapeSW : public ConcaveShapeSW {
 
-	DVector<real_t> heights;
+	//one float per grid point, the point (x,z) is at (x*cell_size,height,z*cell_size)
+	//and each cell is split in two triangles, so there is no need to keep faces around
+	Vector<float> heights;
 	int width;
 	int depth;
 	float cell_size;
 
-	//	void _cull_segment(int p_idx,_SegmentCullParams *p_params) const;
-	//	void _cull(int p_idx,_CullParams *p_params) const;
+	_FORCE_INLINE_ Vector3 _get_point(int p_x, int p_z) const {
+
+		return Vector3(p_x * cell_size, heights[p_z * width + p_x], p_z * cell_size);
+	}
+
+	_FORCE_INLINE_ void _get_cell(int p_x, int p_z, Vector3 *r_points, real_t &r_min_height, real_t &r_max_height) const;
+	_FORCE_INLINE_ bool _intersect_cell(int p_x, int p_z, const Vector3 &p_begin, const Vector3 &p_end, real_t &r_min_d, Vector3 &r_point, Vector3 &r_normal) const;
 
 	void _setup(DVector<float> p_heights, int p_width, int p_depth, float p_cell_size);
 
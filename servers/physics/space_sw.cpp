@@ -44,9 +44,9 @@ _FORCE_INLINE_ static bool _match_object_type_query(CollisionObjectSW *p_object,
 	return (1 << body->get_mode()) & p_type_mask;
 }
 
-bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, bool p_pick_ray) {
+static bool _intersect_ray_candidates(const Vector3 &p_from, const Vector3 &p_to, CollisionObjectSW *const *p_objects, const int *p_shapes, int p_amount, bool p_check_aabb, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, bool p_pick_ray, PhysicsDirectSpaceState::RayResult &r_result) {
 
-	ERR_FAIL_COND_V(space->locked, false);
+	//fills everything but the collider, looking it up needs the global lock
 
 	Vector3 begin, end;
 	Vector3 normal;
@@ -54,30 +54,30 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array tha references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
-
 	bool collided = false;
 	Vector3 res_point, res_normal;
 	int res_shape;
 	const CollisionObjectSW *res_obj;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+		if (!_match_object_type_query(p_objects[i], p_layer_mask, p_object_type_mask))
 			continue;
 
-		if (p_pick_ray && !(static_cast<CollisionObjectSW *>(space->intersection_query_results[i])->is_ray_pickable()))
+		if (p_pick_ray && !(static_cast<CollisionObjectSW *>(p_objects[i])->is_ray_pickable()))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue;
 
-		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
+		const CollisionObjectSW *col_obj = p_objects[i];
+
+		int shape_idx = p_shapes[i];
+
+		if (p_check_aabb && !col_obj->get_shape_aabb(shape_idx).intersects_segment(begin, end))
+			continue; //candidate shared with other queries
 
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -110,10 +110,7 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 		return false;
 
 	r_result.collider_id = res_obj->get_instance_id();
-	if (r_result.collider_id != 0)
-		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
-	else
-		r_result.collider = NULL;
+	r_result.collider = NULL;
 	r_result.normal = res_normal;
 	r_result.position = res_point;
 	r_result.rid = res_obj->get_self();
@@ -122,93 +119,37 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	return true;
 }
 
-int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
-
-	if (p_result_max <= 0)
-		return 0;
-
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
-	ERR_FAIL_COND_V(!shape, 0);
-
-	AABB aabb = p_xform.xform(shape->get_aabb());
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	int cc = 0;
-
-	//Transform ai = p_xform.affine_inverse();
-
-	for (int i = 0; i < amount; i++) {
-
-		if (cc >= p_result_max)
-			break;
-
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
-			continue;
-
-		//area cant be picked by ray (default)
-
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
-			continue;
-
-		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+static bool _cast_motion_candidates(ShapeSW *p_shape, const Transform &p_xform, const Vector3 &p_motion, float p_margin, CollisionObjectSW *const *p_objects, const int *p_shapes, int p_amount, bool p_check_aabb, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, float &r_closest_safe, float &r_closest_unsafe, PhysicsDirectSpaceState::ShapeRestInfo *r_info) {
 
-		if (!CollisionSolverSW::solve_static(shape, p_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), NULL, NULL, NULL, p_margin, 0))
-			continue;
-
-		if (r_results) {
-			r_results[cc].collider_id = col_obj->get_instance_id();
-			if (r_results[cc].collider_id != 0)
-				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
-			else
-				r_results[cc].collider = NULL;
-			r_results[cc].rid = col_obj->get_self();
-			r_results[cc].shape = shape_idx;
-		}
-
-		cc++;
-	}
-
-	return cc;
-}
-
-bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, float p_margin, float &p_closest_safe, float &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, ShapeRestInfo *r_info) {
-
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
-	ERR_FAIL_COND_V(!shape, false);
-
-	AABB aabb = p_xform.xform(shape->get_aabb());
+	AABB aabb = p_xform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(AABB(aabb.pos + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_margin);
 
-	//if (p_motion!=Vector3())
-	//	print_line(p_motion);
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	float best_safe = 1;
 	float best_unsafe = 1;
 
 	Transform xform_inv = p_xform.affine_inverse();
 	MotionShapeSW mshape;
-	mshape.shape = shape;
+	mshape.shape = p_shape;
 	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
 	Vector3 closest_A, closest_B;
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+		if (!_match_object_type_query(p_objects[i], p_layer_mask, p_object_type_mask))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue; //ignore excluded
 
-		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObjectSW *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
+
+		if (p_check_aabb && !col_obj->get_shape_aabb(shape_idx).intersects(aabb))
+			continue; //candidate shared with other queries
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = p_motion.normalized();
@@ -229,7 +170,7 @@ bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform
 #else
 		sep_axis = p_motion.normalized();
 
-		if (!CollisionSolverSW::solve_distance(shape, p_xform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!CollisionSolverSW::solve_distance(p_shape, p_xform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			//print_line("failed motion cast (no collision)");
 			return false;
 		}
@@ -286,18 +227,103 @@ bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform
 		}
 	}
 
-	p_closest_safe = best_safe;
-	p_closest_unsafe = best_unsafe;
+	r_closest_safe = best_safe;
+	r_closest_unsafe = best_unsafe;
 
 	return true;
 }
 
+bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, bool p_pick_ray) {
+
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	//todo, create another array tha references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	if (!_intersect_ray_candidates(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, p_exclude, p_layer_mask, p_object_type_mask, p_pick_ray, r_result))
+		return false;
+
+	if (r_result.collider_id != 0)
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+
+	return true;
+}
+
+int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	ShapeSW *shape = PhysicsServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	AABB aabb = p_xform.xform(shape->get_aabb());
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	int cc = 0;
+
+	//Transform ai = p_xform.affine_inverse();
+
+	for (int i = 0; i < amount; i++) {
+
+		if (cc >= p_result_max)
+			break;
+
+		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+			continue;
+
+		//area cant be picked by ray (default)
+
+		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+			continue;
+
+		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
+		int shape_idx = space->intersection_query_subindex_results[i];
+
+		if (!CollisionSolverSW::solve_static(shape, p_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), NULL, NULL, NULL, p_margin, 0))
+			continue;
+
+		if (r_results) {
+			r_results[cc].collider_id = col_obj->get_instance_id();
+			if (r_results[cc].collider_id != 0)
+				r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+			else
+				r_results[cc].collider = NULL;
+			r_results[cc].rid = col_obj->get_self();
+			r_results[cc].shape = shape_idx;
+		}
+
+		cc++;
+	}
+
+	return cc;
+}
+
+bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, float p_margin, float &p_closest_safe, float &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, ShapeRestInfo *r_info) {
+
+	ShapeSW *shape = PhysicsServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, false);
+
+	AABB aabb = p_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.pos + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+
+	//if (p_motion!=Vector3())
+	//	print_line(p_motion);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _cast_motion_candidates(shape, p_xform, p_motion, p_margin, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, p_exclude, p_layer_mask, p_object_type_mask, p_closest_safe, p_closest_unsafe, r_info);
+}
+
 bool PhysicsDirectSpaceStateSW::collide_shape(RID p_shape, const Transform &p_shape_xform, float p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
 
 	if (p_result_max <= 0)
 		return 0;
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singletonsw->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
@@ -373,7 +399,7 @@ static void _rest_cbk_result(const Vector3 &p_point_A, const Vector3 &p_point_B,
 }
 bool PhysicsDirectSpaceStateSW::rest_info(RID p_shape, const Transform &p_shape_xform, float p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
 
-	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
+	ShapeSW *shape = PhysicsServerSW::singletonsw->shape_owner.get(p_shape);
 	ERR_FAIL_COND_V(!shape, 0);
 
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
@@ -425,6 +451,233 @@ bool PhysicsDirectSpaceStateSW::rest_info(RID p_shape, const Transform &p_shape_
 	return true;
 }
 
+/* BATCHED QUERIES */
+
+//queries close to each other are grouped, so each group needs a single broadphase cull
+#define QUERY_BATCH_GROUP_MAX 16
+
+struct _QueryBatchSW {
+
+	struct Group {
+
+		int from;
+		int count;
+		int candidate_ofs;
+		int candidate_count;
+	};
+
+	Vector<Group> groups;
+	Vector<CollisionObjectSW *> candidates;
+	Vector<int> candidate_shapes;
+
+	void build(BroadPhaseSW *p_broadphase, const AABB *p_aabbs, const Vector3 *p_from, const Vector3 *p_to, int p_count, CollisionObjectSW **p_results, int *p_subindices, int p_max) {
+
+		int i = 0;
+
+		while (i < p_count) {
+
+			//grow the group while it stays small compared to the queries in it
+			AABB bounds = p_aabbs[i];
+			real_t extent = bounds.get_longest_axis_size();
+			int count = 1;
+
+			while (i + count < p_count && count < QUERY_BATCH_GROUP_MAX) {
+
+				const AABB &next = p_aabbs[i + count];
+				AABB merged = bounds.merge(next);
+				real_t merged_extent = MAX(extent, next.get_longest_axis_size());
+				if (merged.get_longest_axis_size() > merged_extent * 2.0)
+					break;
+				bounds = merged;
+				extent = merged_extent;
+				count++;
+			}
+
+			int amount;
+			if (count == 1 && p_from)
+				amount = p_broadphase->cull_segment(p_from[i], p_to[i], p_results, p_max, p_subindices);
+			else
+				amount = p_broadphase->cull_aabb(bounds, p_results, p_max, p_subindices);
+
+			if (count > 1 && amount >= p_max) {
+				//too crowded to share, the rest of the group is grouped again
+				count = 1;
+				if (p_from)
+					amount = p_broadphase->cull_segment(p_from[i], p_to[i], p_results, p_max, p_subindices);
+				else
+					amount = p_broadphase->cull_aabb(p_aabbs[i], p_results, p_max, p_subindices);
+			}
+
+			Group g;
+			g.from = i;
+			g.count = count;
+			g.candidate_ofs = candidates.size();
+			g.candidate_count = amount;
+			groups.push_back(g);
+
+			candidates.resize(g.candidate_ofs + amount);
+			candidate_shapes.resize(g.candidate_ofs + amount);
+			CollisionObjectSW **c = candidates.ptr() + g.candidate_ofs;
+			int *cs = candidate_shapes.ptr() + g.candidate_ofs;
+			for (int j = 0; j < amount; j++) {
+				c[j] = p_results[j];
+				cs[j] = p_subindices[j];
+			}
+
+			i += count;
+		}
+	}
+};
+
+struct _RayBatchSW {
+
+	const _QueryBatchSW *batch;
+	const Vector3 *from;
+	const Vector3 *to;
+	PhysicsDirectSpaceState::RayResult *results;
+	const Set<RID> *exclude;
+	uint32_t layer_mask;
+	uint32_t object_type_mask;
+
+	void process_group(uint32_t p_group, void *p_userdata) {
+
+		const _QueryBatchSW::Group &g = batch->groups[p_group];
+		CollisionObjectSW *const *objects = batch->candidates.ptr() + g.candidate_ofs;
+		const int *shapes = batch->candidate_shapes.ptr() + g.candidate_ofs;
+
+		for (int i = g.from; i < g.from + g.count; i++) {
+
+			if (_intersect_ray_candidates(from[i], to[i], objects, shapes, g.candidate_count, g.count > 1, *exclude, layer_mask, object_type_mask, false, results[i]))
+				continue;
+
+			results[i].position = Vector3();
+			results[i].normal = Vector3();
+			results[i].rid = RID();
+			results[i].collider_id = 0;
+			results[i].collider = NULL;
+			results[i].shape = -1;
+		}
+	}
+};
+
+struct _MotionBatchSW {
+
+	const _QueryBatchSW *batch;
+	ShapeSW *shape;
+	const Transform *xforms;
+	const Vector3 *motions;
+	float margin;
+	float *closest_safe;
+	float *closest_unsafe;
+	const Set<RID> *exclude;
+	uint32_t layer_mask;
+	uint32_t object_type_mask;
+
+	void process_group(uint32_t p_group, void *p_userdata) {
+
+		const _QueryBatchSW::Group &g = batch->groups[p_group];
+		CollisionObjectSW *const *objects = batch->candidates.ptr() + g.candidate_ofs;
+		const int *shapes = batch->candidate_shapes.ptr() + g.candidate_ofs;
+
+		for (int i = g.from; i < g.from + g.count; i++) {
+
+			if (!_cast_motion_candidates(shape, xforms[i], motions[i], margin, objects, shapes, g.candidate_count, g.count > 1, *exclude, layer_mask, object_type_mask, closest_safe[i], closest_unsafe[i], NULL)) {
+				//starts stuck
+				closest_safe[i] = 0;
+				closest_unsafe[i] = 0;
+			}
+		}
+	}
+};
+
+int PhysicsDirectSpaceStateSW::intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_count <= 0)
+		return 0;
+
+	Vector<AABB> aabbs;
+	aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		AABB &aabb = aabbs[i];
+		aabb.pos = p_from[i];
+		aabb.size = Vector3();
+		aabb.expand_to(p_to[i]);
+	}
+
+	//broadphase culls use the space buffers, so they run here, only the narrow phase is split
+	_QueryBatchSW batch;
+	batch.build(space->broadphase, aabbs.ptr(), p_from, p_to, p_count, space->intersection_query_results, space->intersection_query_subindex_results, SpaceSW::INTERSECTION_QUERY_MAX);
+
+	_RayBatchSW rays;
+	rays.batch = &batch;
+	rays.from = p_from;
+	rays.to = p_to;
+	rays.results = r_results;
+	rays.exclude = &p_exclude;
+	rays.layer_mask = p_layer_mask;
+	rays.object_type_mask = p_object_type_mask;
+
+	PhysicsServerSW::singletonsw->query_work_pool.do_work(batch.groups.size(), &rays, &_RayBatchSW::process_group, (void *)NULL);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+
+		if (r_results[i].shape == -1)
+			continue;
+		hits++;
+		if (r_results[i].collider_id != 0)
+			r_results[i].collider = ObjectDB::get_instance(r_results[i].collider_id);
+	}
+
+	return hits;
+}
+
+int PhysicsDirectSpaceStateSW::cast_motion_batch(const RID &p_shape, const Transform *p_xforms, const Vector3 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	ShapeSW *shape = PhysicsServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	if (p_count <= 0)
+		return 0;
+
+	Vector<AABB> aabbs;
+	aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		AABB aabb = p_xforms[i].xform(shape->get_aabb());
+		aabb = aabb.merge(AABB(aabb.pos + p_motions[i], aabb.size));
+		aabbs[i] = aabb.grow(p_margin);
+	}
+
+	_QueryBatchSW batch;
+	batch.build(space->broadphase, aabbs.ptr(), NULL, NULL, p_count, space->intersection_query_results, space->intersection_query_subindex_results, SpaceSW::INTERSECTION_QUERY_MAX);
+
+	_MotionBatchSW motions;
+	motions.batch = &batch;
+	motions.shape = shape;
+	motions.xforms = p_xforms;
+	motions.motions = p_motions;
+	motions.margin = p_margin;
+	motions.closest_safe = r_closest_safe;
+	motions.closest_unsafe = r_closest_unsafe;
+	motions.exclude = &p_exclude;
+	motions.layer_mask = p_layer_mask;
+	motions.object_type_mask = p_object_type_mask;
+
+	PhysicsServerSW::singletonsw->query_work_pool.do_work(batch.groups.size(), &motions, &_MotionBatchSW::process_group, (void *)NULL);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_closest_safe[i] < 1)
+			hits++;
+	}
+
+	return hits;
+}
+
 PhysicsDirectSpaceStateSW::PhysicsDirectSpaceStateSW() {
 
 	space = NULL;
@@ -580,6 +833,9 @@ void SpaceSW::setup() {
 		inertia_update_list.first()->self()->update_inertias();
 		inertia_update_list.remove(inertia_update_list.first());
 	}
+
+	//broadphases that defer pairing need objects moved since the last step paired before islands are built
+	broadphase->update();
 }
 
 void SpaceSW::update() {
@@ -644,6 +900,7 @@ SpaceSW::SpaceSW() {
 	active_objects = 0;
 	island_count = 0;
 	contact_debug_count = 0;
+	step_mutex = NULL;
 
 	locked = false;
 	contact_recycle_radius = 0.01;
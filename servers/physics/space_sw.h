@@ -52,6 +52,9 @@ public:
 	virtual bool collide_shape(RID p_shape, const Transform &p_shape_xform, float p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
 	virtual bool rest_info(RID p_shape, const Transform &p_shape_xform, float p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
 
+	virtual int intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+	virtual int cast_motion_batch(const RID &p_shape, const Transform *p_xforms, const Vector3 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+
 	PhysicsDirectSpaceStateSW();
 };
 
@@ -64,6 +67,7 @@ public:
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_BROAD_PHASE,
 		ELAPSED_TIME_MAX
 
 	};
@@ -117,6 +121,8 @@ private:
 	Vector<Vector3> contact_debug;
 	int contact_debug_count;
 
+	Mutex *step_mutex;
+
 	friend class PhysicsDirectSpaceStateSW;
 
 public:
@@ -177,6 +183,10 @@ public:
 
 	PhysicsDirectSpaceStateSW *get_direct_state();
 
+	//set by the stepper while islands are processed in parallel, guards state shared between islands
+	_FORCE_INLINE_ void set_step_mutex(Mutex *p_mutex) { step_mutex = p_mutex; }
+	_FORCE_INLINE_ Mutex *get_step_mutex() const { return step_mutex; }
+
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.empty(); }
 	_FORCE_INLINE_ void add_debug_contact(const Vector3 &p_contact) {
@@ -37,12 +37,19 @@ void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **
 	p_body->set_island_next(*p_island);
 	*p_island = p_body;
 
-	for (Map<ConstraintSW *, int>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
+	for (Map<ConstraintSW *, int, ConstraintOrderSW>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
 
 		ConstraintSW *c = (ConstraintSW *)E->key();
 		if (c->get_island_step() == _step)
 			continue; //already processed
 		c->set_island_step(_step);
+
+		if (c->get_body_count() == 0) {
+			//area pairs touch areas shared between islands and have nothing to solve, set them up apart
+			area_constraints.push_back(c);
+			continue;
+		}
+
 		c->set_island_next(*p_constraint_island);
 		*p_constraint_island = c;
 
@@ -67,45 +74,15 @@ void StepSW::_setup_island(ConstraintSW *p_island, float p_delta) {
 	}
 }
 
-void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, float p_delta) {
-
-	int at_priority = 1;
-
-	while (p_island) {
-
-		for (int i = 0; i < p_iterations; i++) {
-
-			ConstraintSW *ci = p_island;
-			while (ci) {
-				ci->solve(p_delta);
-				ci = ci->get_island_next();
-			}
-		}
-
-		at_priority++;
+void StepSW::_solve_island(ConstraintSW *p_island, int p_iterations, float p_delta, IslandSolverSW *p_solver) {
 
-		{
-			ConstraintSW *ci = p_island;
-			ConstraintSW *prev = NULL;
-			while (ci) {
-				if (ci->get_priority() < at_priority) {
-					if (prev) {
-						prev->set_island_next(ci->get_island_next()); //remove
-					} else {
-						p_island = ci->get_island_next();
-					}
-				} else {
-
-					prev = ci;
-				}
-
-				ci = ci->get_island_next();
-			}
-		}
-	}
+	//iterations run over packed body and contact arrays, results are copied back to the bodies at the end
+	p_solver->setup(p_island);
+	p_solver->solve(p_iterations, p_delta);
+	p_solver->finish();
 }
 
-void StepSW::_check_suspend(BodySW *p_island, float p_delta) {
+bool StepSW::_test_island_sleep(BodySW *p_island, float p_delta) {
 
 	bool can_sleep = true;
 
@@ -123,9 +100,14 @@ void StepSW::_check_suspend(BodySW *p_island, float p_delta) {
 		b = b->get_island_next();
 	}
 
+	return can_sleep;
+}
+
+void StepSW::_check_suspend(BodySW *p_island, bool p_can_sleep) {
+
 	//put all to sleep or wake up everyoen
 
-	b = p_island;
+	BodySW *b = p_island;
 	while (b) {
 
 		if (b->get_mode() == PhysicsServer::BODY_MODE_STATIC || b->get_mode() == PhysicsServer::BODY_MODE_KINEMATIC) {
@@ -135,13 +117,28 @@ void StepSW::_check_suspend(BodySW *p_island, float p_delta) {
 
 		bool active = b->is_active();
 
-		if (active == can_sleep)
-			b->set_active(!can_sleep);
+		if (active == p_can_sleep)
+			b->set_active(!p_can_sleep);
 
 		b = b->get_island_next();
 	}
 }
 
+void StepSW::_setup_island_job(uint32_t p_index, ConstraintSW **p_islands) {
+
+	_setup_island(p_islands[p_index], _delta);
+}
+
+void StepSW::_solve_island_job(uint32_t p_index, ConstraintSW **p_islands) {
+
+	_solve_island(p_islands[p_index], _iterations, _delta, &island_solvers[p_index]);
+}
+
+void StepSW::_test_island_sleep_job(uint32_t p_index, BodyIsland *p_islands) {
+
+	p_islands[p_index].can_sleep = _test_island_sleep(p_islands[p_index].bodies, _delta);
+}
+
 void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 
 	p_space->lock(); // can't access space during this
@@ -154,6 +151,7 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
+	uint64_t broad_phase_time = 0;
 
 	int active_count = 0;
 
@@ -173,36 +171,52 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 		profile_begtime = profile_endtime;
 	}
 
+	//moving shapes is where the octree and hash grid find pairs, so it's timed as broad phase
+	b = body_list->first();
+	while (b) {
+		b->self()->update_pending_shapes();
+		b = b->next();
+	}
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		broad_phase_time = profile_endtime - profile_begtime;
+		profile_begtime = profile_endtime;
+	}
+
 	/* GENERATE CONSTRAINT ISLANDS */
 
-	BodySW *island_list = NULL;
-	ConstraintSW *constraint_island_list = NULL;
-	b = body_list->first();
+	_delta = p_delta;
+	_iterations = p_iterations;
+
+	body_islands.clear();
+	constraint_islands.clear();
+	area_constraints.clear();
 
-	int island_count = 0;
+	b = body_list->first();
 
 	while (b) {
 		BodySW *body = b->self();
 
 		if (body->get_island_step() != _step) {
 
-			BodySW *island = NULL;
+			BodyIsland island;
+			island.bodies = NULL;
+			island.can_sleep = false;
+
 			ConstraintSW *constraint_island = NULL;
-			_populate_island(body, &island, &constraint_island);
+			_populate_island(body, &island.bodies, &constraint_island);
 
-			island->set_island_list_next(island_list);
-			island_list = island;
+			body_islands.push_back(island);
 
 			if (constraint_island) {
-				constraint_island->set_island_list_next(constraint_island_list);
-				constraint_island_list = constraint_island;
-				island_count++;
+				constraint_islands.push_back(constraint_island);
 			}
 		}
 		b = b->next();
 	}
 
-	p_space->set_island_count(island_count);
+	p_space->set_island_count(constraint_islands.size());
 
 	const SelfList<AreaSW>::List &aml = p_space->get_moved_area_list();
 
@@ -213,9 +227,7 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 			if (c->get_island_step() == _step)
 				continue;
 			c->set_island_step(_step);
-			c->set_island_next(NULL);
-			c->set_island_list_next(constraint_island_list);
-			constraint_island_list = c;
+			area_constraints.push_back(c);
 		}
 		p_space->area_remove_from_moved_list((SelfList<AreaSW> *)aml.first()); //faster to remove here
 	}
@@ -229,15 +241,15 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 	//	print_line("island count: "+itos(island_count)+" active count: "+itos(active_count));
 	/* SETUP CONSTRAINT ISLANDS */
 
-	{
-		ConstraintSW *ci = constraint_island_list;
-		while (ci) {
-
-			_setup_island(ci, p_delta);
-			ci = ci->get_island_list_next();
-		}
+	for (int i = 0; i < area_constraints.size(); i++) {
+		area_constraints[i]->setup(p_delta);
 	}
 
+	//islands don't share any dynamic body, so they can be processed in parallel
+	p_space->set_step_mutex(step_mutex);
+
+	work_pool.do_work(constraint_islands.size(), this, &StepSW::_setup_island_job, constraint_islands.ptr());
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -246,15 +258,16 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		ConstraintSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
+	//solvers are kept between steps so their buffers are reused, resize before the jobs run as it's not thread safe
+	if (island_solvers.size() < constraint_islands.size()) {
+		island_solvers.resize(constraint_islands.size());
 	}
 
+	//iterating each island separatedly improves cache efficiency
+	work_pool.do_work(constraint_islands.size(), this, &StepSW::_solve_island_job, constraint_islands.ptr());
+
+	p_space->set_step_mutex(NULL);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -270,29 +283,77 @@ void StepSW::step(SpaceSW *p_space, float p_delta, int p_iterations) {
 		b = n;
 	}
 
+	uint64_t move_begtime = OS::get_singleton()->get_ticks_usec();
+
+	b = body_list->first();
+	while (b) {
+		b->self()->update_pending_shapes();
+		b = b->next();
+	}
+
+	uint64_t move_endtime = OS::get_singleton()->get_ticks_usec();
+	broad_phase_time += move_endtime - move_begtime;
+
 	/* SLEEP / WAKE UP ISLANDS */
 
-	{
-		BodySW *bi = island_list;
-		while (bi) {
+	work_pool.do_work(body_islands.size(), this, &StepSW::_test_island_sleep_job, body_islands.ptr());
 
-			_check_suspend(bi, p_delta);
-			bi = bi->get_island_list_next();
-		}
+	//changing the active state modifies the space lists, so it's done serially
+	for (int i = 0; i < body_islands.size(); i++) {
+		_check_suspend(body_islands[i].bodies, body_islands[i].can_sleep);
 	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime - (move_endtime - move_begtime));
 		profile_begtime = profile_endtime;
 	}
 
 	p_space->update();
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_BROAD_PHASE, profile_endtime - profile_begtime + broad_phase_time);
+		//profile_begtime=profile_endtime;
+	}
 	p_space->unlock();
 	_step++;
 }
 
+void StepSW::set_thread_count(int p_thread_count) {
+
+	work_pool.finish();
+	if (step_mutex) {
+		memdelete(step_mutex);
+		step_mutex = NULL;
+	}
+
+	if (p_thread_count == 0)
+		return;
+
+	work_pool.init(p_thread_count);
+	if (work_pool.get_thread_count() > 0) {
+		step_mutex = Mutex::create();
+	}
+}
+
+int StepSW::get_thread_count() const {
+
+	return work_pool.get_thread_count();
+}
+
 StepSW::StepSW() {
 
 	_step = 1;
+	_delta = 0;
+	_iterations = 0;
+	step_mutex = NULL;
+}
+
+StepSW::~StepSW() {
+
+	work_pool.finish();
+	if (step_mutex) {
+		memdelete(step_mutex);
+	}
 }
@@ -29,20 +29,48 @@
 #ifndef STEP_SW_H
 #define STEP_SW_H
 
+#include "island_solver_sw.h"
+#include "os/thread_work_pool.h"
 #include "space_sw.h"
 
 class StepSW {
 
 	uint64_t _step;
 
+	float _delta;
+	int _iterations;
+
+	ThreadWorkPool work_pool;
+	Mutex *step_mutex;
+
+	struct BodyIsland {
+
+		BodySW *bodies;
+		bool can_sleep;
+	};
+
+	Vector<BodyIsland> body_islands;
+	Vector<ConstraintSW *> constraint_islands;
+	Vector<ConstraintSW *> area_constraints;
+	Vector<IslandSolverSW> island_solvers;
+
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
 	void _setup_island(ConstraintSW *p_island, float p_delta);
-	void _solve_island(ConstraintSW *p_island, int p_iterations, float p_delta);
-	void _check_suspend(BodySW *p_island, float p_delta);
+	void _solve_island(ConstraintSW *p_island, int p_iterations, float p_delta, IslandSolverSW *p_solver);
+	bool _test_island_sleep(BodySW *p_island, float p_delta);
+	void _check_suspend(BodySW *p_island, bool p_can_sleep);
+
+	void _setup_island_job(uint32_t p_index, ConstraintSW **p_islands);
+	void _solve_island_job(uint32_t p_index, ConstraintSW **p_islands);
+	void _test_island_sleep_job(uint32_t p_index, BodyIsland *p_islands);
 
 public:
+	void set_thread_count(int p_thread_count);
+	int get_thread_count() const;
+
 	void step(SpaceSW *p_space, float p_delta, int p_iterations);
 	StepSW();
+	~StepSW();
 };
 
 #endif // STEP__SW_H
@@ -107,6 +107,7 @@ void Body2DSW::set_active(bool p_active) {
 		return;
 
 	active = p_active;
+	_set_sleeping(!p_active);
 	if (!p_active) {
 		if (get_space())
 			get_space()->body_remove_from_active_list(&active_list);
@@ -118,17 +119,6 @@ void Body2DSW::set_active(bool p_active) {
 
 		//still_time=0;
 	}
-	/*
-	if (!space)
-		return;
-
-	for(int i=0;i<get_shape_count();i++) {
-		Shape &s=shapes[i];
-		if (s.bpid>0) {
-			get_space()->get_broadphase()->set_active(s.bpid,active);
-		}
-	}
-*/
 }
 
 void Body2DSW::set_param(Physics2DServer::BodyParameter p_param, float p_value) {
@@ -508,7 +498,8 @@ void Body2DSW::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		shapes_pending = true;
+		shapes_pending_motion = motion;
 	}
 
 	// damp_area=NULL; // clear the area, so it is set in the next frame
@@ -539,18 +530,22 @@ void Body2DSW::integrate_velocities(real_t p_step) {
 	real_t angle = get_transform().get_rotation() - total_angular_velocity * p_step;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
 
-	_set_transform(Matrix32(angle, pos), continuous_cd_mode == Physics2DServer::CCD_MODE_DISABLED);
+	_set_transform(Matrix32(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != Physics2DServer::CCD_MODE_DISABLED)
 		new_transform = get_transform();
+	else {
+		shapes_pending = true;
+		shapes_pending_motion = Vector2();
+	}
 
 	//_update_inertia_tensor();
 }
 
 void Body2DSW::wakeup_neighbours() {
 
-	for (Map<Constraint2DSW *, int>::Element *E = constraint_map.front(); E; E = E->next()) {
+	for (Map<Constraint2DSW *, int, Constraint2DOrderSW>::Element *E = constraint_map.front(); E; E = E->next()) {
 
 		const Constraint2DSW *c = E->key();
 		Body2DSW **n = c->get_body_ptr();
@@ -635,6 +630,13 @@ void Body2DSW::set_force_integration_callback(ObjectID p_id, const StringName &p
 	}
 }
 
+uint64_t Constraint2DSW::creation_count = 0;
+
+bool Constraint2DOrderSW::operator()(const Constraint2DSW *p_a, const Constraint2DSW *p_b) const {
+
+	return p_a->get_creation_id() < p_b->get_creation_id();
+}
+
 Body2DSW::Body2DSW()
 	: CollisionObject2DSW(TYPE_BODY), active_list(this), inertia_update_list(this), direct_state_query_list(this) {
 
@@ -653,6 +655,7 @@ Body2DSW::Body2DSW()
 	island_step = 0;
 	island_next = NULL;
 	island_list_next = NULL;
+	solver_index = -1;
 	_set_static(false);
 	first_time_kinematic = false;
 	linear_damp = -1;
@@ -664,6 +667,7 @@ Body2DSW::Body2DSW()
 	using_one_way_cache = false;
 	one_way_collision_max_depth = 0.1;
 	first_integration = false;
+	shapes_pending = false;
 
 	still_time = 0;
 	continuous_cd_mode = Physics2DServer::CCD_MODE_DISABLED;
@@ -35,6 +35,11 @@
 
 class Constraint2DSW;
 
+//sorts constraints by creation, so island order doesn't depend on where they were allocated
+struct Constraint2DOrderSW {
+	bool operator()(const Constraint2DSW *p_a, const Constraint2DSW *p_b) const;
+};
+
 class Body2DSW : public CollisionObject2DSW {
 
 	Physics2DServer::BodyMode mode;
@@ -80,12 +85,14 @@ class Body2DSW : public CollisionObject2DSW {
 	bool can_sleep;
 	bool first_time_kinematic;
 	bool first_integration;
+	bool shapes_pending; //moved by the step after integrating, so it can time broad phase moves apart
+	Vector2 shapes_pending_motion;
 	bool using_one_way_cache;
 	void _update_inertia();
 	virtual void _shapes_changed();
 	Matrix32 new_transform;
 
-	Map<Constraint2DSW *, int> constraint_map;
+	Map<Constraint2DSW *, int, Constraint2DOrderSW> constraint_map;
 
 	struct AreaCMP {
 
@@ -130,6 +137,7 @@ class Body2DSW : public CollisionObject2DSW {
 	uint64_t island_step;
 	Body2DSW *island_next;
 	Body2DSW *island_list_next;
+	int solver_index; //slot in the packed island solver while it runs, -1 otherwise
 
 	_FORCE_INLINE_ void _compute_area_gravity_and_dampenings(const Area2DSW *p_area);
 
@@ -181,9 +189,12 @@ public:
 	_FORCE_INLINE_ Body2DSW *get_island_list_next() const { return island_list_next; }
 	_FORCE_INLINE_ void set_island_list_next(Body2DSW *p_next) { island_list_next = p_next; }
 
+	_FORCE_INLINE_ int get_solver_index() const { return solver_index; }
+	_FORCE_INLINE_ void set_solver_index(int p_index) { solver_index = p_index; }
+
 	_FORCE_INLINE_ void add_constraint(Constraint2DSW *p_constraint, int p_pos) { constraint_map[p_constraint] = p_pos; }
 	_FORCE_INLINE_ void remove_constraint(Constraint2DSW *p_constraint) { constraint_map.erase(p_constraint); }
-	const Map<Constraint2DSW *, int> &get_constraint_map() const { return constraint_map; }
+	const Map<Constraint2DSW *, int, Constraint2DOrderSW> &get_constraint_map() const { return constraint_map; }
 
 	_FORCE_INLINE_ void set_omit_force_integration(bool p_omit_force_integration) { omit_force_integration = p_omit_force_integration; }
 	_FORCE_INLINE_ bool get_omit_force_integration() const { return omit_force_integration; }
@@ -202,12 +213,19 @@ public:
 
 	_FORCE_INLINE_ void apply_impulse(const Vector2 &p_offset, const Vector2 &p_impulse) {
 
+		//static and kinematic bodies don't respond to impulses, and joints in islands solved in parallel can share them, so don't write them
+		if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+			return;
+
 		linear_velocity += p_impulse * _inv_mass;
 		angular_velocity += _inv_inertia * p_offset.cross(p_impulse);
 	}
 
 	_FORCE_INLINE_ void apply_bias_impulse(const Vector2 &p_pos, const Vector2 &p_j) {
 
+		if (mode <= Physics2DServer::BODY_MODE_KINEMATIC)
+			return;
+
 		biased_linear_velocity += p_j * _inv_mass;
 		biased_angular_velocity += _inv_inertia * p_pos.cross(p_j);
 	}
@@ -271,6 +289,17 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	_FORCE_INLINE_ void update_pending_shapes() {
+
+		if (!shapes_pending)
+			return;
+		shapes_pending = false;
+		if (shapes_pending_motion == Vector2())
+			_update_shapes();
+		else
+			_update_shapes_with_motion(shapes_pending_motion);
+	}
+
 	_FORCE_INLINE_ Vector2 get_motion() const {
 
 		if (mode > Physics2DServer::BODY_MODE_KINEMATIC) {
@@ -28,6 +28,7 @@
 /*************************************************************************/
 #include "body_pair_2d_sw.h"
 #include "collision_solver_2d_sw.h"
+#include "island_solver_2d_sw.h"
 #include "space_2d_sw.h"
 
 #define POSITION_CORRECTION
@@ -361,6 +362,7 @@ bool BodyPair2DSW::setup(float p_step) {
 		c.active = true;
 #ifdef DEBUG_ENABLED
 		if (space->is_debugging_contacts()) {
+			MutexLock lock(space->get_step_mutex());
 			space->add_debug_contact(global_A + offset_A);
 			space->add_debug_contact(global_B + offset_A);
 		}
@@ -373,6 +375,9 @@ bool BodyPair2DSW::setup(float p_step) {
 
 		if (gather_A | gather_B) {
 
+			//static bodies can be shared with other islands
+			MutexLock lock(space->get_step_mutex());
+
 			//Vector2 crB( -B->get_angular_velocity() * c.rB.y, B->get_angular_velocity() * c.rB.x );
 
 			global_A += offset_A;
@@ -494,6 +499,66 @@ void BodyPair2DSW::solve(float p_step) {
 	}
 }
 
+bool BodyPair2DSW::pack(IslandSolver2DSW *p_solver) {
+
+	if (!collided)
+		return true;
+
+	int active_count = 0;
+	for (int i = 0; i < contact_count; i++) {
+		if (contacts[i].active)
+			active_count++;
+	}
+
+	if (active_count == 0)
+		return true;
+
+	int body_A = p_solver->add_body(A);
+	int body_B = p_solver->add_body(B);
+	real_t friction = A->get_friction() * B->get_friction();
+
+	IslandSolver2DSW::Contact *sc = p_solver->add_contacts(active_count);
+
+	for (int i = 0; i < contact_count; i++) {
+
+		const Contact &c = contacts[i];
+		if (!c.active)
+			continue;
+
+		sc->body_A = body_A;
+		sc->body_B = body_B;
+		sc->normal = c.normal;
+		sc->rA = c.rA;
+		sc->rB = c.rB;
+		sc->mass_normal = c.mass_normal;
+		sc->mass_tangent = c.mass_tangent;
+		sc->bias = c.bias;
+		sc->bounce = c.bounce;
+		sc->friction = friction;
+		sc->acc_normal_impulse = c.acc_normal_impulse;
+		sc->acc_tangent_impulse = c.acc_tangent_impulse;
+		sc->acc_bias_impulse = c.acc_bias_impulse;
+		sc++;
+	}
+
+	return true;
+}
+
+void BodyPair2DSW::unpack(const IslandSolver2DSW *p_solver, int p_from) {
+
+	for (int i = 0; i < contact_count; i++) {
+
+		Contact &c = contacts[i];
+		if (!c.active)
+			continue;
+
+		const IslandSolver2DSW::Contact &sc = p_solver->get_contact(p_from++);
+		c.acc_normal_impulse = sc.acc_normal_impulse;
+		c.acc_tangent_impulse = sc.acc_tangent_impulse;
+		c.acc_bias_impulse = sc.acc_bias_impulse;
+	}
+}
+
 BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B)
 	: Constraint2DSW(_arr, 2) {
 
@@ -87,6 +87,9 @@ public:
 	bool setup(float p_step);
 	void solve(float p_step);
 
+	bool pack(IslandSolver2DSW *p_solver);
+	void unpack(const IslandSolver2DSW *p_solver, int p_from);
+
 	BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B);
 	~BodyPair2DSW();
 };
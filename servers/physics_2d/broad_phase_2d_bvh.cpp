@@ -0,0 +1,763 @@
+/*************************************************************************/
+/*  broad_phase_2d_bvh.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "broad_phase_2d_bvh.h"
+#include "collision_object_2d_sw.h"
+#include "globals.h"
+
+#define BVH_STACK_SIZE 128
+//leaves are extended this many times the last displacement ahead, so fast movers reinsert less often
+#define BVH_DISPLACEMENT_MULTIPLIER 2.0
+
+int BroadPhase2DBVH::_alloc_node() {
+
+	if (free_node == -1) {
+		free_node = nodes.size();
+		int new_size = MAX(16, nodes.size() * 2);
+		nodes.resize(new_size);
+		Node *n = nodes.ptr();
+		for (int i = free_node; i < new_size; i++) {
+			n[i].parent = i + 1 < new_size ? i + 1 : -1;
+			n[i].height = -1;
+		}
+	}
+
+	Node *n = nodes.ptr();
+	int idx = free_node;
+	free_node = n[idx].parent;
+	n[idx].parent = -1;
+	n[idx].children[0] = -1;
+	n[idx].children[1] = -1;
+	n[idx].height = 0;
+	n[idx].element = 0;
+	return idx;
+}
+
+void BroadPhase2DBVH::_free_node(int p_node) {
+
+	Node *n = nodes.ptr();
+	n[p_node].parent = free_node;
+	n[p_node].height = -1;
+	free_node = p_node;
+}
+
+int BroadPhase2DBVH::_balance(int p_node, int p_tree) {
+
+	//AVL style rotation, lifts the taller grandchild when the children heights differ by more than one
+
+	Node *n = nodes.ptr();
+	Node *A = &n[p_node];
+
+	if (A->is_leaf() || A->height < 2)
+		return p_node;
+
+	int iB = A->children[0];
+	int iC = A->children[1];
+	Node *B = &n[iB];
+	Node *C = &n[iC];
+
+	int balance = C->height - B->height;
+
+	if (balance > 1) {
+
+		//rotate C up
+		int iF = C->children[0];
+		int iG = C->children[1];
+		Node *F = &n[iF];
+		Node *G = &n[iG];
+
+		C->children[0] = p_node;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		if (C->parent != -1) {
+			Node *P = &n[C->parent];
+			P->children[P->children[0] == p_node ? 0 : 1] = iC;
+		} else {
+			root[p_tree] = iC;
+		}
+
+		if (F->height > G->height) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			G->parent = p_node;
+			A->aabb = B->aabb.merge(G->aabb);
+			C->aabb = A->aabb.merge(F->aabb);
+			A->height = 1 + MAX(B->height, G->height);
+			C->height = 1 + MAX(A->height, F->height);
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			F->parent = p_node;
+			A->aabb = B->aabb.merge(F->aabb);
+			C->aabb = A->aabb.merge(G->aabb);
+			A->height = 1 + MAX(B->height, F->height);
+			C->height = 1 + MAX(A->height, G->height);
+		}
+
+		return iC;
+	}
+
+	if (balance < -1) {
+
+		//rotate B up
+		int iD = B->children[0];
+		int iE = B->children[1];
+		Node *D = &n[iD];
+		Node *E = &n[iE];
+
+		B->children[0] = p_node;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		if (B->parent != -1) {
+			Node *P = &n[B->parent];
+			P->children[P->children[0] == p_node ? 0 : 1] = iB;
+		} else {
+			root[p_tree] = iB;
+		}
+
+		if (D->height > E->height) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			E->parent = p_node;
+			A->aabb = C->aabb.merge(E->aabb);
+			B->aabb = A->aabb.merge(D->aabb);
+			A->height = 1 + MAX(C->height, E->height);
+			B->height = 1 + MAX(A->height, D->height);
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			D->parent = p_node;
+			A->aabb = C->aabb.merge(D->aabb);
+			B->aabb = A->aabb.merge(E->aabb);
+			A->height = 1 + MAX(C->height, D->height);
+			B->height = 1 + MAX(A->height, E->height);
+		}
+
+		return iB;
+	}
+
+	return p_node;
+}
+
+void BroadPhase2DBVH::_fix_upwards(int p_node, int p_tree) {
+
+	int idx = p_node;
+	while (idx != -1) {
+
+		idx = _balance(idx, p_tree);
+
+		Node *n = nodes.ptr();
+		Node &node = n[idx];
+		const Node &c0 = n[node.children[0]];
+		const Node &c1 = n[node.children[1]];
+		node.height = 1 + MAX(c0.height, c1.height);
+		node.aabb = c0.aabb.merge(c1.aabb);
+
+		idx = node.parent;
+	}
+}
+
+void BroadPhase2DBVH::_insert_leaf(int p_leaf, int p_tree) {
+
+	if (root[p_tree] == -1) {
+		root[p_tree] = p_leaf;
+		nodes[p_leaf].parent = -1;
+		return;
+	}
+
+	//find the best sibling, descending while it's cheaper than pairing with the current node
+	const Node *n = nodes.ptr();
+	Rect2 leaf_aabb = n[p_leaf].aabb;
+	int idx = root[p_tree];
+
+	while (!n[idx].is_leaf()) {
+
+		const Node &node = n[idx];
+
+		real_t area = _cost(node.aabb);
+		real_t combined_area = _cost(node.aabb.merge(leaf_aabb));
+
+		real_t cost = 2.0 * combined_area;
+		real_t inheritance_cost = 2.0 * (combined_area - area);
+
+		real_t child_cost[2];
+		for (int i = 0; i < 2; i++) {
+			const Node &child = n[node.children[i]];
+			real_t merged = _cost(child.aabb.merge(leaf_aabb));
+			child_cost[i] = (child.is_leaf() ? merged : merged - _cost(child.aabb)) + inheritance_cost;
+		}
+
+		if (cost < child_cost[0] && cost < child_cost[1])
+			break;
+
+		idx = child_cost[0] < child_cost[1] ? node.children[0] : node.children[1];
+	}
+
+	int sibling = idx;
+	int new_parent = _alloc_node(); //may reallocate
+
+	Node *w = nodes.ptr();
+	int old_parent = w[sibling].parent;
+
+	w[new_parent].parent = old_parent;
+	w[new_parent].aabb = leaf_aabb.merge(w[sibling].aabb);
+	w[new_parent].height = w[sibling].height + 1;
+	w[new_parent].children[0] = sibling;
+	w[new_parent].children[1] = p_leaf;
+	w[sibling].parent = new_parent;
+	w[p_leaf].parent = new_parent;
+
+	if (old_parent != -1) {
+		Node &op = w[old_parent];
+		op.children[op.children[0] == sibling ? 0 : 1] = new_parent;
+	} else {
+		root[p_tree] = new_parent;
+	}
+
+	_fix_upwards(old_parent, p_tree);
+}
+
+void BroadPhase2DBVH::_remove_leaf(int p_leaf, int p_tree) {
+
+	if (p_leaf == root[p_tree]) {
+		root[p_tree] = -1;
+		return;
+	}
+
+	Node *n = nodes.ptr();
+	int parent = n[p_leaf].parent;
+	int grand_parent = n[parent].parent;
+	int sibling = n[parent].children[0] == p_leaf ? n[parent].children[1] : n[parent].children[0];
+
+	_free_node(parent);
+
+	if (grand_parent != -1) {
+		Node &gp = n[grand_parent];
+		gp.children[gp.children[0] == parent ? 0 : 1] = sibling;
+		n[sibling].parent = grand_parent;
+		_fix_upwards(grand_parent, p_tree);
+	} else {
+		root[p_tree] = sibling;
+		n[sibling].parent = -1;
+	}
+
+	n[p_leaf].parent = -1;
+}
+
+void BroadPhase2DBVH::_update_tree(ID p_id) {
+
+	Element &e = elements[p_id - 1];
+	int tree = _get_tree(e);
+	if (e.tree == tree)
+		return;
+
+	if (e.node != -1) {
+		//the fat box is kept as is, the leaf only changes tree
+		_remove_leaf(e.node, e.tree);
+		_insert_leaf(e.node, tree);
+	}
+	e.tree = tree;
+}
+
+int BroadPhase2DBVH::_pair_find(uint64_t p_key) const {
+
+	uint32_t mask = pair_table_size - 1;
+	uint32_t idx = _hash_key(p_key) & mask;
+
+	while (pair_table[idx].key) {
+		if (pair_table[idx].key == p_key)
+			return idx;
+		idx = (idx + 1) & mask;
+	}
+
+	return -1;
+}
+
+void BroadPhase2DBVH::_pair_table_resize(uint32_t p_size) {
+
+	Pair *old_table = pair_table;
+	uint32_t old_size = pair_table_size;
+
+	pair_table = (Pair *)memalloc(sizeof(Pair) * p_size);
+	pair_table_size = p_size;
+	for (uint32_t i = 0; i < p_size; i++) {
+		pair_table[i].key = 0;
+		pair_table[i].ud = NULL;
+	}
+
+	if (!old_table)
+		return;
+
+	uint32_t mask = pair_table_size - 1;
+	for (uint32_t i = 0; i < old_size; i++) {
+
+		if (!old_table[i].key)
+			continue;
+		uint32_t idx = _hash_key(old_table[i].key) & mask;
+		while (pair_table[idx].key)
+			idx = (idx + 1) & mask;
+		pair_table[idx] = old_table[i];
+	}
+
+	memfree(old_table);
+}
+
+void BroadPhase2DBVH::_pair_insert(uint64_t p_key, void *p_ud) {
+
+	//keep the load factor under one half, so probe chains stay short
+	if ((pair_count + 1) * 2 > pair_table_size)
+		_pair_table_resize(pair_table_size * 2);
+
+	uint32_t mask = pair_table_size - 1;
+	uint32_t idx = _hash_key(p_key) & mask;
+	while (pair_table[idx].key)
+		idx = (idx + 1) & mask;
+
+	pair_table[idx].key = p_key;
+	pair_table[idx].ud = p_ud;
+	pair_count++;
+}
+
+void BroadPhase2DBVH::_pair_erase(int p_index) {
+
+	//backward shift deletion, keeps the probe chains intact without tombstones
+	uint32_t mask = pair_table_size - 1;
+	uint32_t hole = p_index;
+	uint32_t idx = p_index;
+
+	while (true) {
+
+		idx = (idx + 1) & mask;
+		if (!pair_table[idx].key)
+			break;
+
+		uint32_t home = _hash_key(pair_table[idx].key) & mask;
+		//the entry can move back to the hole unless its home lies cyclically in (hole,idx]
+		bool stays = hole <= idx ? (hole < home && home <= idx) : (hole < home || home <= idx);
+		if (!stays) {
+			pair_table[hole] = pair_table[idx];
+			hole = idx;
+		}
+	}
+
+	pair_table[hole].key = 0;
+	pair_table[hole].ud = NULL;
+	pair_count--;
+}
+
+void BroadPhase2DBVH::_pair(ID p_a, ID p_b) {
+
+	Element *e = elements.ptr();
+	Element &A = e[p_a - 1];
+	Element &B = e[p_b - 1];
+
+	void *ud = NULL;
+	if (pair_callback)
+		ud = pair_callback(A.owner, A.subindex, B.owner, B.subindex, pair_userdata);
+
+	_pair_insert(PairKey(p_a, p_b).key, ud);
+	A.paired.push_back(p_b);
+	B.paired.push_back(p_a);
+}
+
+void BroadPhase2DBVH::_unpair(ID p_a, ID p_b) {
+
+	int idx = _pair_find(PairKey(p_a, p_b).key);
+	ERR_FAIL_COND(idx == -1);
+
+	Element *e = elements.ptr();
+	Element &A = e[p_a - 1];
+	Element &B = e[p_b - 1];
+
+	if (unpair_callback)
+		unpair_callback(A.owner, A.subindex, B.owner, B.subindex, pair_table[idx].ud, unpair_userdata);
+
+	_pair_erase(idx);
+	A.paired.erase(p_b);
+	B.paired.erase(p_a);
+}
+
+void BroadPhase2DBVH::_mark_moved(ID p_id) {
+
+	Element &e = elements[p_id - 1];
+	if (e.moved)
+		return;
+	e.moved = true;
+	move_buffer.push_back(p_id);
+}
+
+BroadPhase2DSW::ID BroadPhase2DBVH::create(CollisionObject2DSW *p_object, int p_subindex) {
+
+	ERR_FAIL_COND_V(!p_object, 0);
+
+	ID id;
+	if (free_elements.size()) {
+		id = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+		elements.resize(elements.size() + 1);
+		id = elements.size();
+	}
+
+	Element &e = elements[id - 1];
+	e.owner = p_object;
+	e._static = false;
+	e.active = true;
+	e.moved = false;
+	e.aabb = Rect2();
+	e.subindex = p_subindex;
+	e.node = -1; //enters the tree on the first move
+	e.tree = TREE_DYNAMIC;
+	e.paired.clear();
+
+	return id;
+}
+
+void BroadPhase2DBVH::move(ID p_id, const Rect2 &p_aabb) {
+
+	ERR_FAIL_COND(p_id == 0 || p_id > (ID)elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_COND(!e.owner);
+
+	if (e.node != -1 && e.aabb == p_aabb)
+		return;
+
+	Vector2 displacement = p_aabb.pos - e.aabb.pos;
+	e.aabb = p_aabb;
+	_mark_moved(p_id);
+
+	if (e.node == -1) {
+
+		int leaf = _alloc_node();
+		Node &node = nodes[leaf];
+		node.aabb = p_aabb.grow(margin);
+		node.element = p_id;
+		elements[p_id - 1].node = leaf;
+		_insert_leaf(leaf, elements[p_id - 1].tree);
+		return;
+	}
+
+	int leaf = e.node;
+	if (nodes[leaf].aabb.encloses(p_aabb))
+		return; //still inside the fat box, nothing to do with the tree
+
+	_remove_leaf(leaf, e.tree);
+
+	Rect2 fat = p_aabb.grow(margin);
+	displacement *= BVH_DISPLACEMENT_MULTIPLIER;
+	for (int i = 0; i < 2; i++) {
+		if (displacement[i] < 0) {
+			fat.pos[i] += displacement[i];
+			fat.size[i] -= displacement[i];
+		} else {
+			fat.size[i] += displacement[i];
+		}
+	}
+
+	nodes[leaf].aabb = fat;
+	_insert_leaf(leaf, e.tree);
+}
+
+void BroadPhase2DBVH::set_static(ID p_id, bool p_static) {
+
+	ERR_FAIL_COND(p_id == 0 || p_id > (ID)elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_COND(!e.owner);
+
+	if (e._static == p_static)
+		return;
+
+	e._static = p_static;
+	_update_tree(p_id);
+	if (e.node != -1)
+		_mark_moved(p_id); //pairs must be checked again
+}
+
+void BroadPhase2DBVH::set_active(ID p_id, bool p_active) {
+
+	ERR_FAIL_COND(p_id == 0 || p_id > (ID)elements.size());
+	Element &e = elements[p_id - 1];
+	ERR_FAIL_COND(!e.owner);
+
+	if (e.active == p_active)
+		return;
+
+	//sleeping objects are parked in their own tree, pairing rules don't change so there is nothing to check again
+	e.active = p_active;
+	_update_tree(p_id);
+}
+
+void BroadPhase2DBVH::remove(ID p_id) {
+
+	ERR_FAIL_COND(p_id == 0 || p_id > (ID)elements.size());
+	ERR_FAIL_COND(!elements[p_id - 1].owner);
+
+	//unpair must be done immediately on removal to avoid potential invalid pointers
+	while (elements[p_id - 1].paired.size()) {
+		_unpair(p_id, elements[p_id - 1].paired[0]);
+	}
+
+	Element &e = elements[p_id - 1];
+
+	if (e.node != -1) {
+		_remove_leaf(e.node, e.tree);
+		_free_node(e.node);
+	}
+
+	e.owner = NULL;
+	e.moved = false; //stale move buffer entries skip free elements
+	e.node = -1;
+	free_elements.push_back(p_id);
+}
+
+CollisionObject2DSW *BroadPhase2DBVH::get_object(ID p_id) const {
+
+	ERR_FAIL_COND_V(p_id == 0 || p_id > (ID)elements.size(), NULL);
+	const Element &e = elements[p_id - 1];
+	ERR_FAIL_COND_V(!e.owner, NULL);
+	return e.owner;
+}
+bool BroadPhase2DBVH::is_static(ID p_id) const {
+
+	ERR_FAIL_COND_V(p_id == 0 || p_id > (ID)elements.size(), false);
+	const Element &e = elements[p_id - 1];
+	ERR_FAIL_COND_V(!e.owner, false);
+	return e._static;
+}
+int BroadPhase2DBVH::get_subindex(ID p_id) const {
+
+	ERR_FAIL_COND_V(p_id == 0 || p_id > (ID)elements.size(), -1);
+	const Element &e = elements[p_id - 1];
+	ERR_FAIL_COND_V(!e.owner, -1);
+	return e.subindex;
+}
+
+int BroadPhase2DBVH::cull_segment(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices) {
+
+	if (p_max_results <= 0)
+		return 0;
+
+	const Node *n = nodes.ptr();
+	const Element *e = elements.ptr();
+
+	int stack[BVH_STACK_SIZE];
+	int sp = 0;
+	int rc = 0;
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (root[i] != -1)
+			stack[sp++] = root[i];
+	}
+
+	while (sp) {
+
+		const Node &node = n[stack[--sp]];
+
+		if (!node.aabb.intersects_segment(p_from, p_to))
+			continue;
+
+		if (node.is_leaf()) {
+
+			const Element &elem = e[node.element - 1];
+			if (!elem.aabb.intersects_segment(p_from, p_to))
+				continue;
+
+			p_results[rc] = elem.owner;
+			if (p_result_indices)
+				p_result_indices[rc] = elem.subindex;
+			rc++;
+			if (rc >= p_max_results)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > BVH_STACK_SIZE);
+			stack[sp++] = node.children[0];
+			stack[sp++] = node.children[1];
+		}
+	}
+
+	return rc;
+}
+
+int BroadPhase2DBVH::cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p_results, int p_max_results, int *p_result_indices) {
+
+	if (p_max_results <= 0)
+		return 0;
+
+	const Node *n = nodes.ptr();
+	const Element *e = elements.ptr();
+
+	int stack[BVH_STACK_SIZE];
+	int sp = 0;
+	int rc = 0;
+	for (int i = 0; i < TREE_MAX; i++) {
+		if (root[i] != -1)
+			stack[sp++] = root[i];
+	}
+
+	while (sp) {
+
+		const Node &node = n[stack[--sp]];
+
+		if (!node.aabb.intersects(p_aabb))
+			continue;
+
+		if (node.is_leaf()) {
+
+			const Element &elem = e[node.element - 1];
+			if (!elem.aabb.intersects(p_aabb))
+				continue;
+
+			p_results[rc] = elem.owner;
+			if (p_result_indices)
+				p_result_indices[rc] = elem.subindex;
+			rc++;
+			if (rc >= p_max_results)
+				break;
+		} else {
+
+			ERR_CONTINUE(sp + 2 > BVH_STACK_SIZE);
+			stack[sp++] = node.children[0];
+			stack[sp++] = node.children[1];
+		}
+	}
+
+	return rc;
+}
+
+void BroadPhase2DBVH::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
+
+	pair_callback = p_pair_callback;
+	pair_userdata = p_userdata;
+}
+void BroadPhase2DBVH::set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) {
+
+	unpair_callback = p_unpair_callback;
+	unpair_userdata = p_userdata;
+}
+
+void BroadPhase2DBVH::update() {
+
+	//nothing below adds elements or nodes, so the pointers stay valid
+	const Node *n = nodes.ptr();
+	Element *e = elements.ptr();
+
+	for (int i = 0; i < move_buffer.size(); i++) {
+
+		ID id = move_buffer[i];
+		Element &elem = e[id - 1];
+
+		if (!elem.owner || !elem.moved)
+			continue; //removed, or a stale entry for a reused ID already processed
+		elem.moved = false;
+
+		//drop the pairs that stopped overlapping
+		for (int j = elem.paired.size() - 1; j >= 0; j--) {
+
+			ID other_id = elem.paired[j];
+			const Element &other = e[other_id - 1];
+			if ((elem._static && other._static) || !elem.aabb.intersects(other.aabb))
+				_unpair(MIN(id, other_id), MAX(id, other_id));
+		}
+
+		if (elem.node == -1)
+			continue;
+
+		//find the new ones, static objects only need to look at the trees with non static ones
+		int stack[BVH_STACK_SIZE];
+		int sp = 0;
+		for (int t = elem._static ? TREE_SLEEPING : TREE_STATIC; t < TREE_MAX; t++) {
+			if (root[t] != -1)
+				stack[sp++] = root[t];
+		}
+
+		while (sp) {
+
+			const Node &node = n[stack[--sp]];
+
+			if (!node.aabb.intersects(elem.aabb))
+				continue;
+
+			if (!node.is_leaf()) {
+				ERR_CONTINUE(sp + 2 > BVH_STACK_SIZE);
+				stack[sp++] = node.children[0];
+				stack[sp++] = node.children[1];
+				continue;
+			}
+
+			ID other_id = node.element;
+			if (other_id == id)
+				continue;
+
+			const Element &other = e[other_id - 1];
+			if (other.owner == elem.owner || (other._static && elem._static))
+				continue;
+			if (!other.aabb.intersects(elem.aabb))
+				continue;
+
+			PairKey key(id, other_id);
+			if (_pair_find(key.key) != -1)
+				continue; //already paired
+
+			_pair(key.a, key.b);
+		}
+	}
+
+	move_buffer.clear();
+}
+
+BroadPhase2DSW *BroadPhase2DBVH::_create() {
+
+	return memnew(BroadPhase2DBVH);
+}
+
+BroadPhase2DBVH::BroadPhase2DBVH() {
+
+	for (int i = 0; i < TREE_MAX; i++) {
+		root[i] = -1;
+	}
+	free_node = -1;
+
+	pair_table = NULL;
+	pair_table_size = 0;
+	pair_count = 0;
+	_pair_table_resize(64);
+
+	margin = GLOBAL_DEF("physics_2d/bp_bvh_margin", 8);
+
+	pair_callback = NULL;
+	pair_userdata = NULL;
+	unpair_callback = NULL;
+	unpair_userdata = NULL;
+}
+
+BroadPhase2DBVH::~BroadPhase2DBVH() {
+
+	memfree(pair_table);
+}
@@ -33,7 +33,7 @@
 
 void BroadPhase2DHashGrid::_pair_attempt(Element *p_elem, Element *p_with) {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	Map<Element *, PairData *, ElementCMP>::Element *E = p_elem->paired.find(p_with);
 
 	ERR_FAIL_COND(p_elem->_static && p_with->_static);
 
@@ -49,7 +49,7 @@ void BroadPhase2DHashGrid::_pair_attempt(Element *p_elem, Element *p_with) {
 
 void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
 
-	Map<Element *, PairData *>::Element *E = p_elem->paired.find(p_with);
+	Map<Element *, PairData *, ElementCMP>::Element *E = p_elem->paired.find(p_with);
 
 	ERR_FAIL_COND(!E); //this should really be paired..
 
@@ -72,7 +72,7 @@ void BroadPhase2DHashGrid::_unpair_attempt(Element *p_elem, Element *p_with) {
 
 void BroadPhase2DHashGrid::_check_motion(Element *p_elem) {
 
-	for (Map<Element *, PairData *>::Element *E = p_elem->paired.front(); E; E = E->next()) {
+	for (Map<Element *, PairData *, ElementCMP>::Element *E = p_elem->paired.front(); E; E = E->next()) {
 
 		bool pairing = p_elem->aabb.intersects(E->key()->aabb);
 
@@ -161,7 +161,7 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 
 			if (entered) {
 
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+				for (Map<Element *, RC, ElementCMP>::Element *E = pb->object_set.front(); E; E = E->next()) {
 
 					if (E->key()->owner == p_elem->owner)
 						continue;
@@ -170,7 +170,7 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 
 				if (!p_static) {
 
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+					for (Map<Element *, RC, ElementCMP>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
 
 						if (E->key()->owner == p_elem->owner)
 							continue;
@@ -183,7 +183,7 @@ void BroadPhase2DHashGrid::_enter_grid(Element *p_elem, const Rect2 &p_rect, boo
 
 	//pair separatedly with large elements
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = large_elements.front(); E; E = E->next()) {
 
 		if (E->key() == p_elem)
 			continue; // do not pair against itself
@@ -202,7 +202,7 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 	if (sz.width * sz.height > large_object_min_surface) {
 
 		//unpair all elements, instead of checking all, just check what is already paired, so we at least save from checking static vs static
-		for (Map<Element *, PairData *>::Element *E = p_elem->paired.front(); E; E = E->next()) {
+		for (Map<Element *, PairData *, ElementCMP>::Element *E = p_elem->paired.front(); E; E = E->next()) {
 
 			_unpair_attempt(p_elem, E->key());
 		}
@@ -256,7 +256,7 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 
 			if (exited) {
 
-				for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+				for (Map<Element *, RC, ElementCMP>::Element *E = pb->object_set.front(); E; E = E->next()) {
 
 					if (E->key()->owner == p_elem->owner)
 						continue;
@@ -265,7 +265,7 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 
 				if (!p_static) {
 
-					for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+					for (Map<Element *, RC, ElementCMP>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
 
 						if (E->key()->owner == p_elem->owner)
 							continue;
@@ -300,7 +300,7 @@ void BroadPhase2DHashGrid::_exit_grid(Element *p_elem, const Rect2 &p_rect, bool
 		}
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = large_elements.front(); E; E = E->next()) {
 		if (E->key() == p_elem)
 			continue; // do not pair against itself
 		if (E->key()->owner == p_elem->owner)
@@ -428,7 +428,7 @@ void BroadPhase2DHashGrid::_cull(const Point2i p_cell, const Rect2 &p_aabb, cons
 	if (!pb)
 		return;
 
-	for (Map<Element *, RC>::Element *E = pb->object_set.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = pb->object_set.front(); E; E = E->next()) {
 
 		if (index >= p_max_results)
 			break;
@@ -448,7 +448,7 @@ void BroadPhase2DHashGrid::_cull(const Point2i p_cell, const Rect2 &p_aabb, cons
 		index++;
 	}
 
-	for (Map<Element *, RC>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = pb->static_object_set.front(); E; E = E->next()) {
 
 		if (index >= p_max_results)
 			break;
@@ -544,7 +544,7 @@ int BroadPhase2DHashGrid::cull_segment(const Vector2 &p_from, const Vector2 &p_t
 			break;
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = large_elements.front(); E; E = E->next()) {
 
 		if (cullcount >= p_max_results)
 			break;
@@ -583,7 +583,7 @@ int BroadPhase2DHashGrid::cull_aabb(const Rect2 &p_aabb, CollisionObject2DSW **p
 		}
 	}
 
-	for (Map<Element *, RC>::Element *E = large_elements.front(); E; E = E->next()) {
+	for (Map<Element *, RC, ElementCMP>::Element *E = large_elements.front(); E; E = E->next()) {
 
 		if (cullcount >= p_max_results)
 			break;
@@ -46,6 +46,14 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		}
 	};
 
+	struct Element;
+
+	//elements are sorted by id rather than by address, so pairs are found in the same order on every run
+	struct ElementCMP {
+
+		_FORCE_INLINE_ bool operator()(const Element *p_a, const Element *p_b) const { return p_a->self < p_b->self; }
+	};
+
 	struct Element {
 
 		ID self;
@@ -54,7 +62,7 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 		Rect2 aabb;
 		int subindex;
 		uint64_t pass;
-		Map<Element *, PairData *> paired;
+		Map<Element *, PairData *, ElementCMP> paired;
 	};
 
 	struct RC {
@@ -76,7 +84,7 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 	};
 
 	Map<ID, Element> element_map;
-	Map<Element *, RC> large_elements;
+	Map<Element *, RC, ElementCMP> large_elements;
 
 	ID current;
 
@@ -153,8 +161,8 @@ class BroadPhase2DHashGrid : public BroadPhase2DSW {
 	struct PosBin {
 
 		PosKey key;
-		Map<Element *, RC> object_set;
-		Map<Element *, RC> static_object_set;
+		Map<Element *, RC, ElementCMP> object_set;
+		Map<Element *, RC, ElementCMP> static_object_set;
 		PosBin *next;
 	};
 
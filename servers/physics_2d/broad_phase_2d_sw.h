@@ -50,6 +50,7 @@ public:
 	virtual ID create(CollisionObject2DSW *p_object_, int p_subindex = 0) = 0;
 	virtual void move(ID p_id, const Rect2 &p_aabb) = 0;
 	virtual void set_static(ID p_id, bool p_static) = 0;
+	virtual void set_active(ID p_id, bool p_active) {} //lets broadphases keep sleeping objects apart, optional
 	virtual void remove(ID p_id) = 0;
 
 	virtual CollisionObject2DSW *get_object(ID p_id) const = 0;
@@ -115,6 +115,21 @@ void CollisionObject2DSW::_set_static(bool p_static) {
 	}
 }
 
+void CollisionObject2DSW::_set_sleeping(bool p_sleeping) {
+	if (_sleeping == p_sleeping)
+		return;
+	_sleeping = p_sleeping;
+
+	if (!space)
+		return;
+	for (int i = 0; i < get_shape_count(); i++) {
+		Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			space->get_broadphase()->set_active(s.bpid, !_sleeping);
+		}
+	}
+}
+
 void CollisionObject2DSW::_unregister_shapes() {
 
 	for (int i = 0; i < shapes.size(); i++) {
@@ -138,6 +153,8 @@ void CollisionObject2DSW::_update_shapes() {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_sleeping)
+				space->get_broadphase()->set_active(s.bpid, false);
 		}
 
 		//not quite correct, should compute the next matrix..
@@ -162,6 +179,8 @@ void CollisionObject2DSW::_update_shapes_with_motion(const Vector2 &p_motion) {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			if (_sleeping)
+				space->get_broadphase()->set_active(s.bpid, false);
 		}
 
 		//not quite correct, should compute the next matrix..
@@ -209,6 +228,7 @@ void CollisionObject2DSW::_shape_changed() {
 CollisionObject2DSW::CollisionObject2DSW(Type p_type) {
 
 	_static = true;
+	_sleeping = false;
 	type = p_type;
 	space = NULL;
 	instance_id = 0;
@@ -68,10 +68,10 @@ private:
 	uint32_t collision_mask;
 	uint32_t layer_mask;
 	bool _static;
-
-	void _update_shapes();
+	bool _sleeping;
 
 protected:
+	void _update_shapes();
 	void _update_shapes_with_motion(const Vector2 &p_motion);
 	void _unregister_shapes();
 
@@ -83,6 +83,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Matrix32 &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(Space2DSW *space);
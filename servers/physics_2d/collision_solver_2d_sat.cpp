@@ -27,6 +27,7 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 #include "collision_solver_2d_sat.h"
+#include "float4.h"
 #include "geometry.h"
 
 struct _CollectorCallback2D {
@@ -325,6 +326,117 @@ static void _generate_contacts_from_supports(const Vector2 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_collector);
 }
 
+/****** BATCHED PROJECTION *******/
+
+//separator axes are projected four at a time, each shape type projects all of them in a single pass over its points
+
+static bool sat_2d_vectorized = true;
+
+void sat_2d_set_vectorized(bool p_enable) {
+
+	sat_2d_vectorized = p_enable;
+}
+
+bool sat_2d_is_vectorized() {
+
+	return sat_2d_vectorized;
+}
+
+struct _SAT2DAxes4 {
+
+	real_t x[4];
+	real_t y[4];
+};
+
+//n.(M*v) == (n.M[0])*v.x+(n.M[1])*v.y+n.M[2], so the axes are brought to shape space once and points are used untransformed
+_FORCE_INLINE_ static void _sat_2d_local_axes4(const _SAT2DAxes4 &p_axes, const Matrix32 &p_transform, Float4 &r_x, Float4 &r_y, Float4 &r_ofs) {
+
+	Float4 nx = Float4::load(p_axes.x);
+	Float4 ny = Float4::load(p_axes.y);
+
+	r_x = nx * p_transform.elements[0].x + ny * p_transform.elements[0].y;
+	r_y = nx * p_transform.elements[1].x + ny * p_transform.elements[1].y;
+	r_ofs = nx * p_transform.elements[2].x + ny * p_transform.elements[2].y;
+}
+
+template <class T>
+_FORCE_INLINE_ static void _sat_2d_project_range4(const T *p_shape, const Matrix32 &p_transform, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	//no batched version, project one by one
+	for (int i = 0; i < 4; i++) {
+		p_shape->project_range(Vector2(p_axes.x[i], p_axes.y[i]), p_transform, r_min[i], r_max[i]);
+	}
+}
+
+_FORCE_INLINE_ static void _sat_2d_project_range4(const CircleShape2DSW *p_circle, const Matrix32 &p_transform, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, ofs;
+	_sat_2d_local_axes4(p_axes, p_transform, lx, ly, ofs);
+
+	Float4 length = Float4::sqrt(lx * lx + ly * ly) * p_circle->get_radius();
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_2d_project_range4(const RectangleShape2DSW *p_rectangle, const Matrix32 &p_transform, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, ofs;
+	_sat_2d_local_axes4(p_axes, p_transform, lx, ly, ofs);
+
+	const Vector2 &he = p_rectangle->get_half_extents();
+	Float4 length = Float4::abs(lx) * he.x + Float4::abs(ly) * he.y;
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_2d_project_range4(const CapsuleShape2DSW *p_capsule, const Matrix32 &p_transform, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, ofs;
+	_sat_2d_local_axes4(p_axes, p_transform, lx, ly, ofs);
+
+	//circle radius along the axis plus half the segment
+	Float4 length = Float4::sqrt(lx * lx + ly * ly) * p_capsule->get_radius() + Float4::abs(ly) * (p_capsule->get_height() * 0.5);
+
+	(ofs - length).store(r_min);
+	(ofs + length).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_2d_project_range4(const ConvexPolygonShape2DSW *p_convex, const Matrix32 &p_transform, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	Float4 lx, ly, ofs;
+	_sat_2d_local_axes4(p_axes, p_transform, lx, ly, ofs);
+
+	int point_count = p_convex->get_point_count();
+
+	Float4 d = lx * p_convex->get_point(0).x + ly * p_convex->get_point(0).y;
+	Float4 mn = d;
+	Float4 mx = d;
+
+	for (int i = 1; i < point_count; i++) {
+
+		const Vector2 &p = p_convex->get_point(i);
+		d = lx * p.x + ly * p.y;
+		mn = Float4::min(mn, d);
+		mx = Float4::max(mx, d);
+	}
+
+	(mn + ofs).store(r_min);
+	(mx + ofs).store(r_max);
+}
+
+_FORCE_INLINE_ static void _sat_2d_project_range_cast4(const Vector2 &p_cast, const _SAT2DAxes4 &p_axes, real_t *r_min, real_t *r_max) {
+
+	//merge with the range moved by the cast
+	Float4 c = Float4::load(p_axes.x) * p_cast.x + Float4::load(p_axes.y) * p_cast.y;
+	Float4 mn = Float4::load(r_min);
+	Float4 mx = Float4::load(r_max);
+
+	Float4::min(mn, mn + c).store(r_min);
+	Float4::max(mx, mx + c).store(r_max);
+}
+
 template <class ShapeA, class ShapeB, bool castA = false, bool castB = false, bool withMargin = false>
 class SeparatorAxisTest2D {
 
@@ -342,6 +454,64 @@ class SeparatorAxisTest2D {
 	real_t margin_B;
 	_CollectorCallback2D *callback;
 
+	Vector2 queued_axes[4];
+	int queued_count;
+
+	_FORCE_INLINE_ bool _test_range(const Vector2 &p_axis, real_t p_min_A, real_t p_max_A, real_t p_min_B, real_t p_max_B) {
+
+		if (withMargin) {
+			p_min_A -= margin_A;
+			p_max_A += margin_A;
+			p_min_B -= margin_B;
+			p_max_B += margin_B;
+		}
+
+		p_min_B -= (p_max_A - p_min_A) * 0.5;
+		p_max_B += (p_max_A - p_min_A) * 0.5;
+
+		real_t dmin = p_min_B - (p_min_A + p_max_A) * 0.5;
+		real_t dmax = p_max_B - (p_min_A + p_max_A) * 0.5;
+
+		if (dmin > 0.0 || dmax < 0.0) {
+			if (callback && callback->sep_axis)
+				*callback->sep_axis = p_axis;
+#ifdef DEBUG_ENABLED
+			best_axis_count++;
+#endif
+
+			return false; // doesn't contain 0
+		}
+
+		//use the smallest depth
+
+		dmin = Math::abs(dmin);
+
+		if (dmax < dmin) {
+			if (dmax < best_depth) {
+				best_depth = dmax;
+				best_axis = p_axis;
+#ifdef DEBUG_ENABLED
+				best_axis_index = best_axis_count;
+#endif
+			}
+		} else {
+			if (dmin < best_depth) {
+				best_depth = dmin;
+				best_axis = -p_axis; // keep it as A axis
+#ifdef DEBUG_ENABLED
+				best_axis_index = best_axis_count;
+#endif
+			}
+		}
+
+//	print_line("test axis: "+p_axis+" depth: "+rtos(best_depth));
+#ifdef DEBUG_ENABLED
+		best_axis_count++;
+#endif
+
+		return true;
+	}
+
 public:
 	_FORCE_INLINE_ bool test_previous_axis() {
 
@@ -400,55 +570,61 @@ public:
 		else
 			shape_B->project_range(axis, *transform_B, min_B, max_B);
 
-		if (withMargin) {
-			min_A -= margin_A;
-			max_A += margin_A;
-			min_B -= margin_B;
-			max_B += margin_B;
-		}
+		return _test_range(axis, min_A, max_A, min_B, max_B);
+	}
 
-		min_B -= (max_A - min_A) * 0.5;
-		max_B += (max_A - min_A) * 0.5;
+	//same as test_axis, but axes are projected in groups of four. flush_axes() must be called before generate_contacts()
+	_FORCE_INLINE_ bool queue_axis(const Vector2 &p_axis) {
 
-		real_t dmin = min_B - (min_A + max_A) * 0.5;
-		real_t dmax = max_B - (min_A + max_A) * 0.5;
+		if (!sat_2d_vectorized)
+			return test_axis(p_axis);
 
-		if (dmin > 0.0 || dmax < 0.0) {
-			if (callback && callback->sep_axis)
-				*callback->sep_axis = axis;
-#ifdef DEBUG_ENABLED
-			best_axis_count++;
-#endif
+		queued_axes[queued_count++] = p_axis;
+		if (queued_count < 4)
+			return true;
 
-			return false; // doesn't contain 0
-		}
+		return flush_axes();
+	}
 
-		//use the smallest depth
+	bool flush_axes() {
 
-		dmin = Math::abs(dmin);
+		if (queued_count == 0)
+			return true;
 
-		if (dmax < dmin) {
-			if (dmax < best_depth) {
-				best_depth = dmax;
-				best_axis = axis;
-#ifdef DEBUG_ENABLED
-				best_axis_index = best_axis_count;
-#endif
-			}
-		} else {
-			if (dmin < best_depth) {
-				best_depth = dmin;
-				best_axis = -axis; // keep it as A axis
-#ifdef DEBUG_ENABLED
-				best_axis_index = best_axis_count;
-#endif
+		int count = queued_count;
+		queued_count = 0;
+
+		_SAT2DAxes4 axes;
+		for (int i = 0; i < 4; i++) {
+
+			Vector2 axis = queued_axes[i < count ? i : count - 1];
+
+			if (Math::abs(axis.x) < CMP_EPSILON &&
+					Math::abs(axis.y) < CMP_EPSILON) {
+				// strange case, try an upwards separator
+				axis = Vector2(0.0, 1.0);
 			}
+
+			axes.x[i] = axis.x;
+			axes.y[i] = axis.y;
 		}
 
-//	print_line("test axis: "+p_axis+" depth: "+rtos(best_depth));
-#ifdef DEBUG_ENABLED
-		best_axis_count++;
-#endif
+		real_t min_A[4], max_A[4], min_B[4], max_B[4];
+
+		_sat_2d_project_range4(shape_A, *transform_A, axes, min_A, max_A);
+		if (castA)
+			_sat_2d_project_range_cast4(motion_A, axes, min_A, max_A);
+
+		_sat_2d_project_range4(shape_B, *transform_B, axes, min_B, max_B);
+		if (castB)
+			_sat_2d_project_range_cast4(motion_B, axes, min_B, max_B);
+
+		//results are evaluated in order, so the outcome matches testing one by one
+		for (int i = 0; i < count; i++) {
+
+			if (!_test_range(Vector2(axes.x[i], axes.y[i]), min_A[i], max_A[i], min_B[i], max_B[i]))
+				return false;
+		}
 
 		return true;
 	}
@@ -547,6 +723,7 @@ public:
 		motion_B = p_motion_B;
 
 		callback = p_collector;
+		queued_count = 0;
 #ifdef DEBUG_ENABLED
 		best_axis_count = 0;
 		best_axis_index = -1;
@@ -559,11 +736,11 @@ public:
 /****** SAT TESTS *******/
 /****** SAT TESTS *******/
 
-#define TEST_POINT(m_a, m_b)                                                                \
-	((!separator.test_axis(((m_a) - (m_b)).normalized())) ||                                \
-			(castA && !separator.test_axis(((m_a) + p_motion_a - (m_b)).normalized())) ||   \
-			(castB && !separator.test_axis(((m_a) - ((m_b) + p_motion_b)).normalized())) || \
-			(castA && castB && !separator.test_axis(((m_a) + p_motion_a - ((m_b) + p_motion_b)).normalized())))
+#define TEST_POINT(m_a, m_b)                                                                 \
+	((!separator.queue_axis(((m_a) - (m_b)).normalized())) ||                                \
+			(castA && !separator.queue_axis(((m_a) + p_motion_a - (m_b)).normalized())) ||   \
+			(castB && !separator.queue_axis(((m_a) - ((m_b) + p_motion_b)).normalized())) || \
+			(castA && castB && !separator.queue_axis(((m_a) + p_motion_a - ((m_b) + p_motion_b)).normalized())))
 
 typedef void (*CollisionFunc)(const Shape2DSW *, const Matrix32 &, const Shape2DSW *, const Matrix32 &, _CollectorCallback2D *p_collector, const Vector2 &, const Vector2 &, float, float);
 
@@ -585,9 +762,9 @@ static void _collision_segment_segment(const Shape2DSW *p_a, const Matrix32 &p_t
 	if (!separator.test_cast())
 		return;
 
-	if (!separator.test_axis(segment_A->get_xformed_normal(p_transform_a)))
+	if (!separator.queue_axis(segment_A->get_xformed_normal(p_transform_a)))
 		return;
-	if (!separator.test_axis(segment_B->get_xformed_normal(p_transform_b)))
+	if (!separator.queue_axis(segment_B->get_xformed_normal(p_transform_b)))
 		return;
 
 	if (withMargin) {
@@ -603,6 +780,9 @@ static void _collision_segment_segment(const Shape2DSW *p_a, const Matrix32 &p_t
 			return;
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -621,7 +801,7 @@ static void _collision_segment_circle(const Shape2DSW *p_a, const Matrix32 &p_tr
 		return;
 
 	//segment normal
-	if (!separator.test_axis(
+	if (!separator.queue_axis(
 				(p_transform_a.xform(segment_A->get_b()) - p_transform_a.xform(segment_A->get_a())).normalized().tangent()))
 		return;
 
@@ -632,6 +812,9 @@ static void _collision_segment_circle(const Shape2DSW *p_a, const Matrix32 &p_tr
 	if (TEST_POINT(p_transform_a.xform(segment_A->get_b()), p_transform_b.get_origin()))
 		return;
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -649,13 +832,13 @@ static void _collision_segment_rectangle(const Shape2DSW *p_a, const Matrix32 &p
 	if (!separator.test_cast())
 		return;
 
-	if (!separator.test_axis(segment_A->get_xformed_normal(p_transform_a)))
+	if (!separator.queue_axis(segment_A->get_xformed_normal(p_transform_a)))
 		return;
 
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_b.elements[1].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[1].normalized()))
 		return;
 
 	if (withMargin) {
@@ -665,36 +848,39 @@ static void _collision_segment_rectangle(const Shape2DSW *p_a, const Matrix32 &p
 		Vector2 a = p_transform_a.xform(segment_A->get_a());
 		Vector2 b = p_transform_a.xform(segment_A->get_b());
 
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a)))
 			return;
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b)))
 			return;
 
 		if (castA) {
 
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a + p_motion_a)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a + p_motion_a)))
 				return;
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b + p_motion_a)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b + p_motion_a)))
 				return;
 		}
 
 		if (castB) {
 
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a - p_motion_b)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a - p_motion_b)))
 				return;
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b - p_motion_b)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b - p_motion_b)))
 				return;
 		}
 
 		if (castA && castB) {
 
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a - p_motion_b + p_motion_a)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, a - p_motion_b + p_motion_a)))
 				return;
-			if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b - p_motion_b + p_motion_a)))
+			if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, inv, b - p_motion_b + p_motion_a)))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -712,10 +898,10 @@ static void _collision_segment_capsule(const Shape2DSW *p_a, const Matrix32 &p_t
 	if (!separator.test_cast())
 		return;
 
-	if (!separator.test_axis(segment_A->get_xformed_normal(p_transform_a)))
+	if (!separator.queue_axis(segment_A->get_xformed_normal(p_transform_a)))
 		return;
 
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
 	if (TEST_POINT(p_transform_a.xform(segment_A->get_a()), (p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * 0.5)))
@@ -727,6 +913,9 @@ static void _collision_segment_capsule(const Shape2DSW *p_a, const Matrix32 &p_t
 	if (TEST_POINT(p_transform_a.xform(segment_A->get_b()), (p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * -0.5)))
 		return;
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -744,12 +933,12 @@ static void _collision_segment_convex_polygon(const Shape2DSW *p_a, const Matrix
 	if (!separator.test_cast())
 		return;
 
-	if (!separator.test_axis(segment_A->get_xformed_normal(p_transform_a)))
+	if (!separator.queue_axis(segment_A->get_xformed_normal(p_transform_a)))
 		return;
 
 	for (int i = 0; i < convex_B->get_point_count(); i++) {
 
-		if (!separator.test_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
+		if (!separator.queue_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
 			return;
 
 		if (withMargin) {
@@ -761,6 +950,9 @@ static void _collision_segment_convex_polygon(const Shape2DSW *p_a, const Matrix
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -783,6 +975,9 @@ static void _collision_circle_circle(const Shape2DSW *p_a, const Matrix32 &p_tra
 	if (TEST_POINT(p_transform_a.get_origin(), p_transform_b.get_origin()))
 		return;
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -804,40 +999,43 @@ static void _collision_circle_rectangle(const Shape2DSW *p_a, const Matrix32 &p_
 	const Vector2 *axis = &p_transform_b.elements[0];
 	//	const Vector2& half_extents = rectangle_B->get_half_extents();
 
-	if (!separator.test_axis(axis[0].normalized()))
+	if (!separator.queue_axis(axis[0].normalized()))
 		return;
 
-	if (!separator.test_axis(axis[1].normalized()))
+	if (!separator.queue_axis(axis[1].normalized()))
 		return;
 
 	Matrix32 binv = p_transform_b.affine_inverse();
 	{
 
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphere)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphere)))
 			return;
 	}
 
 	if (castA) {
 
 		Vector2 sphereofs = sphere + p_motion_a;
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
 			return;
 	}
 
 	if (castB) {
 
 		Vector2 sphereofs = sphere - p_motion_b;
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
 			return;
 	}
 
 	if (castA && castB) {
 
 		Vector2 sphereofs = sphere - p_motion_b + p_motion_a;
-		if (!separator.test_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
+		if (!separator.queue_axis(rectangle_B->get_circle_axis(p_transform_b, binv, sphereofs)))
 			return;
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -856,7 +1054,7 @@ static void _collision_circle_capsule(const Shape2DSW *p_a, const Matrix32 &p_tr
 		return;
 
 	//capsule axis
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
 	//capsule endpoints
@@ -865,6 +1063,9 @@ static void _collision_circle_capsule(const Shape2DSW *p_a, const Matrix32 &p_tr
 	if (TEST_POINT(p_transform_a.get_origin(), (p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * -0.5)))
 		return;
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -888,10 +1089,13 @@ static void _collision_circle_convex_polygon(const Shape2DSW *p_a, const Matrix3
 		if (TEST_POINT(p_transform_a.get_origin(), p_transform_b.xform(convex_B->get_point(i))))
 			return;
 
-		if (!separator.test_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
+		if (!separator.queue_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
 			return;
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -912,17 +1116,17 @@ static void _collision_rectangle_rectangle(const Shape2DSW *p_a, const Matrix32
 		return;
 
 	//box faces A
-	if (!separator.test_axis(p_transform_a.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_a.elements[1].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[1].normalized()))
 		return;
 
 	//box faces B
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_b.elements[1].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[1].normalized()))
 		return;
 
 	if (withMargin) {
@@ -930,7 +1134,7 @@ static void _collision_rectangle_rectangle(const Shape2DSW *p_a, const Matrix32
 		Matrix32 invA = p_transform_a.affine_inverse();
 		Matrix32 invB = p_transform_b.affine_inverse();
 
-		if (!separator.test_axis(rectangle_A->get_box_axis(p_transform_a, invA, rectangle_B, p_transform_b, invB)))
+		if (!separator.queue_axis(rectangle_A->get_box_axis(p_transform_a, invA, rectangle_B, p_transform_b, invB)))
 			return;
 
 		if (castA || castB) {
@@ -946,24 +1150,27 @@ static void _collision_rectangle_rectangle(const Shape2DSW *p_a, const Matrix32
 
 			if (castA) {
 
-				if (!separator.test_axis(rectangle_A->get_box_axis(aofs, aofsinv, rectangle_B, p_transform_b, invB)))
+				if (!separator.queue_axis(rectangle_A->get_box_axis(aofs, aofsinv, rectangle_B, p_transform_b, invB)))
 					return;
 			}
 
 			if (castB) {
 
-				if (!separator.test_axis(rectangle_A->get_box_axis(p_transform_a, invA, rectangle_B, bofs, bofsinv)))
+				if (!separator.queue_axis(rectangle_A->get_box_axis(p_transform_a, invA, rectangle_B, bofs, bofsinv)))
 					return;
 			}
 
 			if (castA && castB) {
 
-				if (!separator.test_axis(rectangle_A->get_box_axis(aofs, aofsinv, rectangle_B, bofs, bofsinv)))
+				if (!separator.queue_axis(rectangle_A->get_box_axis(aofs, aofsinv, rectangle_B, bofs, bofsinv)))
 					return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -982,14 +1189,14 @@ static void _collision_rectangle_capsule(const Shape2DSW *p_a, const Matrix32 &p
 		return;
 
 	//box faces
-	if (!separator.test_axis(p_transform_a.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_a.elements[1].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[1].normalized()))
 		return;
 
 	//capsule axis
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
 	//box endpoints to capsule circles
@@ -1001,7 +1208,7 @@ static void _collision_rectangle_capsule(const Shape2DSW *p_a, const Matrix32 &p
 		{
 			Vector2 capsule_endpoint = p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * (i == 0 ? 0.5 : -0.5);
 
-			if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
+			if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
 				return;
 		}
 
@@ -1009,7 +1216,7 @@ static void _collision_rectangle_capsule(const Shape2DSW *p_a, const Matrix32 &p
 			Vector2 capsule_endpoint = p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * (i == 0 ? 0.5 : -0.5);
 			capsule_endpoint -= p_motion_a;
 
-			if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
+			if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
 				return;
 		}
 
@@ -1017,7 +1224,7 @@ static void _collision_rectangle_capsule(const Shape2DSW *p_a, const Matrix32 &p
 			Vector2 capsule_endpoint = p_transform_b.get_origin() + p_transform_b.elements[1] * capsule_B->get_height() * (i == 0 ? 0.5 : -0.5);
 			capsule_endpoint += p_motion_b;
 
-			if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
+			if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
 				return;
 		}
 
@@ -1026,11 +1233,14 @@ static void _collision_rectangle_capsule(const Shape2DSW *p_a, const Matrix32 &p
 			capsule_endpoint -= p_motion_a;
 			capsule_endpoint += p_motion_b;
 
-			if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
+			if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, capsule_endpoint)))
 				return;
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1049,10 +1259,10 @@ static void _collision_rectangle_convex_polygon(const Shape2DSW *p_a, const Matr
 		return;
 
 	//box faces
-	if (!separator.test_axis(p_transform_a.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_a.elements[1].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[1].normalized()))
 		return;
 
 	//convex faces
@@ -1062,31 +1272,34 @@ static void _collision_rectangle_convex_polygon(const Shape2DSW *p_a, const Matr
 	}
 	for (int i = 0; i < convex_B->get_point_count(); i++) {
 
-		if (!separator.test_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
+		if (!separator.queue_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
 			return;
 
 		if (withMargin) {
 			//all points vs all points need to be tested if margin exist
-			if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)))))
+			if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)))))
 				return;
 			if (castA) {
 
-				if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) - p_motion_a)))
+				if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) - p_motion_a)))
 					return;
 			}
 			if (castB) {
 
-				if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) + p_motion_b)))
+				if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) + p_motion_b)))
 					return;
 			}
 			if (castA && castB) {
 
-				if (!separator.test_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) + p_motion_b - p_motion_a)))
+				if (!separator.queue_axis(rectangle_A->get_circle_axis(p_transform_a, boxinv, p_transform_b.xform(convex_B->get_point(i)) + p_motion_b - p_motion_a)))
 					return;
 			}
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1108,10 +1321,10 @@ static void _collision_capsule_capsule(const Shape2DSW *p_a, const Matrix32 &p_t
 
 	//capsule axis
 
-	if (!separator.test_axis(p_transform_b.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_b.elements[0].normalized()))
 		return;
 
-	if (!separator.test_axis(p_transform_a.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[0].normalized()))
 		return;
 
 	//capsule endpoints
@@ -1129,6 +1342,9 @@ static void _collision_capsule_capsule(const Shape2DSW *p_a, const Matrix32 &p_t
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1148,7 +1364,7 @@ static void _collision_capsule_convex_polygon(const Shape2DSW *p_a, const Matrix
 
 	//capsule axis
 
-	if (!separator.test_axis(p_transform_a.elements[0].normalized()))
+	if (!separator.queue_axis(p_transform_a.elements[0].normalized()))
 		return;
 
 	//poly vs capsule
@@ -1164,10 +1380,13 @@ static void _collision_capsule_convex_polygon(const Shape2DSW *p_a, const Matrix
 				return;
 		}
 
-		if (!separator.test_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
+		if (!separator.queue_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
 			return;
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -1189,13 +1408,13 @@ static void _collision_convex_polygon_convex_polygon(const Shape2DSW *p_a, const
 
 	for (int i = 0; i < convex_A->get_point_count(); i++) {
 
-		if (!separator.test_axis(convex_A->get_xformed_segment_normal(p_transform_a, i)))
+		if (!separator.queue_axis(convex_A->get_xformed_segment_normal(p_transform_a, i)))
 			return;
 	}
 
 	for (int i = 0; i < convex_B->get_point_count(); i++) {
 
-		if (!separator.test_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
+		if (!separator.queue_axis(convex_B->get_xformed_segment_normal(p_transform_b, i)))
 			return;
 	}
 
@@ -1210,6 +1429,9 @@ static void _collision_convex_polygon_convex_polygon(const Shape2DSW *p_a, const
 		}
 	}
 
+	if (!separator.flush_axes())
+		return;
+
 	separator.generate_contacts();
 }
 
@@ -33,4 +33,8 @@
 
 bool sat_2d_calculate_penetration(const Shape2DSW *p_shape_A, const Matrix32 &p_transform_A, const Vector2 &p_motion_A, const Shape2DSW *p_shape_B, const Matrix32 &p_transform_B, const Vector2 &p_motion_B, CollisionSolver2DSW::CallbackResult p_result_callback, void *p_userdata, bool p_swap = false, Vector2 *sep_axis = NULL, float p_margin_A = 0, float p_margin_B = 0);
 
+//separator axes are projected in groups of four (SSE2 when available), disabling it falls back to one axis at a time
+void sat_2d_set_vectorized(bool p_enable);
+bool sat_2d_is_vectorized();
+
 #endif // COLLISION_SOLVER_2D_SAT_H
@@ -31,6 +31,8 @@
 
 #include "body_2d_sw.h"
 
+class IslandSolver2DSW;
+
 class Constraint2DSW {
 
 	Body2DSW **_body_ptr;
@@ -38,14 +40,18 @@ class Constraint2DSW {
 	uint64_t island_step;
 	Constraint2DSW *island_next;
 	Constraint2DSW *island_list_next;
+	uint64_t creation_id;
 
 	RID self;
 
+	static uint64_t creation_count;
+
 protected:
 	Constraint2DSW(Body2DSW **p_body_ptr = NULL, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
 		island_step = 0;
+		creation_id = creation_count++;
 	}
 
 public:
@@ -64,9 +70,16 @@ public:
 	_FORCE_INLINE_ Body2DSW **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
+	_FORCE_INLINE_ uint64_t get_creation_id() const { return creation_id; }
+
 	virtual bool setup(float p_step) = 0;
 	virtual void solve(float p_step) = 0;
 
+	//contact constraints copy themselves into the island solver arrays and read the impulses back after solving,
+	//returning false leaves the constraint to solve()
+	virtual bool pack(IslandSolver2DSW *p_solver) { return false; }
+	virtual void unpack(const IslandSolver2DSW *p_solver, int p_from) {}
+
 	virtual ~Constraint2DSW() {}
 };
 
@@ -0,0 +1,246 @@
+/*************************************************************************/
+/*  island_solver_2d_sw.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "island_solver_2d_sw.h"
+
+template <class T>
+static _FORCE_INLINE_ T *_island_alloc(Vector<T> &p_vector, int &r_count, int p_amount) {
+
+	if (r_count + p_amount > p_vector.size()) {
+		p_vector.resize(MAX(r_count + p_amount, p_vector.size() * 2));
+	}
+
+	T *ret = p_vector.ptr() + r_count;
+	r_count += p_amount;
+	return ret;
+}
+
+int IslandSolver2DSW::add_body(Body2DSW *p_body) {
+
+	//dynamic bodies belong to a single island, static and kinematic ones can be shared so each pair gets its own read-only copy
+	bool dynamic = p_body->get_mode() > Physics2DServer::BODY_MODE_KINEMATIC;
+	if (dynamic && p_body->get_solver_index() >= 0)
+		return p_body->get_solver_index();
+
+	int index = body_count;
+	Body *b = _island_alloc(bodies, body_count, 1);
+	b->linear_velocity = p_body->get_linear_velocity();
+	b->biased_linear_velocity = p_body->get_biased_linear_velocity();
+	b->angular_velocity = p_body->get_angular_velocity();
+	b->biased_angular_velocity = p_body->get_biased_angular_velocity();
+	b->inv_mass = p_body->get_inv_mass();
+	b->inv_inertia = p_body->get_inv_inertia();
+
+	if (dynamic) {
+		b->body = p_body;
+		p_body->set_solver_index(index);
+	} else {
+		b->body = NULL;
+	}
+
+	return index;
+}
+
+IslandSolver2DSW::Contact *IslandSolver2DSW::add_contacts(int p_count) {
+
+	return _island_alloc(contacts, contact_count, p_count);
+}
+
+void IslandSolver2DSW::setup(Constraint2DSW *p_island) {
+
+	body_count = 0;
+	contact_count = 0;
+	run_count = 0;
+	packed_count = 0;
+
+	for (Constraint2DSW *ci = p_island; ci; ci = ci->get_island_next()) {
+
+		int from = contact_count;
+
+		if (ci->pack(this)) {
+
+			if (contact_count == from)
+				continue; //nothing to solve
+
+			Packed *p = _island_alloc(packed, packed_count, 1);
+			p->constraint = ci;
+			p->from = from;
+
+			//consecutive contact constraints are solved as a single flat run
+			if (run_count > 0 && runs[run_count - 1].constraint == NULL) {
+				runs[run_count - 1].to = contact_count;
+				continue;
+			}
+
+			Run *r = _island_alloc(runs, run_count, 1);
+			r->constraint = NULL;
+			r->from = from;
+			r->to = contact_count;
+
+		} else {
+
+			Run *r = _island_alloc(runs, run_count, 1);
+			r->constraint = ci;
+			r->from = 0;
+			r->to = 0;
+		}
+	}
+}
+
+void IslandSolver2DSW::_solve_contacts(int p_from, int p_to) {
+
+	Body *b = bodies.ptr();
+	Contact *contact = contacts.ptr();
+
+	for (int i = p_from; i < p_to; i++) {
+
+		Contact &c = contact[i];
+		Body &A = b[c.body_A];
+		Body &B = b[c.body_B];
+
+		// Relative velocity at contact
+
+		Vector2 crA(-A.angular_velocity * c.rA.y, A.angular_velocity * c.rA.x);
+		Vector2 crB(-B.angular_velocity * c.rB.y, B.angular_velocity * c.rB.x);
+		Vector2 dv = B.linear_velocity + crB - A.linear_velocity - crA;
+
+		Vector2 crbA(-A.biased_angular_velocity * c.rA.y, A.biased_angular_velocity * c.rA.x);
+		Vector2 crbB(-B.biased_angular_velocity * c.rB.y, B.biased_angular_velocity * c.rB.x);
+		Vector2 dbv = B.biased_linear_velocity + crbB - A.biased_linear_velocity - crbA;
+
+		real_t vn = dv.dot(c.normal);
+		real_t vbn = dbv.dot(c.normal);
+		Vector2 tangent = c.normal.tangent();
+		real_t vt = dv.dot(tangent);
+
+		real_t jbn = (c.bias - vbn) * c.mass_normal;
+		real_t jbnOld = c.acc_bias_impulse;
+		c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
+
+		Vector2 jb = c.normal * (c.acc_bias_impulse - jbnOld);
+
+		A.apply_bias_impulse(c.rA, -jb);
+		B.apply_bias_impulse(c.rB, jb);
+
+		real_t jn = -(c.bounce + vn) * c.mass_normal;
+		real_t jnOld = c.acc_normal_impulse;
+		c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
+
+		real_t jtMax = c.friction * c.acc_normal_impulse;
+		real_t jt = -vt * c.mass_tangent;
+		real_t jtOld = c.acc_tangent_impulse;
+		c.acc_tangent_impulse = CLAMP(jtOld + jt, -jtMax, jtMax);
+
+		Vector2 j = c.normal * (c.acc_normal_impulse - jnOld) + tangent * (c.acc_tangent_impulse - jtOld);
+
+		A.apply_impulse(c.rA, -j);
+		B.apply_impulse(c.rB, j);
+	}
+}
+
+void IslandSolver2DSW::_solve_constraint(Constraint2DSW *p_constraint, float p_step) {
+
+	//joints work on the bodies directly, so hand them the packed state and take it back afterwards
+	Body2DSW **body_ptr = p_constraint->get_body_ptr();
+	int body_ptr_count = p_constraint->get_body_count();
+	Body *b = bodies.ptr();
+
+	for (int i = 0; i < body_ptr_count; i++) {
+
+		int index = body_ptr[i]->get_solver_index();
+		if (index < 0)
+			continue;
+
+		body_ptr[i]->set_linear_velocity(b[index].linear_velocity);
+		body_ptr[i]->set_biased_linear_velocity(b[index].biased_linear_velocity);
+		body_ptr[i]->set_angular_velocity(b[index].angular_velocity);
+		body_ptr[i]->set_biased_angular_velocity(b[index].biased_angular_velocity);
+	}
+
+	p_constraint->solve(p_step);
+
+	for (int i = 0; i < body_ptr_count; i++) {
+
+		int index = body_ptr[i]->get_solver_index();
+		if (index < 0)
+			continue;
+
+		b[index].linear_velocity = body_ptr[i]->get_linear_velocity();
+		b[index].biased_linear_velocity = body_ptr[i]->get_biased_linear_velocity();
+		b[index].angular_velocity = body_ptr[i]->get_angular_velocity();
+		b[index].biased_angular_velocity = body_ptr[i]->get_biased_angular_velocity();
+	}
+}
+
+void IslandSolver2DSW::solve(int p_iterations, float p_step) {
+
+	const Run *r = runs.ptr();
+
+	for (int i = 0; i < p_iterations; i++) {
+
+		for (int j = 0; j < run_count; j++) {
+
+			if (r[j].constraint) {
+				_solve_constraint(r[j].constraint, p_step);
+			} else {
+				_solve_contacts(r[j].from, r[j].to);
+			}
+		}
+	}
+}
+
+void IslandSolver2DSW::finish() {
+
+	Body *b = bodies.ptr();
+
+	for (int i = 0; i < body_count; i++) {
+
+		if (!b[i].body)
+			continue;
+
+		b[i].body->set_linear_velocity(b[i].linear_velocity);
+		b[i].body->set_biased_linear_velocity(b[i].biased_linear_velocity);
+		b[i].body->set_angular_velocity(b[i].angular_velocity);
+		b[i].body->set_biased_angular_velocity(b[i].biased_angular_velocity);
+		b[i].body->set_solver_index(-1);
+	}
+
+	const Packed *p = packed.ptr();
+
+	for (int i = 0; i < packed_count; i++) {
+		p[i].constraint->unpack(this, p[i].from);
+	}
+}
+
+IslandSolver2DSW::IslandSolver2DSW() {
+
+	body_count = 0;
+	contact_count = 0;
+	run_count = 0;
+	packed_count = 0;
+}
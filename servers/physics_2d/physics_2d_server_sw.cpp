@@ -28,10 +28,12 @@
 /*************************************************************************/
 #include "physics_2d_server_sw.h"
 #include "broad_phase_2d_basic.h"
+#include "broad_phase_2d_bvh.h"
 #include "broad_phase_2d_hash_grid.h"
 #include "collision_solver_2d_sw.h"
 #include "globals.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "script_language.h"
 
 RID Physics2DServerSW::shape_create(ShapeType p_shape) {
@@ -1172,11 +1174,18 @@ void Physics2DServerSW::init() {
 	last_step = 0.001;
 	iterations = 8; // 8?
 	stepper = memnew(Step2DSW);
+	//0 solves islands on the physics thread only, -1 uses one thread per core
+	stepper->set_thread_count(GLOBAL_DEF("physics_2d/island_solver_threads", 0));
+	Globals::get_singleton()->set_custom_property_info("physics_2d/island_solver_threads", PropertyInfo(Variant::INT, "physics_2d/island_solver_threads", PROPERTY_HINT_RANGE, "-1,64,1"));
+	query_work_pool.init(GLOBAL_DEF("physics_2d/batch_query_threads", 0));
+	Globals::get_singleton()->set_custom_property_info("physics_2d/batch_query_threads", PropertyInfo(Variant::INT, "physics_2d/batch_query_threads", PROPERTY_HINT_RANGE, "-1,64,1"));
 	direct_state = memnew(Physics2DDirectBodyStateSW);
 };
 
 void Physics2DServerSW::step(float p_step) {
 
+	TRACE_ZONE("Physics2DServer::step");
+
 	if (!active)
 		return;
 
@@ -1187,12 +1196,19 @@ void Physics2DServerSW::step(float p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	broad_phase_time = 0;
+	narrow_phase_time = 0;
+	solve_time = 0;
 	for (Set<const Space2DSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
 
 		stepper->step((Space2DSW *)E->get(), p_step, iterations);
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
 		collision_pairs += E->get()->get_collision_pairs();
+		broad_phase_time += E->get()->get_elapsed_time(Space2DSW::ELAPSED_TIME_BROAD_PHASE);
+		//contacts are generated when the pair constraints are set up
+		narrow_phase_time += E->get()->get_elapsed_time(Space2DSW::ELAPSED_TIME_SETUP_CONSTRAINTS);
+		solve_time += E->get()->get_elapsed_time(Space2DSW::ELAPSED_TIME_SOLVE_CONSTRAINTS);
 	}
 };
 
@@ -1222,7 +1238,8 @@ void Physics2DServerSW::flush_queries() {
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"broad_phase"
 		};
 
 		for (int i = 0; i < Space2DSW::ELAPSED_TIME_MAX; i++) {
@@ -1255,6 +1272,7 @@ void Physics2DServerSW::end_sync() {
 
 void Physics2DServerSW::finish() {
 
+	query_work_pool.finish();
 	memdelete(stepper);
 	memdelete(direct_state);
 };
@@ -1274,6 +1292,19 @@ int Physics2DServerSW::get_process_info(ProcessInfo p_info) {
 
 			return island_count;
 		} break;
+		case INFO_BROAD_PHASE_TIME: {
+
+			return broad_phase_time;
+		} break;
+		case INFO_NARROW_PHASE_TIME: {
+
+			return narrow_phase_time;
+		} break;
+		case INFO_SOLVE_TIME: {
+
+			return solve_time;
+		} break;
+		default: {}
 	}
 
 	return 0;
@@ -1284,13 +1315,22 @@ Physics2DServerSW *Physics2DServerSW::singletonsw = NULL;
 Physics2DServerSW::Physics2DServerSW() {
 
 	singletonsw = this;
-	BroadPhase2DSW::create_func = BroadPhase2DHashGrid::_create;
+	String broad_phase = GLOBAL_DEF("physics_2d/broad_phase", "HashGrid");
+	Globals::get_singleton()->set_custom_property_info("physics_2d/broad_phase", PropertyInfo(Variant::STRING, "physics_2d/broad_phase", PROPERTY_HINT_ENUM, "HashGrid,BVH"));
+
+	if (broad_phase == "BVH")
+		BroadPhase2DSW::create_func = BroadPhase2DBVH::_create;
+	else
+		BroadPhase2DSW::create_func = BroadPhase2DHashGrid::_create;
 	//	BroadPhase2DSW::create_func=BroadPhase2DBasic::_create;
 
 	active = true;
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	broad_phase_time = 0;
+	narrow_phase_time = 0;
+	solve_time = 0;
 	using_threads = int(Globals::get_singleton()->get("physics_2d/thread_model")) == 2;
 };
 
@@ -30,6 +30,7 @@
 #define PHYSICS_2D_SERVER_SW
 
 #include "joints_2d_sw.h"
+#include "os/thread_work_pool.h"
 #include "servers/physics_2d_server.h"
 #include "shape_2d_sw.h"
 #include "space_2d_sw.h"
@@ -49,12 +50,17 @@ class Physics2DServerSW : public Physics2DServer {
 	int island_count;
 	int active_objects;
 	int collision_pairs;
+	uint64_t broad_phase_time;
+	uint64_t narrow_phase_time;
+	uint64_t solve_time;
 
 	bool using_threads;
 
 	Step2DSW *stepper;
 	Set<const Space2DSW *> active_spaces;
 
+	ThreadWorkPool query_work_pool; //splits batched space queries
+
 	Physics2DDirectBodyStateSW *direct_state;
 
 	mutable RID_Owner<Shape2DSW> shape_owner;
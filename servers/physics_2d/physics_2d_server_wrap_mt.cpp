@@ -29,6 +29,7 @@
 #include "physics_2d_server_wrap_mt.h"
 
 #include "os/os.h"
+#include "os/trace.h"
 
 void Physics2DServerWrapMT::thread_exit() {
 
@@ -51,6 +52,7 @@ void Physics2DServerWrapMT::_thread_callback(void *_instance) {
 void Physics2DServerWrapMT::thread_loop() {
 
 	server_thread = Thread::get_caller_ID();
+	Trace::set_thread_name("physics_2d");
 
 	OS::get_singleton()->make_rendering_thread();
 
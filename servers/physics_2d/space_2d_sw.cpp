@@ -94,9 +94,9 @@ int Physics2DDirectSpaceStateSW::intersect_point(const Vector2 &p_point, ShapeRe
 	return cc;
 }
 
-bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+static bool _intersect_ray_candidates(const Vector2 &p_from, const Vector2 &p_to, CollisionObject2DSW *const *p_objects, const int *p_shapes, int p_amount, bool p_check_aabb, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, Physics2DDirectSpaceState::RayResult &r_result, const CollisionObject2DSW **r_object) {
 
-	ERR_FAIL_COND_V(space->locked, false);
+	//fills everything but the collider and metadata, looking them up is not thread safe
 
 	Vector2 begin, end;
 	Vector2 normal;
@@ -104,27 +104,27 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
-	//todo, create another array tha references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
-
 	bool collided = false;
 	Vector2 res_point, res_normal;
 	int res_shape;
 	const CollisionObject2DSW *res_obj;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+		if (!_match_object_type_query(p_objects[i], p_layer_mask, p_object_type_mask))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue;
 
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
+		const CollisionObject2DSW *col_obj = p_objects[i];
+
+		int shape_idx = p_shapes[i];
+
+		if (p_check_aabb && !col_obj->get_shape_aabb(shape_idx).intersects_segment(begin, end))
+			continue; //candidate shared with other queries
 
-		int shape_idx = space->intersection_query_subindex_results[i];
 		Matrix32 inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -163,86 +163,38 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 		return false;
 
 	r_result.collider_id = res_obj->get_instance_id();
-	if (r_result.collider_id != 0)
-		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	r_result.collider = NULL;
 	r_result.normal = res_normal;
-	r_result.metadata = res_obj->get_shape_metadata(res_shape);
 	r_result.position = res_point;
 	r_result.rid = res_obj->get_self();
 	r_result.shape = res_shape;
+	*r_object = res_obj;
 
 	return true;
 }
 
-int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Matrix32 &p_xform, const Vector2 &p_motion, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
-
-	if (p_result_max <= 0)
-		return 0;
-
-	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
-	ERR_FAIL_COND_V(!shape, 0);
-
-	Rect2 aabb = p_xform.xform(shape->get_aabb());
-	aabb = aabb.grow(p_margin);
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, p_result_max, space->intersection_query_subindex_results);
-
-	int cc = 0;
-
-	for (int i = 0; i < amount; i++) {
-
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
-			continue;
-
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
-			continue;
-
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
-
-		if (!CollisionSolver2DSW::solve(shape, p_xform, p_motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), NULL, NULL, NULL, p_margin))
-			continue;
-
-		r_results[cc].collider_id = col_obj->get_instance_id();
-		if (r_results[cc].collider_id != 0)
-			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
-		r_results[cc].rid = col_obj->get_self();
-		r_results[cc].shape = shape_idx;
-		r_results[cc].metadata = col_obj->get_shape_metadata(shape_idx);
-
-		cc++;
-	}
+static bool _cast_motion_candidates(Shape2DSW *p_shape, const Matrix32 &p_xform, const Vector2 &p_motion, float p_margin, float p_max_penetration, CollisionObject2DSW *const *p_objects, const int *p_shapes, int p_amount, bool p_check_aabb, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask, float &r_closest_safe, float &r_closest_unsafe) {
 
-	return cc;
-}
-
-bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32 &p_xform, const Vector2 &p_motion, float p_margin, float &p_closest_safe, float &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
-
-	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
-	ERR_FAIL_COND_V(!shape, false);
-
-	Rect2 aabb = p_xform.xform(shape->get_aabb());
+	Rect2 aabb = p_xform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(Rect2(aabb.pos + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_margin);
 
-	//if (p_motion!=Vector2())
-	//	print_line(p_motion);
-
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	float best_safe = 1;
 	float best_unsafe = 1;
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 
-		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+		if (!_match_object_type_query(p_objects[i], p_layer_mask, p_object_type_mask))
 			continue;
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+		if (p_exclude.has(p_objects[i]->get_self()))
 			continue; //ignore excluded
 
-		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject2DSW *col_obj = p_objects[i];
+		int shape_idx = p_shapes[i];
+
+		if (p_check_aabb && !col_obj->get_shape_aabb(shape_idx).intersects(aabb))
+			continue; //candidate shared with other queries
 
 		/*if (col_obj->get_type()==CollisionObject2DSW::TYPE_BODY) {
 
@@ -255,12 +207,12 @@ bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32
 
 		Matrix32 col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!CollisionSolver2DSW::solve(shape, p_xform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, NULL, p_margin)) {
+		if (!CollisionSolver2DSW::solve(p_shape, p_xform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, NULL, p_margin)) {
 			continue;
 		}
 
 		//test initial overlap
-		if (CollisionSolver2DSW::solve(shape, p_xform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, NULL, p_margin)) {
+		if (CollisionSolver2DSW::solve(p_shape, p_xform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, NULL, p_margin)) {
 
 			if (col_obj->get_type() == CollisionObject2DSW::TYPE_BODY) {
 				//if one way collision direction ignore initial overlap
@@ -283,7 +235,7 @@ bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32
 			float ofs = (low + hi) * 0.5;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = CollisionSolver2DSW::solve(shape, p_xform, p_motion * ofs, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, &sep, p_margin);
+			bool collided = CollisionSolver2DSW::solve(p_shape, p_xform, p_motion * ofs, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), NULL, NULL, &sep, p_margin);
 
 			if (collided) {
 
@@ -308,7 +260,7 @@ bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32
 				cbk.valid_depth = body->get_one_way_collision_max_depth();
 
 				Vector2 sep = mnormal; //important optimization for this to work fast enough
-				bool collided = CollisionSolver2DSW::solve(shape, p_xform, p_motion * (hi + space->contact_max_allowed_penetration), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), Physics2DServerSW::_shape_col_cbk, &cbk, &sep, p_margin);
+				bool collided = CollisionSolver2DSW::solve(p_shape, p_xform, p_motion * (hi + p_max_penetration), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), Physics2DServerSW::_shape_col_cbk, &cbk, &sep, p_margin);
 				if (!collided || cbk.amount == 0) {
 					continue;
 				}
@@ -321,12 +273,90 @@ bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32
 		}
 	}
 
-	p_closest_safe = best_safe;
-	p_closest_unsafe = best_unsafe;
+	r_closest_safe = best_safe;
+	r_closest_unsafe = best_unsafe;
 
 	return true;
 }
 
+bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	//todo, create another array tha references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
+
+	const CollisionObject2DSW *res_obj;
+	if (!_intersect_ray_candidates(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, p_exclude, p_layer_mask, p_object_type_mask, r_result, &res_obj))
+		return false;
+
+	if (r_result.collider_id != 0)
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	r_result.metadata = res_obj->get_shape_metadata(r_result.shape);
+
+	return true;
+}
+
+int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Matrix32 &p_xform, const Vector2 &p_motion, float p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	if (p_result_max <= 0)
+		return 0;
+
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	Rect2 aabb = p_xform.xform(shape->get_aabb());
+	aabb = aabb.grow(p_margin);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, p_result_max, space->intersection_query_subindex_results);
+
+	int cc = 0;
+
+	for (int i = 0; i < amount; i++) {
+
+		if (!_match_object_type_query(space->intersection_query_results[i], p_layer_mask, p_object_type_mask))
+			continue;
+
+		if (p_exclude.has(space->intersection_query_results[i]->get_self()))
+			continue;
+
+		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
+		int shape_idx = space->intersection_query_subindex_results[i];
+
+		if (!CollisionSolver2DSW::solve(shape, p_xform, p_motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), NULL, NULL, NULL, p_margin))
+			continue;
+
+		r_results[cc].collider_id = col_obj->get_instance_id();
+		if (r_results[cc].collider_id != 0)
+			r_results[cc].collider = ObjectDB::get_instance(r_results[cc].collider_id);
+		r_results[cc].rid = col_obj->get_self();
+		r_results[cc].shape = shape_idx;
+		r_results[cc].metadata = col_obj->get_shape_metadata(shape_idx);
+
+		cc++;
+	}
+
+	return cc;
+}
+
+bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Matrix32 &p_xform, const Vector2 &p_motion, float p_margin, float &p_closest_safe, float &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, false);
+
+	Rect2 aabb = p_xform.xform(shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.pos + p_motion, aabb.size)); //motion
+	aabb = aabb.grow(p_margin);
+
+	//if (p_motion!=Vector2())
+	//	print_line(p_motion);
+
+	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _cast_motion_candidates(shape, p_xform, p_motion, p_margin, space->contact_max_allowed_penetration, space->intersection_query_results, space->intersection_query_subindex_results, amount, false, p_exclude, p_layer_mask, p_object_type_mask, p_closest_safe, p_closest_unsafe);
+}
+
 bool Physics2DDirectSpaceStateSW::collide_shape(RID p_shape, const Matrix32 &p_shape_xform, const Vector2 &p_motion, float p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
 
 	if (p_result_max <= 0)
@@ -491,6 +521,244 @@ bool Physics2DDirectSpaceStateSW::rest_info(RID p_shape, const Matrix32 &p_shape
 	return true;
 }
 
+/* BATCHED QUERIES */
+
+//queries close to each other are grouped, so each group needs a single broadphase cull
+#define QUERY_BATCH_GROUP_MAX 16
+
+struct _QueryBatch2DSW {
+
+	struct Group {
+
+		int from;
+		int count;
+		int candidate_ofs;
+		int candidate_count;
+	};
+
+	Vector<Group> groups;
+	Vector<CollisionObject2DSW *> candidates;
+	Vector<int> candidate_shapes;
+
+	void build(BroadPhase2DSW *p_broadphase, const Rect2 *p_aabbs, const Vector2 *p_from, const Vector2 *p_to, int p_count, CollisionObject2DSW **p_results, int *p_subindices, int p_max) {
+
+		int i = 0;
+
+		while (i < p_count) {
+
+			//grow the group while it stays small compared to the queries in it
+			Rect2 bounds = p_aabbs[i];
+			real_t extent = MAX(bounds.size.x, bounds.size.y);
+			int count = 1;
+
+			while (i + count < p_count && count < QUERY_BATCH_GROUP_MAX) {
+
+				const Rect2 &next = p_aabbs[i + count];
+				Rect2 merged = bounds.merge(next);
+				real_t merged_extent = MAX(extent, MAX(next.size.x, next.size.y));
+				if (MAX(merged.size.x, merged.size.y) > merged_extent * 2.0)
+					break;
+				bounds = merged;
+				extent = merged_extent;
+				count++;
+			}
+
+			int amount;
+			if (count == 1 && p_from)
+				amount = p_broadphase->cull_segment(p_from[i], p_to[i], p_results, p_max, p_subindices);
+			else
+				amount = p_broadphase->cull_aabb(bounds, p_results, p_max, p_subindices);
+
+			if (count > 1 && amount >= p_max) {
+				//too crowded to share, the rest of the group is grouped again
+				count = 1;
+				if (p_from)
+					amount = p_broadphase->cull_segment(p_from[i], p_to[i], p_results, p_max, p_subindices);
+				else
+					amount = p_broadphase->cull_aabb(p_aabbs[i], p_results, p_max, p_subindices);
+			}
+
+			Group g;
+			g.from = i;
+			g.count = count;
+			g.candidate_ofs = candidates.size();
+			g.candidate_count = amount;
+			groups.push_back(g);
+
+			candidates.resize(g.candidate_ofs + amount);
+			candidate_shapes.resize(g.candidate_ofs + amount);
+			CollisionObject2DSW **c = candidates.ptr() + g.candidate_ofs;
+			int *cs = candidate_shapes.ptr() + g.candidate_ofs;
+			for (int j = 0; j < amount; j++) {
+				c[j] = p_results[j];
+				cs[j] = p_subindices[j];
+			}
+
+			i += count;
+		}
+	}
+};
+
+struct _RayBatch2DSW {
+
+	const _QueryBatch2DSW *batch;
+	const Vector2 *from;
+	const Vector2 *to;
+	Physics2DDirectSpaceState::RayResult *results;
+	const CollisionObject2DSW **objects;
+	const Set<RID> *exclude;
+	uint32_t layer_mask;
+	uint32_t object_type_mask;
+
+	void process_group(uint32_t p_group, void *p_userdata) {
+
+		const _QueryBatch2DSW::Group &g = batch->groups[p_group];
+		CollisionObject2DSW *const *candidates = batch->candidates.ptr() + g.candidate_ofs;
+		const int *shapes = batch->candidate_shapes.ptr() + g.candidate_ofs;
+
+		for (int i = g.from; i < g.from + g.count; i++) {
+
+			if (_intersect_ray_candidates(from[i], to[i], candidates, shapes, g.candidate_count, g.count > 1, *exclude, layer_mask, object_type_mask, results[i], &objects[i]))
+				continue;
+
+			results[i].position = Vector2();
+			results[i].normal = Vector2();
+			results[i].rid = RID();
+			results[i].collider_id = 0;
+			results[i].collider = NULL;
+			results[i].shape = -1;
+			objects[i] = NULL;
+		}
+	}
+};
+
+struct _MotionBatch2DSW {
+
+	const _QueryBatch2DSW *batch;
+	Shape2DSW *shape;
+	const Matrix32 *xforms;
+	const Vector2 *motions;
+	float margin;
+	float max_penetration;
+	float *closest_safe;
+	float *closest_unsafe;
+	const Set<RID> *exclude;
+	uint32_t layer_mask;
+	uint32_t object_type_mask;
+
+	void process_group(uint32_t p_group, void *p_userdata) {
+
+		const _QueryBatch2DSW::Group &g = batch->groups[p_group];
+		CollisionObject2DSW *const *objects = batch->candidates.ptr() + g.candidate_ofs;
+		const int *shapes = batch->candidate_shapes.ptr() + g.candidate_ofs;
+
+		for (int i = g.from; i < g.from + g.count; i++) {
+
+			if (!_cast_motion_candidates(shape, xforms[i], motions[i], margin, max_penetration, objects, shapes, g.candidate_count, g.count > 1, *exclude, layer_mask, object_type_mask, closest_safe[i], closest_unsafe[i])) {
+				//starts stuck
+				closest_safe[i] = 0;
+				closest_unsafe[i] = 0;
+			}
+		}
+	}
+};
+
+int Physics2DDirectSpaceStateSW::intersect_rays_batch(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	if (p_count <= 0)
+		return 0;
+
+	Vector<Rect2> aabbs;
+	aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Rect2 &aabb = aabbs[i];
+		aabb.pos = p_from[i];
+		aabb.size = Vector2();
+		aabb.expand_to(p_to[i]);
+	}
+
+	//broadphase culls use the space buffers, so they run here, only the narrow phase is split
+	_QueryBatch2DSW batch;
+	batch.build(space->broadphase, aabbs.ptr(), p_from, p_to, p_count, space->intersection_query_results, space->intersection_query_subindex_results, Space2DSW::INTERSECTION_QUERY_MAX);
+
+	Vector<const CollisionObject2DSW *> objects;
+	objects.resize(p_count);
+
+	_RayBatch2DSW rays;
+	rays.batch = &batch;
+	rays.from = p_from;
+	rays.to = p_to;
+	rays.results = r_results;
+	rays.objects = objects.ptr();
+	rays.exclude = &p_exclude;
+	rays.layer_mask = p_layer_mask;
+	rays.object_type_mask = p_object_type_mask;
+
+	Physics2DServerSW::singletonsw->query_work_pool.do_work(batch.groups.size(), &rays, &_RayBatch2DSW::process_group, (void *)NULL);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+
+		if (!objects[i]) {
+			r_results[i].metadata = Variant();
+			continue;
+		}
+		hits++;
+		if (r_results[i].collider_id != 0)
+			r_results[i].collider = ObjectDB::get_instance(r_results[i].collider_id);
+		r_results[i].metadata = objects[i]->get_shape_metadata(r_results[i].shape);
+	}
+
+	return hits;
+}
+
+int Physics2DDirectSpaceStateSW::cast_motion_batch(const RID &p_shape, const Matrix32 *p_xforms, const Vector2 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
+	ERR_FAIL_COND_V(!shape, 0);
+
+	if (p_count <= 0)
+		return 0;
+
+	Vector<Rect2> aabbs;
+	aabbs.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Rect2 aabb = p_xforms[i].xform(shape->get_aabb());
+		aabb = aabb.merge(Rect2(aabb.pos + p_motions[i], aabb.size));
+		aabbs[i] = aabb.grow(p_margin);
+	}
+
+	_QueryBatch2DSW batch;
+	batch.build(space->broadphase, aabbs.ptr(), NULL, NULL, p_count, space->intersection_query_results, space->intersection_query_subindex_results, Space2DSW::INTERSECTION_QUERY_MAX);
+
+	_MotionBatch2DSW motions;
+	motions.batch = &batch;
+	motions.shape = shape;
+	motions.xforms = p_xforms;
+	motions.motions = p_motions;
+	motions.margin = p_margin;
+	motions.max_penetration = space->contact_max_allowed_penetration;
+	motions.closest_safe = r_closest_safe;
+	motions.closest_unsafe = r_closest_unsafe;
+	motions.exclude = &p_exclude;
+	motions.layer_mask = p_layer_mask;
+	motions.object_type_mask = p_object_type_mask;
+
+	Physics2DServerSW::singletonsw->query_work_pool.do_work(batch.groups.size(), &motions, &_MotionBatch2DSW::process_group, (void *)NULL);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_closest_safe[i] < 1)
+			hits++;
+	}
+
+	return hits;
+}
+
 Physics2DDirectSpaceStateSW::Physics2DDirectSpaceStateSW() {
 
 	space = NULL;
@@ -1167,6 +1435,9 @@ void Space2DSW::setup() {
 		inertia_update_list.first()->self()->update_inertias();
 		inertia_update_list.remove(inertia_update_list.first());
 	}
+
+	//broadphases that defer pairing need objects moved since the last step paired before islands are built
+	broadphase->update();
 }
 
 void Space2DSW::update() {
@@ -1230,6 +1501,7 @@ Space2DSW::Space2DSW() {
 	island_count = 0;
 
 	contact_debug_count = 0;
+	step_mutex = NULL;
 
 	locked = false;
 	contact_recycle_radius = 1.0;
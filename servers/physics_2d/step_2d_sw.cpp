@@ -35,12 +35,19 @@ void Step2DSW::_populate_island(Body2DSW *p_body, Body2DSW **p_island, Constrain
 	p_body->set_island_next(*p_island);
 	*p_island = p_body;
 
-	for (Map<Constraint2DSW *, int>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
+	for (Map<Constraint2DSW *, int, Constraint2DOrderSW>::Element *E = p_body->get_constraint_map().front(); E; E = E->next()) {
 
 		Constraint2DSW *c = (Constraint2DSW *)E->key();
 		if (c->get_island_step() == _step)
 			continue; //already processed
 		c->set_island_step(_step);
+
+		if (c->get_body_count() == 0) {
+			//area pairs touch areas shared between islands and have nothing to solve, set them up apart
+			area_constraints.push_back(c);
+			continue;
+		}
+
 		c->set_island_next(*p_constraint_island);
 		*p_constraint_island = c;
 
@@ -80,19 +87,15 @@ bool Step2DSW::_setup_island(Constraint2DSW *p_island, float p_delta) {
 	return removed_root;
 }
 
-void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, float p_delta) {
+void Step2DSW::_solve_island(Constraint2DSW *p_island, int p_iterations, float p_delta, IslandSolver2DSW *p_solver) {
 
-	for (int i = 0; i < p_iterations; i++) {
-
-		Constraint2DSW *ci = p_island;
-		while (ci) {
-			ci->solve(p_delta);
-			ci = ci->get_island_next();
-		}
-	}
+	//iterations run over packed body and contact arrays, results are copied back to the bodies at the end
+	p_solver->setup(p_island);
+	p_solver->solve(p_iterations, p_delta);
+	p_solver->finish();
 }
 
-void Step2DSW::_check_suspend(Body2DSW *p_island, float p_delta) {
+bool Step2DSW::_test_island_sleep(Body2DSW *p_island, float p_delta) {
 
 	bool can_sleep = true;
 
@@ -110,9 +113,14 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, float p_delta) {
 		b = b->get_island_next();
 	}
 
+	return can_sleep;
+}
+
+void Step2DSW::_check_suspend(Body2DSW *p_island, bool p_can_sleep) {
+
 	//put all to sleep or wake up everyoen
 
-	b = p_island;
+	Body2DSW *b = p_island;
 	while (b) {
 
 		if (b->get_mode() == Physics2DServer::BODY_MODE_STATIC || b->get_mode() == Physics2DServer::BODY_MODE_KINEMATIC) {
@@ -122,13 +130,35 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, float p_delta) {
 
 		bool active = b->is_active();
 
-		if (active == can_sleep)
-			b->set_active(!can_sleep);
+		if (active == p_can_sleep)
+			b->set_active(!p_can_sleep);
 
 		b = b->get_island_next();
 	}
 }
 
+void Step2DSW::_setup_island_job(uint32_t p_index, Constraint2DSW **p_islands) {
+
+	Constraint2DSW *island = p_islands[p_index];
+
+	if (_setup_island(island, _delta)) {
+		//removed the root from the island graph because it is not to be processed, the next one (if any) takes its place
+		p_islands[p_index] = island->get_island_next();
+	}
+}
+
+void Step2DSW::_solve_island_job(uint32_t p_index, Constraint2DSW **p_islands) {
+
+	if (p_islands[p_index]) {
+		_solve_island(p_islands[p_index], _iterations, _delta, &island_solvers[p_index]);
+	}
+}
+
+void Step2DSW::_test_island_sleep_job(uint32_t p_index, BodyIsland *p_islands) {
+
+	p_islands[p_index].can_sleep = _test_island_sleep(p_islands[p_index].bodies, _delta);
+}
+
 void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 
 	p_space->lock(); // can't access space during this
@@ -141,6 +171,7 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
+	uint64_t broad_phase_time = 0;
 
 	int active_count = 0;
 
@@ -160,36 +191,52 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 		profile_begtime = profile_endtime;
 	}
 
+	//moving shapes is where the octree and hash grid find pairs, so it's timed as broad phase
+	b = body_list->first();
+	while (b) {
+		b->self()->update_pending_shapes();
+		b = b->next();
+	}
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		broad_phase_time = profile_endtime - profile_begtime;
+		profile_begtime = profile_endtime;
+	}
+
 	/* GENERATE CONSTRAINT ISLANDS */
 
-	Body2DSW *island_list = NULL;
-	Constraint2DSW *constraint_island_list = NULL;
-	b = body_list->first();
+	_delta = p_delta;
+	_iterations = p_iterations;
 
-	int island_count = 0;
+	body_islands.clear();
+	constraint_islands.clear();
+	area_constraints.clear();
+
+	b = body_list->first();
 
 	while (b) {
 		Body2DSW *body = b->self();
 
 		if (body->get_island_step() != _step) {
 
-			Body2DSW *island = NULL;
+			BodyIsland island;
+			island.bodies = NULL;
+			island.can_sleep = false;
+
 			Constraint2DSW *constraint_island = NULL;
-			_populate_island(body, &island, &constraint_island);
+			_populate_island(body, &island.bodies, &constraint_island);
 
-			island->set_island_list_next(island_list);
-			island_list = island;
+			body_islands.push_back(island);
 
 			if (constraint_island) {
-				constraint_island->set_island_list_next(constraint_island_list);
-				constraint_island_list = constraint_island;
-				island_count++;
+				constraint_islands.push_back(constraint_island);
 			}
 		}
 		b = b->next();
 	}
 
-	p_space->set_island_count(island_count);
+	p_space->set_island_count(constraint_islands.size());
 
 	const SelfList<Area2DSW>::List &aml = p_space->get_moved_area_list();
 
@@ -200,9 +247,7 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 			if (c->get_island_step() == _step)
 				continue;
 			c->set_island_step(_step);
-			c->set_island_next(NULL);
-			c->set_island_list_next(constraint_island_list);
-			constraint_island_list = c;
+			area_constraints.push_back(c);
 		}
 		p_space->area_remove_from_moved_list((SelfList<Area2DSW> *)aml.first()); //faster to remove here
 	}
@@ -217,43 +262,14 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 
 	/* SETUP CONSTRAINT ISLANDS */
 
-	{
-		Constraint2DSW *ci = constraint_island_list;
-		Constraint2DSW *prev_ci = NULL;
-		while (ci) {
-
-			if (_setup_island(ci, p_delta) == true) {
-
-				//removed the root from the island graph because it is not to be processed
-
-				Constraint2DSW *next = ci->get_island_next();
-
-				if (next) {
-					//root from list being deleted no longer exists, replace by next
-					next->set_island_list_next(ci->get_island_list_next());
-					if (prev_ci) {
-						prev_ci->set_island_list_next(next);
-					} else {
-						constraint_island_list = next;
-					}
-					prev_ci = next;
-				} else {
-
-					//list is empty, just skip
-					if (prev_ci) {
-						prev_ci->set_island_list_next(ci->get_island_list_next());
+	for (int i = 0; i < area_constraints.size(); i++) {
+		area_constraints[i]->setup(p_delta);
+	}
 
-					} else {
-						constraint_island_list = ci->get_island_list_next();
-					}
-				}
-			} else {
-				prev_ci = ci;
-			}
+	//islands don't share any dynamic body, so they can be processed in parallel
+	p_space->set_step_mutex(step_mutex);
 
-			ci = ci->get_island_list_next();
-		}
-	}
+	work_pool.do_work(constraint_islands.size(), this, &Step2DSW::_setup_island_job, constraint_islands.ptr());
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -263,15 +279,16 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
-	{
-		Constraint2DSW *ci = constraint_island_list;
-		while (ci) {
-			//iterating each island separatedly improves cache efficiency
-			_solve_island(ci, p_iterations, p_delta);
-			ci = ci->get_island_list_next();
-		}
+	//solvers are kept between steps so their buffers are reused, resize before the jobs run as it's not thread safe
+	if (island_solvers.size() < constraint_islands.size()) {
+		island_solvers.resize(constraint_islands.size());
 	}
 
+	//iterating each island separatedly improves cache efficiency
+	work_pool.do_work(constraint_islands.size(), this, &Step2DSW::_solve_island_job, constraint_islands.ptr());
+
+	p_space->set_step_mutex(NULL);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(Space2DSW::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
@@ -288,29 +305,77 @@ void Step2DSW::step(Space2DSW *p_space, float p_delta, int p_iterations) {
 		b = n; // in case it shuts itself down
 	}
 
+	uint64_t move_begtime = OS::get_singleton()->get_ticks_usec();
+
+	b = body_list->first();
+	while (b) {
+		b->self()->update_pending_shapes();
+		b = b->next();
+	}
+
+	uint64_t move_endtime = OS::get_singleton()->get_ticks_usec();
+	broad_phase_time += move_endtime - move_begtime;
+
 	/* SLEEP / WAKE UP ISLANDS */
 
-	{
-		Body2DSW *bi = island_list;
-		while (bi) {
+	work_pool.do_work(body_islands.size(), this, &Step2DSW::_test_island_sleep_job, body_islands.ptr());
 
-			_check_suspend(bi, p_delta);
-			bi = bi->get_island_list_next();
-		}
+	//changing the active state modifies the space lists, so it's done serially
+	for (int i = 0; i < body_islands.size(); i++) {
+		_check_suspend(body_islands[i].bodies, body_islands[i].can_sleep);
 	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(Space2DSW::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
-		//profile_begtime=profile_endtime;
+		p_space->set_elapsed_time(Space2DSW::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime - (move_endtime - move_begtime));
+		profile_begtime = profile_endtime;
 	}
 
 	p_space->update();
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(Space2DSW::ELAPSED_TIME_BROAD_PHASE, profile_endtime - profile_begtime + broad_phase_time);
+		//profile_begtime=profile_endtime;
+	}
 	p_space->unlock();
 	_step++;
 }
 
+void Step2DSW::set_thread_count(int p_thread_count) {
+
+	work_pool.finish();
+	if (step_mutex) {
+		memdelete(step_mutex);
+		step_mutex = NULL;
+	}
+
+	if (p_thread_count == 0)
+		return;
+
+	work_pool.init(p_thread_count);
+	if (work_pool.get_thread_count() > 0) {
+		step_mutex = Mutex::create();
+	}
+}
+
+int Step2DSW::get_thread_count() const {
+
+	return work_pool.get_thread_count();
+}
+
 Step2DSW::Step2DSW() {
 
 	_step = 1;
+	_delta = 0;
+	_iterations = 0;
+	step_mutex = NULL;
+}
+
+Step2DSW::~Step2DSW() {
+
+	work_pool.finish();
+	if (step_mutex) {
+		memdelete(step_mutex);
+	}
 }
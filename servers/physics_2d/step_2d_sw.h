@@ -29,20 +29,48 @@
 #ifndef STEP_2D_SW_H
 #define STEP_2D_SW_H
 
+#include "island_solver_2d_sw.h"
+#include "os/thread_work_pool.h"
 #include "space_2d_sw.h"
 
 class Step2DSW {
 
 	uint64_t _step;
 
+	float _delta;
+	int _iterations;
+
+	ThreadWorkPool work_pool;
+	Mutex *step_mutex;
+
+	struct BodyIsland {
+
+		Body2DSW *bodies;
+		bool can_sleep;
+	};
+
+	Vector<BodyIsland> body_islands;
+	Vector<Constraint2DSW *> constraint_islands;
+	Vector<Constraint2DSW *> area_constraints;
+	Vector<IslandSolver2DSW> island_solvers;
+
 	void _populate_island(Body2DSW *p_body, Body2DSW **p_island, Constraint2DSW **p_constraint_island);
 	bool _setup_island(Constraint2DSW *p_island, float p_delta);
-	void _solve_island(Constraint2DSW *p_island, int p_iterations, float p_delta);
-	void _check_suspend(Body2DSW *p_island, float p_delta);
+	void _solve_island(Constraint2DSW *p_island, int p_iterations, float p_delta, IslandSolver2DSW *p_solver);
+	bool _test_island_sleep(Body2DSW *p_island, float p_delta);
+	void _check_suspend(Body2DSW *p_island, bool p_can_sleep);
+
+	void _setup_island_job(uint32_t p_index, Constraint2DSW **p_islands);
+	void _solve_island_job(uint32_t p_index, Constraint2DSW **p_islands);
+	void _test_island_sleep_job(uint32_t p_index, BodyIsland *p_islands);
 
 public:
+	void set_thread_count(int p_thread_count);
+	int get_thread_count() const;
+
 	void step(Space2DSW *p_space, float p_delta, int p_iterations);
 	Step2DSW();
+	~Step2DSW();
 };
 
 #endif // STEP_2D_SW_H
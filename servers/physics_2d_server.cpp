@@ -340,6 +340,136 @@ Dictionary Physics2DDirectSpaceState::_get_rest_info(const Ref<Physics2DShapeQue
 	return r;
 }
 
+Dictionary Physics2DDirectSpaceState::_intersect_rays_batch(const Vector2Array &p_from, const Vector2Array &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+	Vector<RayResult> results;
+	results.resize(count);
+
+	if (count) {
+		Vector2Array::Read from = p_from.read();
+		Vector2Array::Read to = p_to.read();
+		intersect_rays_batch(from.ptr(), to.ptr(), count, results.ptr(), exclude, p_layers, p_object_type_mask);
+	}
+
+	Vector2Array position;
+	Vector2Array normal;
+	IntArray collider_id;
+	IntArray shape;
+	position.resize(count);
+	normal.resize(count);
+	collider_id.resize(count);
+	shape.resize(count);
+
+	if (count) {
+		Vector2Array::Write wp = position.write();
+		Vector2Array::Write wn = normal.write();
+		IntArray::Write wc = collider_id.write();
+		IntArray::Write ws = shape.write();
+
+		for (int i = 0; i < count; i++) {
+			const RayResult &rr = results[i];
+			wp[i] = rr.position;
+			wn[i] = rr.normal;
+			wc[i] = rr.collider_id;
+			ws[i] = rr.shape;
+		}
+	}
+
+	Dictionary d(true);
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
+Dictionary Physics2DDirectSpaceState::_cast_motion_batch(const Ref<Physics2DShapeQueryParameters> &psq, const Vector2Array &p_origins, const Vector2Array &p_motions) {
+
+	ERR_FAIL_COND_V(psq.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<Matrix32> xforms;
+	xforms.resize(count);
+	RealArray safe;
+	RealArray unsafe;
+	safe.resize(count);
+	unsafe.resize(count);
+
+	if (count) {
+		Vector2Array::Read origins = p_origins.read();
+		Vector2Array::Read motions = p_motions.read();
+		for (int i = 0; i < count; i++) {
+			xforms[i] = psq->transform;
+			xforms[i].elements[2] = origins[i];
+		}
+
+		RealArray::Write ws = safe.write();
+		RealArray::Write wu = unsafe.write();
+		cast_motion_batch(psq->shape, xforms.ptr(), motions.ptr(), count, psq->margin, ws.ptr(), wu.ptr(), psq->exclude, psq->layer_mask, psq->object_type_mask);
+	}
+
+	Dictionary d(true);
+	d["safe"] = safe;
+	d["unsafe"] = unsafe;
+
+	return d;
+}
+
+int Physics2DDirectSpaceState::intersect_rays_batch(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	//one query at a time, servers can do better
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_layer_mask, p_object_type_mask)) {
+			hits++;
+			continue;
+		}
+
+		r_results[i].position = Vector2();
+		r_results[i].normal = Vector2();
+		r_results[i].rid = RID();
+		r_results[i].collider_id = 0;
+		r_results[i].collider = NULL;
+		r_results[i].shape = -1;
+		r_results[i].metadata = Variant();
+	}
+
+	return hits;
+}
+
+int Physics2DDirectSpaceState::cast_motion_batch(const RID &p_shape, const Matrix32 *p_xforms, const Vector2 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		float safe = 1, unsafe = 1;
+		if (!cast_motion(p_shape, p_xforms[i], p_motions[i], p_margin, safe, unsafe, p_exclude, p_layer_mask, p_object_type_mask)) {
+			safe = 0;
+			unsafe = 0;
+		}
+
+		r_closest_safe[i] = safe;
+		r_closest_unsafe[i] = unsafe;
+		if (safe < 1)
+			hits++;
+	}
+
+	return hits;
+}
+
 Physics2DDirectSpaceState::Physics2DDirectSpaceState() {
 }
 
@@ -351,6 +481,8 @@ void Physics2DDirectSpaceState::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("cast_motion", "shape:Physics2DShapeQueryParameters"), &Physics2DDirectSpaceState::_cast_motion);
 	ObjectTypeDB::bind_method(_MD("collide_shape", "shape:Physics2DShapeQueryParameters", "max_results"), &Physics2DDirectSpaceState::_collide_shape, DEFVAL(32));
 	ObjectTypeDB::bind_method(_MD("get_rest_info", "shape:Physics2DShapeQueryParameters"), &Physics2DDirectSpaceState::_get_rest_info);
+	ObjectTypeDB::bind_method(_MD("intersect_rays_batch:Dictionary", "from", "to", "exclude", "layer_mask", "type_mask"), &Physics2DDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(TYPE_MASK_COLLISION));
+	ObjectTypeDB::bind_method(_MD("cast_motion_batch:Dictionary", "shape:Physics2DShapeQueryParameters", "origins", "motions"), &Physics2DDirectSpaceState::_cast_motion_batch);
 	//ObjectTypeDB::bind_method(_MD("cast_motion","shape","xform","motion","exclude","umask"),&Physics2DDirectSpaceState::_intersect_shape,DEFVAL(Array()),DEFVAL(0));
 
 	BIND_CONSTANT(TYPE_MASK_STATIC_BODY);
@@ -690,6 +822,9 @@ void Physics2DServer::_bind_methods() {
 	BIND_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_CONSTANT(INFO_BROAD_PHASE_TIME);
+	BIND_CONSTANT(INFO_NARROW_PHASE_TIME);
+	BIND_CONSTANT(INFO_SOLVE_TIME);
 }
 
 Physics2DServer::Physics2DServer() {
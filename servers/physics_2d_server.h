@@ -139,6 +139,8 @@ class Physics2DDirectSpaceState : public Object {
 	Array _cast_motion(const Ref<Physics2DShapeQueryParameters> &p_shape_query);
 	Array _collide_shape(const Ref<Physics2DShapeQueryParameters> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<Physics2DShapeQueryParameters> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Vector2Array &p_from, const Vector2Array &p_to, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_layers = 0, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+	Dictionary _cast_motion_batch(const Ref<Physics2DShapeQueryParameters> &p_shape_query, const Vector2Array &p_origins, const Vector2Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -197,6 +199,11 @@ public:
 
 	virtual bool rest_info(RID p_shape, const Matrix32 &p_shape_xform, const Vector2 &p_motion, float p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION) = 0;
 
+	//batched versions, r_results must hold p_count entries and rays that hit nothing get a shape of -1. return the amount of hits
+	virtual int intersect_rays_batch(const Vector2 *p_from, const Vector2 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+	//casts that start overlapping something report 0 for both safe and unsafe
+	virtual int cast_motion_batch(const RID &p_shape, const Matrix32 *p_xforms, const Vector2 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+
 	Physics2DDirectSpaceState();
 };
 
@@ -551,7 +558,9 @@ public:
 		INFO_COLLISION_PAIRS,
 		INFO_ISLAND_COUNT,
 		INFO_STEP_TIME,
-		INFO_BROAD_PHASE_TIME
+		INFO_BROAD_PHASE_TIME,
+		INFO_NARROW_PHASE_TIME,
+		INFO_SOLVE_TIME
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -330,6 +330,135 @@ Dictionary PhysicsDirectSpaceState::_get_rest_info(const Ref<PhysicsShapeQueryPa
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState::_intersect_rays_batch(const Vector3Array &p_from, const Vector3Array &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, uint32_t p_object_type_mask) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Dictionary());
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+	Vector<RayResult> results;
+	results.resize(count);
+
+	if (count) {
+		Vector3Array::Read from = p_from.read();
+		Vector3Array::Read to = p_to.read();
+		intersect_rays_batch(from.ptr(), to.ptr(), count, results.ptr(), exclude, p_layers, p_object_type_mask);
+	}
+
+	Vector3Array position;
+	Vector3Array normal;
+	IntArray collider_id;
+	IntArray shape;
+	position.resize(count);
+	normal.resize(count);
+	collider_id.resize(count);
+	shape.resize(count);
+
+	if (count) {
+		Vector3Array::Write wp = position.write();
+		Vector3Array::Write wn = normal.write();
+		IntArray::Write wc = collider_id.write();
+		IntArray::Write ws = shape.write();
+
+		for (int i = 0; i < count; i++) {
+			const RayResult &rr = results[i];
+			wp[i] = rr.position;
+			wn[i] = rr.normal;
+			wc[i] = rr.collider_id;
+			ws[i] = rr.shape;
+		}
+	}
+
+	Dictionary d(true);
+	d["position"] = position;
+	d["normal"] = normal;
+	d["collider_id"] = collider_id;
+	d["shape"] = shape;
+
+	return d;
+}
+
+Dictionary PhysicsDirectSpaceState::_cast_motion_batch(const Ref<PhysicsShapeQueryParameters> &psq, const Vector3Array &p_origins, const Vector3Array &p_motions) {
+
+	ERR_FAIL_COND_V(psq.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_origins.size() != p_motions.size(), Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<Transform> xforms;
+	xforms.resize(count);
+	RealArray safe;
+	RealArray unsafe;
+	safe.resize(count);
+	unsafe.resize(count);
+
+	if (count) {
+		Vector3Array::Read origins = p_origins.read();
+		Vector3Array::Read motions = p_motions.read();
+		for (int i = 0; i < count; i++) {
+			xforms[i] = psq->transform;
+			xforms[i].origin = origins[i];
+		}
+
+		RealArray::Write ws = safe.write();
+		RealArray::Write wu = unsafe.write();
+		cast_motion_batch(psq->shape, xforms.ptr(), motions.ptr(), count, psq->margin, ws.ptr(), wu.ptr(), psq->exclude, psq->layer_mask, psq->object_type_mask);
+	}
+
+	Dictionary d(true);
+	d["safe"] = safe;
+	d["unsafe"] = unsafe;
+
+	return d;
+}
+
+int PhysicsDirectSpaceState::intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	//one query at a time, servers can do better
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_layer_mask, p_object_type_mask)) {
+			hits++;
+			continue;
+		}
+
+		r_results[i].position = Vector3();
+		r_results[i].normal = Vector3();
+		r_results[i].rid = RID();
+		r_results[i].collider_id = 0;
+		r_results[i].collider = NULL;
+		r_results[i].shape = -1;
+	}
+
+	return hits;
+}
+
+int PhysicsDirectSpaceState::cast_motion_batch(const RID &p_shape, const Transform *p_xforms, const Vector3 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_layer_mask, uint32_t p_object_type_mask) {
+
+	int hits = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		float safe = 1, unsafe = 1;
+		if (!cast_motion(p_shape, p_xforms[i], p_motions[i], p_margin, safe, unsafe, p_exclude, p_layer_mask, p_object_type_mask)) {
+			safe = 0;
+			unsafe = 0;
+		}
+
+		r_closest_safe[i] = safe;
+		r_closest_unsafe[i] = unsafe;
+		if (safe < 1)
+			hits++;
+	}
+
+	return hits;
+}
+
 PhysicsDirectSpaceState::PhysicsDirectSpaceState() {
 }
 
@@ -343,6 +472,8 @@ void PhysicsDirectSpaceState::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("cast_motion", "shape:PhysicsShapeQueryParameters", "motion"), &PhysicsDirectSpaceState::_cast_motion);
 	ObjectTypeDB::bind_method(_MD("collide_shape", "shape:PhysicsShapeQueryParameters", "max_results"), &PhysicsDirectSpaceState::_collide_shape, DEFVAL(32));
 	ObjectTypeDB::bind_method(_MD("get_rest_info", "shape:PhysicsShapeQueryParameters"), &PhysicsDirectSpaceState::_get_rest_info);
+	ObjectTypeDB::bind_method(_MD("intersect_rays_batch:Dictionary", "from", "to", "exclude", "layer_mask", "type_mask"), &PhysicsDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(TYPE_MASK_COLLISION));
+	ObjectTypeDB::bind_method(_MD("cast_motion_batch:Dictionary", "shape:PhysicsShapeQueryParameters", "origins", "motions"), &PhysicsDirectSpaceState::_cast_motion_batch);
 
 	BIND_CONSTANT(TYPE_MASK_STATIC_BODY);
 	BIND_CONSTANT(TYPE_MASK_KINEMATIC_BODY);
@@ -468,6 +599,9 @@ void PhysicsServer::_bind_methods() {
 	ObjectTypeDB::bind_method(_MD("body_set_enable_continuous_collision_detection", "body", "enable"), &PhysicsServer::body_set_enable_continuous_collision_detection);
 	ObjectTypeDB::bind_method(_MD("body_is_continuous_collision_detection_enabled", "body"), &PhysicsServer::body_is_continuous_collision_detection_enabled);
 
+	ObjectTypeDB::bind_method(_MD("body_set_continuous_collision_detection_mode", "body", "mode"), &PhysicsServer::body_set_continuous_collision_detection_mode);
+	ObjectTypeDB::bind_method(_MD("body_get_continuous_collision_detection_mode", "body"), &PhysicsServer::body_get_continuous_collision_detection_mode);
+
 	//ObjectTypeDB::bind_method(_MD("body_set_user_flags","flags""),&PhysicsServer::body_set_shape,DEFVAL(Transform));
 	//ObjectTypeDB::bind_method(_MD("body_get_user_flags","body","shape_idx","shape"),&PhysicsServer::body_get_shape);
 
@@ -679,6 +813,10 @@ void PhysicsServer::_bind_methods() {
 	BIND_CONSTANT(BODY_STATE_ANGULAR_VELOCITY);
 	BIND_CONSTANT(BODY_STATE_SLEEPING);
 	BIND_CONSTANT(BODY_STATE_CAN_SLEEP);
+
+	BIND_CONSTANT(CCD_MODE_DISABLED);
+	BIND_CONSTANT(CCD_MODE_CAST_RAY);
+	BIND_CONSTANT(CCD_MODE_CAST_SHAPE);
 	/*
 	BIND_CONSTANT( JOINT_PIN );
 	BIND_CONSTANT( JOINT_GROOVE );
@@ -697,6 +835,9 @@ void PhysicsServer::_bind_methods() {
 	BIND_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_CONSTANT(INFO_BROAD_PHASE_TIME);
+	BIND_CONSTANT(INFO_NARROW_PHASE_TIME);
+	BIND_CONSTANT(INFO_SOLVE_TIME);
 }
 
 PhysicsServer::PhysicsServer() {
@@ -147,6 +147,8 @@ private:
 	Array _cast_motion(const Ref<PhysicsShapeQueryParameters> &p_shape_query, const Vector3 &p_motion);
 	Array _collide_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters> &p_shape_query);
+	Dictionary _intersect_rays_batch(const Vector3Array &p_from, const Vector3Array &p_to, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_layers = 0, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+	Dictionary _cast_motion_batch(const Ref<PhysicsShapeQueryParameters> &p_shape_query, const Vector3Array &p_origins, const Vector3Array &p_motions);
 
 protected:
 	static void _bind_methods();
@@ -190,6 +192,11 @@ public:
 
 	virtual bool rest_info(RID p_shape, const Transform &p_shape_xform, float p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION) = 0;
 
+	//batched versions, r_results must hold p_count entries and rays that hit nothing get a shape of -1. return the amount of hits
+	virtual int intersect_rays_batch(const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+	//casts that start overlapping something report 0 for both safe and unsafe
+	virtual int cast_motion_batch(const RID &p_shape, const Transform *p_xforms, const Vector3 *p_motions, int p_count, float p_margin, float *r_closest_safe, float *r_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_layer_mask = 0xFFFFFFFF, uint32_t p_object_type_mask = TYPE_MASK_COLLISION);
+
 	PhysicsDirectSpaceState();
 };
 
@@ -219,6 +226,7 @@ class PhysicsServer : public Object {
 	OBJ_TYPE(PhysicsServer, Object);
 
 	static PhysicsServer *singleton;
+	friend class PhysicsServerWrapMT;
 
 protected:
 	static void _bind_methods();
@@ -378,6 +386,15 @@ public:
 	virtual void body_set_enable_continuous_collision_detection(RID p_body, bool p_enable) = 0;
 	virtual bool body_is_continuous_collision_detection_enabled(RID p_body) const = 0;
 
+	enum CCDMode {
+		CCD_MODE_DISABLED,
+		CCD_MODE_CAST_RAY,
+		CCD_MODE_CAST_SHAPE,
+	};
+
+	virtual void body_set_continuous_collision_detection_mode(RID p_body, CCDMode p_mode) = 0;
+	virtual CCDMode body_get_continuous_collision_detection_mode(RID p_body) const = 0;
+
 	virtual void body_set_layer_mask(RID p_body, uint32_t p_mask) = 0;
 	virtual uint32_t body_get_layer_mask(RID p_body, uint32_t p_mask) const = 0;
 
@@ -643,13 +660,17 @@ public:
 	virtual void step(float p_step) = 0;
 	virtual void sync() = 0;
 	virtual void flush_queries() = 0;
+	virtual void end_sync() = 0;
 	virtual void finish() = 0;
 
 	enum ProcessInfo {
 
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_BROAD_PHASE_TIME,
+		INFO_NARROW_PHASE_TIME,
+		INFO_SOLVE_TIME
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -666,6 +687,7 @@ VARIANT_ENUM_CAST(PhysicsServer::BodyMode);
 VARIANT_ENUM_CAST(PhysicsServer::BodyParameter);
 VARIANT_ENUM_CAST(PhysicsServer::BodyState);
 VARIANT_ENUM_CAST(PhysicsServer::BodyAxisLock);
+VARIANT_ENUM_CAST(PhysicsServer::CCDMode);
 VARIANT_ENUM_CAST(PhysicsServer::PinJointParam);
 VARIANT_ENUM_CAST(PhysicsServer::JointType);
 VARIANT_ENUM_CAST(PhysicsServer::HingeJointParam);
@@ -0,0 +1,372 @@
+/*************************************************************************/
+/*  canvas_batcher.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "canvas_batcher.h"
+
+bool CanvasBatcher::_is_item_batchable(Rasterizer::CanvasItem *p_item, int p_z, const Color &p_modulate, Rasterizer::CanvasLight *p_light, RID &r_texture, int &r_vertices, int &r_indices) const {
+
+	if (p_item->vp_render || p_item->copy_back_buffer || p_item->light_masked)
+		return false;
+
+	Rasterizer::CanvasItemMaterial *material = (p_item->material_owner ? p_item->material_owner : p_item)->material;
+
+	if (material && material->shader.is_valid())
+		return false; //custom shaders may rely on local vertex coordinates
+
+	bool unshaded = (material && material->shading_mode == VS::CANVAS_ITEM_SHADING_UNSHADED) || p_item->blend_mode != VS::MATERIAL_BLEND_MODE_MIX;
+
+	if (!unshaded) {
+
+		if (p_modulate.a <= 0.001 || (material && material->shading_mode == VS::CANVAS_ITEM_SHADING_ONLY_LIGHT))
+			return false; //not drawn in the base pass
+
+		for (Rasterizer::CanvasLight *light = p_light; light; light = light->next_ptr) {
+
+			if (p_item->light_mask & light->item_mask && p_z >= light->z_min && p_z <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache))
+				return false; //lit items are redrawn once per light
+		}
+	}
+
+	bool has_texture = false;
+	r_texture = RID();
+	r_vertices = 0;
+	r_indices = 0;
+
+	for (const Rasterizer::CanvasItem::Command *c = p_item->commands; c; c = c->next) {
+
+		RID texture;
+
+		switch (c->type) {
+
+			case Rasterizer::CanvasItem::Command::TYPE_RECT: {
+
+				const Rasterizer::CanvasItem::CommandRect *rect = static_cast<const Rasterizer::CanvasItem::CommandRect *>(c);
+				if (rect->flags & Rasterizer::CANVAS_RECT_TILE)
+					return false; //needs repeat wrapping on the texture
+
+				texture = rect->texture;
+				r_vertices += 4;
+				r_indices += 6;
+			} break;
+			case Rasterizer::CanvasItem::Command::TYPE_POLYGON: {
+
+				const Rasterizer::CanvasItem::CommandPolygon *polygon = static_cast<const Rasterizer::CanvasItem::CommandPolygon *>(c);
+				int point_count = polygon->points.size();
+
+				if (polygon->indices.size() ? polygon->count > polygon->indices.size() : polygon->count > point_count)
+					return false;
+				if (polygon->uvs.size() && polygon->uvs.size() != point_count)
+					return false;
+				if (polygon->colors.size() > 1 && polygon->colors.size() != point_count)
+					return false;
+
+				texture = polygon->texture;
+				r_vertices += point_count;
+				r_indices += polygon->count;
+			} break;
+			case Rasterizer::CanvasItem::Command::TYPE_TRANSFORM: {
+
+				continue;
+			} break;
+			default: {
+
+				return false;
+			}
+		}
+
+		if (!has_texture) {
+			r_texture = texture;
+			has_texture = true;
+		} else if (texture != r_texture) {
+			return false;
+		}
+	}
+
+	return r_vertices <= MAX_BATCH_VERTICES && r_indices <= MAX_BATCH_INDICES;
+}
+
+Size2 CanvasBatcher::_get_texture_size(const RID &p_texture) {
+
+	if (p_texture == size_cache_texture)
+		return size_cache;
+
+	size_cache_texture = p_texture;
+	size_cache = Size2();
+
+	if (p_texture.is_valid() && rasterizer->is_texture(p_texture)) {
+		size_cache = Size2(rasterizer->texture_get_width(p_texture), rasterizer->texture_get_height(p_texture));
+	}
+
+	return size_cache;
+}
+
+void CanvasBatcher::_reserve(int p_vertices, int p_indices) {
+
+	if (points.size() < vertex_count + p_vertices) {
+
+		int size = MAX(vertex_count + p_vertices, points.size() * 2);
+		points.resize(size);
+		uvs.resize(size);
+		colors.resize(size);
+	}
+
+	if (indices.size() < index_count + p_indices) {
+
+		indices.resize(MAX(index_count + p_indices, indices.size() * 2));
+	}
+}
+
+void CanvasBatcher::_add_item(Rasterizer::CanvasItem *p_item, int p_vertices, int p_indices, Batch &p_batch) {
+
+	_reserve(p_vertices, p_indices);
+
+	Vector2 *pw = points.ptr();
+	Vector2 *uvw = uvs.ptr();
+	Color *cw = colors.ptr();
+	int *iw = indices.ptr();
+
+	Matrix32 xform = p_item->final_transform;
+	float opacity = p_item->final_opacity;
+	Size2 tex_size = _get_texture_size(p_batch.texture);
+
+	for (const Rasterizer::CanvasItem::Command *c = p_item->commands; c; c = c->next) {
+
+		int base = vertex_count - p_batch.vertex_from;
+
+		switch (c->type) {
+
+			case Rasterizer::CanvasItem::Command::TYPE_RECT: {
+
+				const Rasterizer::CanvasItem::CommandRect *rect = static_cast<const Rasterizer::CanvasItem::CommandRect *>(c);
+
+				//same corner and texcoord layout as the rasterizer uses for a single rect
+				Vector2 texcoords[4];
+
+				if (tex_size.width > 0 && tex_size.height > 0) {
+
+					Rect2 src = (rect->flags & Rasterizer::CANVAS_RECT_REGION) ? rect->source : Rect2(Point2(), tex_size);
+
+					texcoords[0] = Vector2(src.pos.x / tex_size.width, src.pos.y / tex_size.height);
+					texcoords[1] = Vector2((src.pos.x + src.size.width) / tex_size.width, src.pos.y / tex_size.height);
+					texcoords[2] = Vector2((src.pos.x + src.size.width) / tex_size.width, (src.pos.y + src.size.height) / tex_size.height);
+					texcoords[3] = Vector2(src.pos.x / tex_size.width, (src.pos.y + src.size.height) / tex_size.height);
+
+					if (rect->flags & Rasterizer::CANVAS_RECT_TRANSPOSE) {
+						SWAP(texcoords[1], texcoords[3]);
+					}
+					if (rect->flags & Rasterizer::CANVAS_RECT_FLIP_H) {
+						SWAP(texcoords[0], texcoords[1]);
+						SWAP(texcoords[2], texcoords[3]);
+					}
+					if (rect->flags & Rasterizer::CANVAS_RECT_FLIP_V) {
+						SWAP(texcoords[1], texcoords[2]);
+						SWAP(texcoords[0], texcoords[3]);
+					}
+				}
+
+				const Rect2 &r = rect->rect;
+				Color m = rect->modulate;
+				m.a *= opacity;
+
+				pw[vertex_count + 0] = xform.xform(r.pos);
+				pw[vertex_count + 1] = xform.xform(Vector2(r.pos.x + r.size.width, r.pos.y));
+				pw[vertex_count + 2] = xform.xform(r.pos + r.size);
+				pw[vertex_count + 3] = xform.xform(Vector2(r.pos.x, r.pos.y + r.size.height));
+
+				for (int i = 0; i < 4; i++) {
+					uvw[vertex_count + i] = texcoords[i];
+					cw[vertex_count + i] = m;
+				}
+
+				iw[index_count + 0] = base;
+				iw[index_count + 1] = base + 1;
+				iw[index_count + 2] = base + 2;
+				iw[index_count + 3] = base;
+				iw[index_count + 4] = base + 2;
+				iw[index_count + 5] = base + 3;
+
+				vertex_count += 4;
+				index_count += 6;
+			} break;
+			case Rasterizer::CanvasItem::Command::TYPE_POLYGON: {
+
+				const Rasterizer::CanvasItem::CommandPolygon *polygon = static_cast<const Rasterizer::CanvasItem::CommandPolygon *>(c);
+				int point_count = polygon->points.size();
+				const Vector2 *src_points = polygon->points.ptr();
+
+				for (int i = 0; i < point_count; i++) {
+					pw[vertex_count + i] = xform.xform(src_points[i]);
+				}
+
+				if (polygon->uvs.size()) {
+					const Vector2 *src_uvs = polygon->uvs.ptr();
+					for (int i = 0; i < point_count; i++) {
+						uvw[vertex_count + i] = src_uvs[i];
+					}
+				} else {
+					for (int i = 0; i < point_count; i++) {
+						uvw[vertex_count + i] = Vector2();
+					}
+				}
+
+				if (polygon->colors.size() > 1) {
+					//per vertex colors don't take opacity, as in the rasterizer
+					const Color *src_colors = polygon->colors.ptr();
+					for (int i = 0; i < point_count; i++) {
+						cw[vertex_count + i] = src_colors[i];
+					}
+				} else {
+					Color m = polygon->colors.size() ? polygon->colors[0] : Color(1, 1, 1);
+					m.a *= opacity;
+					for (int i = 0; i < point_count; i++) {
+						cw[vertex_count + i] = m;
+					}
+				}
+
+				if (polygon->indices.size()) {
+					const int *src_indices = polygon->indices.ptr();
+					for (int i = 0; i < polygon->count; i++) {
+						iw[index_count + i] = base + src_indices[i];
+					}
+				} else {
+					for (int i = 0; i < polygon->count; i++) {
+						iw[index_count + i] = base + i;
+					}
+				}
+
+				vertex_count += point_count;
+				index_count += polygon->count;
+			} break;
+			case Rasterizer::CanvasItem::Command::TYPE_TRANSFORM: {
+
+				const Rasterizer::CanvasItem::CommandTransform *transform = static_cast<const Rasterizer::CanvasItem::CommandTransform *>(c);
+				xform = p_item->final_transform * transform->xform;
+			} break;
+			default: {
+			}
+		}
+	}
+
+	p_batch.vertex_count = vertex_count - p_batch.vertex_from;
+	p_batch.index_count = index_count - p_batch.index_from;
+	p_batch.item_count++;
+}
+
+CanvasBatcher::Batch &CanvasBatcher::_push_batch() {
+
+	if (batches.size() == batch_count) {
+		batches.resize(MAX(16, batch_count * 2));
+	}
+
+	Batch &batch = batches[batch_count++];
+	batch.item = NULL;
+	batch.item_count = 0;
+	batch.geometry = false;
+	batch.texture = RID();
+	batch.vertex_from = vertex_count;
+	batch.vertex_count = 0;
+	batch.index_from = index_count;
+	batch.index_count = 0;
+	return batch;
+}
+
+void CanvasBatcher::build(Rasterizer::CanvasItem *p_item_list, int p_z, const Color &p_modulate, Rasterizer::CanvasLight *p_light) {
+
+	ERR_FAIL_COND(!rasterizer);
+
+	batch_count = 0;
+	vertex_count = 0;
+	index_count = 0;
+	size_cache_texture = RID();
+
+	Rasterizer::CanvasItem *ci = p_item_list;
+
+	while (ci) {
+
+		RID texture;
+		int item_vertices;
+		int item_indices;
+
+		Batch &batch = _push_batch();
+		batch.item = ci;
+
+		if (!enabled || !_is_item_batchable(ci, p_z, p_modulate, p_light, texture, item_vertices, item_indices)) {
+
+			batch.item_count = 1;
+			ci = ci->next;
+			continue;
+		}
+
+		batch.geometry = true;
+		batch.texture = texture;
+		_add_item(ci, item_vertices, item_indices, batch);
+
+		Rasterizer::CanvasItemMaterial *material = (ci->material_owner ? ci->material_owner : ci)->material;
+		ci = ci->next;
+
+		//extend the run while the state the rasterizer sets per item stays the same
+		while (ci) {
+
+			if (ci->final_clip_owner != batch.item->final_clip_owner || ci->blend_mode != batch.item->blend_mode || ci->distance_field != batch.item->distance_field)
+				break;
+			if ((ci->material_owner ? ci->material_owner : ci)->material != material)
+				break;
+			if (!_is_item_batchable(ci, p_z, p_modulate, p_light, texture, item_vertices, item_indices) || texture != batch.texture)
+				break;
+			if (batch.vertex_count + item_vertices > MAX_BATCH_VERTICES || batch.index_count + item_indices > MAX_BATCH_INDICES)
+				break;
+
+			_add_item(ci, item_vertices, item_indices, batch);
+			ci = ci->next;
+		}
+	}
+}
+
+void CanvasBatcher::set_rasterizer(Rasterizer *p_rasterizer) {
+
+	rasterizer = p_rasterizer;
+}
+
+void CanvasBatcher::set_enabled(bool p_enabled) {
+
+	enabled = p_enabled;
+}
+
+bool CanvasBatcher::is_enabled() const {
+
+	return enabled;
+}
+
+CanvasBatcher::CanvasBatcher() {
+
+	rasterizer = NULL;
+	enabled = true;
+	batch_count = 0;
+	vertex_count = 0;
+	index_count = 0;
+}
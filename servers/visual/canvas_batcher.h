@@ -0,0 +1,102 @@
+/*************************************************************************/
+/*  canvas_batcher.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef CANVAS_BATCHER_H
+#define CANVAS_BATCHER_H
+
+#include "servers/visual/rasterizer.h"
+
+/* Groups runs of consecutive canvas items that share texture, material, blend mode and clip
+   into a single vertex batch, transformed to canvas space, so a backend can draw each run
+   with one call. Items that can't be batched are returned as single item runs and are drawn
+   as usual. */
+
+class CanvasBatcher {
+public:
+	enum {
+		MAX_BATCH_VERTICES = 16 * 1024,
+		MAX_BATCH_INDICES = 16 * 1024
+	};
+
+	struct Batch {
+
+		Rasterizer::CanvasItem *item; //first item in the run, clip, material and blend mode are taken from it
+		int item_count;
+		bool geometry; //false if the item must be drawn on its own
+		RID texture;
+		int vertex_from;
+		int vertex_count;
+		int index_from; //indices are relative to vertex_from
+		int index_count;
+	};
+
+private:
+	Rasterizer *rasterizer;
+	bool enabled;
+
+	//buffers only grow, counts are kept apart
+	Vector<Batch> batches;
+	int batch_count;
+
+	Vector<Vector2> points;
+	Vector<Vector2> uvs;
+	Vector<Color> colors;
+	int vertex_count;
+
+	Vector<int> indices;
+	int index_count;
+
+	RID size_cache_texture;
+	Size2 size_cache;
+
+	bool _is_item_batchable(Rasterizer::CanvasItem *p_item, int p_z, const Color &p_modulate, Rasterizer::CanvasLight *p_light, RID &r_texture, int &r_vertices, int &r_indices) const;
+	Size2 _get_texture_size(const RID &p_texture);
+	void _reserve(int p_vertices, int p_indices);
+	void _add_item(Rasterizer::CanvasItem *p_item, int p_vertices, int p_indices, Batch &p_batch);
+	Batch &_push_batch();
+
+public:
+	void set_rasterizer(Rasterizer *p_rasterizer);
+
+	void set_enabled(bool p_enabled);
+	bool is_enabled() const;
+
+	void build(Rasterizer::CanvasItem *p_item_list, int p_z, const Color &p_modulate, Rasterizer::CanvasLight *p_light);
+
+	_FORCE_INLINE_ int get_batch_count() const { return batch_count; }
+	_FORCE_INLINE_ const Batch &get_batch(int p_index) const { return batches[p_index]; }
+
+	_FORCE_INLINE_ const Vector2 *get_points() const { return points.ptr(); }
+	_FORCE_INLINE_ const Vector2 *get_uvs() const { return uvs.ptr(); }
+	_FORCE_INLINE_ const Color *get_colors() const { return colors.ptr(); }
+	_FORCE_INLINE_ const int *get_indices() const { return indices.ptr(); }
+
+	CanvasBatcher();
+};
+
+#endif // CANVAS_BATCHER_H
@@ -655,6 +655,7 @@ public:
 			};
 
 			Type type;
+			Command *next; //commands are chained in recording order
 			virtual ~Command() {}
 		};
 
@@ -781,7 +782,60 @@ public:
 		bool ontop;
 		VS::MaterialBlendMode blend_mode;
 		int light_mask;
-		Vector<Command *> commands;
+
+		enum {
+			COMMAND_BLOCK_MIN_SIZE = 256,
+			COMMAND_ALIGN = 16
+		};
+
+		//commands are placed in memory blocks owned by the item, clearing keeps the blocks so redraws don't allocate
+		struct CommandBlock {
+
+			uint8_t *memory;
+			uint32_t size;
+			uint32_t used;
+		};
+
+		Vector<CommandBlock> command_blocks;
+		int command_block;
+		Command *commands;
+		Command *last_command;
+
+		template <class T>
+		T *alloc_command() {
+
+			uint32_t size = (sizeof(T) + COMMAND_ALIGN - 1) & ~uint32_t(COMMAND_ALIGN - 1);
+
+			while (command_block < command_blocks.size() && command_blocks[command_block].used + size > command_blocks[command_block].size) {
+				command_block++;
+			}
+
+			if (command_block == command_blocks.size()) {
+
+				//start small, most items record a single command, and grow geometrically so large items need few blocks
+				CommandBlock block;
+				block.size = command_blocks.size() ? command_blocks[command_blocks.size() - 1].size * 2 : uint32_t(COMMAND_BLOCK_MIN_SIZE);
+				block.size = MAX(block.size, size);
+				block.used = 0;
+				block.memory = (uint8_t *)memalloc(block.size);
+				ERR_FAIL_COND_V(!block.memory, NULL);
+				command_blocks.push_back(block);
+			}
+
+			CommandBlock &block = command_blocks[command_block];
+			T *cmd = memnew_placement(&block.memory[block.used], T);
+			block.used += size;
+
+			cmd->next = NULL;
+			if (last_command)
+				last_command->next = cmd;
+			else
+				commands = cmd;
+			last_command = cmd;
+
+			return cmd;
+		}
+
 		mutable bool custom_rect;
 		mutable bool rect_dirty;
 		mutable Rect2 rect;
@@ -810,8 +864,7 @@ public:
 				return rect;
 
 			//must update rect
-			int s = commands.size();
-			if (s == 0) {
+			if (!commands) {
 
 				rect = Rect2();
 				rect_dirty = false;
@@ -822,11 +875,8 @@ public:
 			bool found_xform = false;
 			bool first = true;
 
-			const CanvasItem::Command *const *cmd = &commands[0];
+			for (const CanvasItem::Command *c = commands; c; c = c->next) {
 
-			for (int i = 0; i < s; i++) {
-
-				const CanvasItem::Command *c = cmd[i];
 				Rect2 r;
 
 				switch (c->type) {
@@ -925,9 +975,38 @@ public:
 		}
 
 		void clear() {
-			for (int i = 0; i < commands.size(); i++)
-				memdelete(commands[i]);
-			commands.clear();
+
+			Command *c = commands;
+			while (c) {
+				Command *n = c->next;
+				c->~Command();
+				c = n;
+			}
+			commands = NULL;
+			last_command = NULL;
+			command_block = 0;
+
+			//size the next recording from this one, in a single block so it's contiguous
+			uint32_t used = 0;
+			for (int i = 0; i < command_blocks.size(); i++) {
+				used += command_blocks[i].used;
+			}
+			used = MAX(used, uint32_t(COMMAND_BLOCK_MIN_SIZE));
+
+			if (command_blocks.size() > 1 || (command_blocks.size() && command_blocks[0].size > used * 2)) {
+				//overflowed or shrank a lot
+				for (int i = 0; i < command_blocks.size(); i++) {
+					memfree(command_blocks[i].memory);
+				}
+				command_blocks.resize(1);
+				command_blocks[0].size = used;
+				command_blocks[0].memory = (uint8_t *)memalloc(used);
+			}
+
+			if (command_blocks.size()) {
+				command_blocks[0].used = 0;
+			}
+
 			clip = false;
 			rect_dirty = true;
 			final_clip_owner = NULL;
@@ -935,6 +1014,9 @@ public:
 			light_masked = false;
 		}
 		CanvasItem() {
+			commands = NULL;
+			last_command = NULL;
+			command_block = 0;
 			light_mask = 1;
 			vp_render = NULL;
 			next = NULL;
@@ -954,6 +1036,8 @@ public:
 		}
 		virtual ~CanvasItem() {
 			clear();
+			for (int i = 0; i < command_blocks.size(); i++)
+				memfree(command_blocks[i].memory);
 			if (copy_back_buffer) memdelete(copy_back_buffer);
 		}
 	};
@@ -0,0 +1,151 @@
+/*************************************************************************/
+/*  rasterizer_recording.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#include "rasterizer_recording.h"
+
+void RasterizerRecording::canvas_render_items(CanvasItem *p_item_list, int p_z, const Color &p_modulate, CanvasLight *p_light) {
+
+	canvas_batcher.build(p_item_list, p_z, p_modulate, p_light);
+
+	for (int i = 0; i < canvas_batcher.get_batch_count(); i++) {
+
+		const CanvasBatcher::Batch &batch = canvas_batcher.get_batch(i);
+
+		if (batch.geometry) {
+
+			batch_count++;
+			if (!batch.index_count)
+				continue;
+
+			DrawCall dc;
+			dc.item = batch.item;
+			dc.item_count = batch.item_count;
+			dc.batched = true;
+			dc.texture = batch.texture;
+			dc.vertex_count = batch.vertex_count;
+			dc.index_count = batch.index_count;
+			dc.z = p_z;
+			draw_calls.push_back(dc);
+			continue;
+		}
+
+		//unbatched items issue one draw per command, as the rasterizers do
+		for (const CanvasItem::Command *c = batch.item->commands; c; c = c->next) {
+
+			DrawCall dc;
+			dc.item = batch.item;
+			dc.item_count = 1;
+			dc.batched = false;
+			dc.vertex_count = 0;
+			dc.index_count = 0;
+			dc.z = p_z;
+
+			switch (c->type) {
+
+				case CanvasItem::Command::TYPE_RECT: {
+
+					dc.texture = static_cast<const CanvasItem::CommandRect *>(c)->texture;
+					dc.vertex_count = 4;
+				} break;
+				case CanvasItem::Command::TYPE_STYLE: {
+
+					dc.texture = static_cast<const CanvasItem::CommandStyle *>(c)->texture;
+				} break;
+				case CanvasItem::Command::TYPE_PRIMITIVE: {
+
+					const CanvasItem::CommandPrimitive *primitive = static_cast<const CanvasItem::CommandPrimitive *>(c);
+					dc.texture = primitive->texture;
+					dc.vertex_count = primitive->points.size();
+				} break;
+				case CanvasItem::Command::TYPE_POLYGON: {
+
+					const CanvasItem::CommandPolygon *polygon = static_cast<const CanvasItem::CommandPolygon *>(c);
+					dc.texture = polygon->texture;
+					dc.vertex_count = polygon->points.size();
+					dc.index_count = polygon->count;
+				} break;
+				case CanvasItem::Command::TYPE_POLYGON_PTR: {
+
+					const CanvasItem::CommandPolygonPtr *polygon = static_cast<const CanvasItem::CommandPolygonPtr *>(c);
+					dc.texture = polygon->texture;
+					dc.index_count = polygon->count;
+				} break;
+				case CanvasItem::Command::TYPE_LINE: {
+
+					dc.vertex_count = 2;
+				} break;
+				case CanvasItem::Command::TYPE_CIRCLE: {
+
+				} break;
+				default: {
+
+					continue; //state changes, nothing drawn
+				}
+			}
+
+			draw_calls.push_back(dc);
+		}
+	}
+}
+
+void RasterizerRecording::set_canvas_batching(bool p_enabled) {
+
+	canvas_batcher.set_enabled(p_enabled);
+}
+
+bool RasterizerRecording::is_canvas_batching_enabled() const {
+
+	return canvas_batcher.is_enabled();
+}
+
+void RasterizerRecording::clear_draw_calls() {
+
+	draw_calls.clear();
+	batch_count = 0;
+}
+
+int RasterizerRecording::get_draw_call_count() const {
+
+	return draw_calls.size();
+}
+
+const RasterizerRecording::DrawCall &RasterizerRecording::get_draw_call(int p_index) const {
+
+	return draw_calls[p_index];
+}
+
+int RasterizerRecording::get_batch_count() const {
+
+	return batch_count;
+}
+
+RasterizerRecording::RasterizerRecording() {
+
+	canvas_batcher.set_rasterizer(this);
+	batch_count = 0;
+}
@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  rasterizer_recording.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                    http://www.godotengine.org                         */
+/*************************************************************************/
+/* Copyright (c) 2007-2017 Juan Linietsky, Ariel Manzur.                 */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+#ifndef RASTERIZER_RECORDING_H
+#define RASTERIZER_RECORDING_H
+
+#include "servers/visual/canvas_batcher.h"
+#include "servers/visual/rasterizer_dummy.h"
+
+/* Dummy rasterizer that records the canvas draw calls a backend would issue after batching,
+   so batching can be checked without a GPU. */
+
+class RasterizerRecording : public RasterizerDummy {
+public:
+	struct DrawCall {
+
+		CanvasItem *item; //first item drawn
+		int item_count;
+		bool batched;
+		RID texture;
+		int vertex_count;
+		int index_count;
+		int z;
+	};
+
+private:
+	CanvasBatcher canvas_batcher;
+	Vector<DrawCall> draw_calls;
+	int batch_count;
+
+public:
+	virtual void canvas_render_items(CanvasItem *p_item_list, int p_z, const Color &p_modulate, CanvasLight *p_light);
+
+	void set_canvas_batching(bool p_enabled);
+	bool is_canvas_batching_enabled() const;
+
+	void clear_draw_calls();
+	int get_draw_call_count() const;
+	const DrawCall &get_draw_call(int p_index) const;
+	int get_batch_count() const; //batches with merged geometry
+
+	RasterizerRecording();
+};
+
+#endif // RASTERIZER_RECORDING_H
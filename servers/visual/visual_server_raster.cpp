@@ -31,6 +31,7 @@
 #include "globals.h"
 #include "io/marshalls.h"
 #include "os/os.h"
+#include "os/trace.h"
 #include "sort.h"
 // careful, these may run in different threads than the visual server
 
@@ -2788,10 +2789,38 @@ int VisualServerRaster::instance_geometry_get_baked_light_texture_index(RID p_in
 	return instance->data.baked_lightmap_id;
 }
 
-void VisualServerRaster::_update_instance(Instance *p_instance) {
+void VisualServerRaster::_update_instance_transform(Instance *p_instance) {
 
+	//only the instance is written, so this can run for many instances at once
 	p_instance->version++;
 
+	if (p_instance->aabb.has_no_surface())
+		return;
+
+	if (p_instance->base_type == INSTANCE_ROOM) {
+
+		p_instance->room_info->affine_inverse = p_instance->data.transform.affine_inverse();
+	} else if (p_instance->base_type == INSTANCE_BAKED_LIGHT) {
+
+		Transform scale;
+		scale.basis.scale(p_instance->baked_light_info->baked_light->octree_aabb.size);
+		scale.origin = p_instance->baked_light_info->baked_light->octree_aabb.pos;
+		//print_line("scale: "+scale);
+		p_instance->baked_light_info->affine_inverse = (p_instance->data.transform * scale).affine_inverse();
+	}
+
+	p_instance->data.mirror = p_instance->data.transform.basis.determinant() < 0.0;
+
+	if (p_instance->base_type != INSTANCE_PORTAL) {
+		//portals are transformed along with their shape in _update_instance
+		p_instance->transformed_aabb = p_instance->data.transform.xform(p_instance->aabb);
+	}
+}
+
+void VisualServerRaster::_update_instance(Instance *p_instance) {
+
+	//expects _update_instance_transform to have been called first
+
 	if (p_instance->base_type == INSTANCE_LIGHT) {
 
 		rasterizer->light_instance_set_transform(p_instance->light_info->instance, p_instance->data.transform);
@@ -2814,23 +2843,8 @@ void VisualServerRaster::_update_instance(Instance *p_instance) {
 			E->get()->version++;
 			E = E->next();
 		}
-
-	} else if (p_instance->base_type == INSTANCE_ROOM) {
-
-		p_instance->room_info->affine_inverse = p_instance->data.transform.affine_inverse();
-	} else if (p_instance->base_type == INSTANCE_BAKED_LIGHT) {
-
-		Transform scale;
-		scale.basis.scale(p_instance->baked_light_info->baked_light->octree_aabb.size);
-		scale.origin = p_instance->baked_light_info->baked_light->octree_aabb.pos;
-		//print_line("scale: "+scale);
-		p_instance->baked_light_info->affine_inverse = (p_instance->data.transform * scale).affine_inverse();
 	}
 
-	p_instance->data.mirror = p_instance->data.transform.basis.determinant() < 0.0;
-
-	AABB new_aabb;
-
 	if (p_instance->base_type == INSTANCE_PORTAL) {
 
 		//portals need to be transformed in a special way, so they don't become too wide if they have scale..
@@ -2856,11 +2870,7 @@ void VisualServerRaster::_update_instance(Instance *p_instance) {
 
 		portal_aabb.grow_by(p_instance->portal_info->portal->connect_range);
 
-		new_aabb = portal_aabb;
-
-	} else {
-
-		new_aabb = p_instance->data.transform.xform(p_instance->aabb);
+		p_instance->transformed_aabb = portal_aabb;
 	}
 
 	for (InstanceSet::Element *E = p_instance->lights.front(); E; E = E->next()) {
@@ -2868,13 +2878,13 @@ void VisualServerRaster::_update_instance(Instance *p_instance) {
 		light->version++;
 	}
 
-	p_instance->transformed_aabb = new_aabb;
-
 	if (!p_instance->scenario) {
 
 		return;
 	}
 
+	const AABB &new_aabb = p_instance->transformed_aabb;
+
 	if (p_instance->octree_id == 0) {
 
 		uint32_t base_type = 1 << p_instance->base_type;
@@ -3025,29 +3035,67 @@ void VisualServerRaster::_update_instance_aabb(Instance *p_instance) {
 	p_instance->aabb = new_aabb;
 }
 
-void VisualServerRaster::_update_instances() {
+void VisualServerRaster::_instance_update_job(uint32_t p_chunk, InstanceUpdateData *p_data) {
 
-	while (instance_update_list) {
+	int from = p_chunk * INSTANCE_UPDATE_CHUNK_SIZE;
+	int to = MIN(from + INSTANCE_UPDATE_CHUNK_SIZE, p_data->instance_count);
 
-		Instance *instance = instance_update_list;
+	for (int i = from; i < to; i++) {
 
-		instance_update_list = instance_update_list->update_next;
+		Instance *instance = p_data->instances[i];
 
 		if (instance->update_aabb)
 			_update_instance_aabb(instance);
 
-		if (instance->update_materials) {
-			if (instance->base_type == INSTANCE_MESH) {
-				instance->data.materials.resize(rasterizer->mesh_get_surface_count(instance->base_rid));
+		_update_instance_transform(instance);
+	}
+}
+
+void VisualServerRaster::_update_instances() {
+
+	//bounds and transforms are computed in chunks (in parallel if there are render threads), then rasterizer,
+	//light and octree changes are applied serially in queue order
+	while (instance_update_list) {
+
+		int update_count = 0;
+		for (Instance *instance = instance_update_list; instance; instance = instance->update_next)
+			update_count++;
+
+		if (instance_update_buffer.size() < update_count)
+			instance_update_buffer.resize(update_count);
+
+		Instance **instances = instance_update_buffer.ptr();
+
+		for (int i = 0; i < update_count; i++) {
+
+			Instance *instance = instance_update_list;
+			instance_update_list = instance_update_list->update_next;
+			instances[i] = instance;
+
+			if (instance->update_materials) {
+				if (instance->base_type == INSTANCE_MESH) {
+					instance->data.materials.resize(rasterizer->mesh_get_surface_count(instance->base_rid));
+				}
 			}
 		}
 
-		_update_instance(instance);
+		InstanceUpdateData update_data;
+		update_data.instances = instances;
+		update_data.instance_count = update_count;
+
+		work_pool.do_work((update_count + INSTANCE_UPDATE_CHUNK_SIZE - 1) / INSTANCE_UPDATE_CHUNK_SIZE, this, &VisualServerRaster::_instance_update_job, &update_data);
+
+		for (int i = 0; i < update_count; i++) {
 
-		instance->update = false;
-		instance->update_aabb = false;
-		instance->update_materials = false;
-		instance->update_next = 0;
+			Instance *instance = instances[i];
+
+			_update_instance(instance);
+
+			instance->update = false;
+			instance->update_aabb = false;
+			instance->update_materials = false;
+			instance->update_next = 0;
+		}
 	}
 }
 
@@ -3142,11 +3190,16 @@ void VisualServerRaster::canvas_item_set_parent(RID p_item, RID p_parent) {
 
 			CanvasItem *item_owner = canvas_item_owner.get(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_canvas_item_invalidate(item_owner);
 		}
 
 		canvas_item->parent = RID();
+		canvas_item->parent_item = NULL;
 	}
 
+	//cached state is relative to the old parent
+	canvas_item->subtree_dirty = true;
+
 	if (p_parent.is_valid()) {
 		if (canvas_owner.owns(p_parent)) {
 
@@ -3158,6 +3211,8 @@ void VisualServerRaster::canvas_item_set_parent(RID p_item, RID p_parent) {
 
 			CanvasItem *item_owner = canvas_item_owner.get(p_parent);
 			item_owner->child_items.push_back(canvas_item);
+			_canvas_item_invalidate(item_owner);
+			canvas_item->parent_item = item_owner;
 
 		} else {
 
@@ -3183,6 +3238,7 @@ void VisualServerRaster::canvas_item_set_visible(RID p_item, bool p_visible) {
 
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	canvas_item->visible = p_visible;
 }
@@ -3227,6 +3283,7 @@ void VisualServerRaster::canvas_item_attach_viewport(RID p_canvas_item, RID p_vi
 
 	CanvasItem *canvas_item = canvas_item_owner.get(p_canvas_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	VS_CHANGED;
 
@@ -3246,6 +3303,7 @@ void VisualServerRaster::canvas_item_set_clip(RID p_item, bool p_clip) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	canvas_item->clip = p_clip;
 }
@@ -3263,6 +3321,7 @@ void VisualServerRaster::canvas_item_set_transform(RID p_item, const Matrix32 &p
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	canvas_item->xform = p_transform;
 }
@@ -3271,6 +3330,7 @@ void VisualServerRaster::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	if (p_custom_rect)
@@ -3281,6 +3341,7 @@ void VisualServerRaster::canvas_item_set_opacity(RID p_item, float p_opacity) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->opacity = p_opacity;
 }
 float VisualServerRaster::canvas_item_get_opacity(RID p_item, float p_opacity) const {
@@ -3295,6 +3356,7 @@ void VisualServerRaster::canvas_item_set_on_top(RID p_item, bool p_on_top) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->ontop = p_on_top;
 }
 
@@ -3308,6 +3370,7 @@ void VisualServerRaster::canvas_item_set_self_opacity(RID p_item, float p_self_o
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->self_opacity = p_self_opacity;
 }
 float VisualServerRaster::canvas_item_get_self_opacity(RID p_item, float p_self_opacity) const {
@@ -3321,30 +3384,28 @@ void VisualServerRaster::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandLine *line = memnew(CanvasItem::CommandLine);
+	CanvasItem::CommandLine *line = canvas_item->alloc_command<CanvasItem::CommandLine>();
 	ERR_FAIL_COND(!line);
 	line->color = p_color;
 	line->from = p_from;
 	line->to = p_to;
 	line->width = p_width;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(line);
 }
 
 void VisualServerRaster::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandRect *rect = memnew(CanvasItem::CommandRect);
+	CanvasItem::CommandRect *rect = canvas_item->alloc_command<CanvasItem::CommandRect>();
 	ERR_FAIL_COND(!rect);
 	rect->modulate = p_color;
 	rect->rect = p_rect;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerRaster::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
@@ -3352,22 +3413,22 @@ void VisualServerRaster::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandCircle *circle = memnew(CanvasItem::CommandCircle);
+	CanvasItem::CommandCircle *circle = canvas_item->alloc_command<CanvasItem::CommandCircle>();
 	ERR_FAIL_COND(!circle);
 	circle->color = p_color;
 	circle->pos = p_pos;
 	circle->radius = p_radius;
-
-	canvas_item->commands.push_back(circle);
 }
 
 void VisualServerRaster::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandRect *rect = memnew(CanvasItem::CommandRect);
+	CanvasItem::CommandRect *rect = canvas_item->alloc_command<CanvasItem::CommandRect>();
 	ERR_FAIL_COND(!rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -3394,15 +3455,15 @@ void VisualServerRaster::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	}
 	rect->texture = p_texture;
 	canvas_item->rect_dirty = true;
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerRaster::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandRect *rect = memnew(CanvasItem::CommandRect);
+	CanvasItem::CommandRect *rect = canvas_item->alloc_command<CanvasItem::CommandRect>();
 	ERR_FAIL_COND(!rect);
 	rect->modulate = p_modulate;
 	rect->rect = p_rect;
@@ -3426,8 +3487,6 @@ void VisualServerRaster::canvas_item_add_texture_rect_region(RID p_item, const R
 	}
 
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(rect);
 }
 
 void VisualServerRaster::canvas_item_add_style_box(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, bool p_draw_center, const Color &p_modulate) {
@@ -3435,8 +3494,9 @@ void VisualServerRaster::canvas_item_add_style_box(RID p_item, const Rect2 &p_re
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandStyle *style = memnew(CanvasItem::CommandStyle);
+	CanvasItem::CommandStyle *style = canvas_item->alloc_command<CanvasItem::CommandStyle>();
 	ERR_FAIL_COND(!style);
 	style->texture = p_texture;
 	style->rect = p_rect;
@@ -3448,15 +3508,14 @@ void VisualServerRaster::canvas_item_add_style_box(RID p_item, const Rect2 &p_re
 	style->margin[MARGIN_RIGHT] = p_bottomright.x;
 	style->margin[MARGIN_BOTTOM] = p_bottomright.y;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(style);
 }
 void VisualServerRaster::canvas_item_add_primitive(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, float p_width) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandPrimitive *prim = memnew(CanvasItem::CommandPrimitive);
+	CanvasItem::CommandPrimitive *prim = canvas_item->alloc_command<CanvasItem::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
 	prim->texture = p_texture;
 	prim->points = p_points;
@@ -3464,8 +3523,6 @@ void VisualServerRaster::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	prim->colors = p_colors;
 	prim->width = p_width;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(prim);
 }
 
 void VisualServerRaster::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
@@ -3473,6 +3530,7 @@ void VisualServerRaster::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -3489,7 +3547,7 @@ void VisualServerRaster::canvas_item_add_polygon(RID p_item, const Vector<Point2
 		ERR_FAIL_V();
 	}
 
-	CanvasItem::CommandPolygon *polygon = memnew(CanvasItem::CommandPolygon);
+	CanvasItem::CommandPolygon *polygon = canvas_item->alloc_command<CanvasItem::CommandPolygon>();
 	ERR_FAIL_COND(!polygon);
 	polygon->texture = p_texture;
 	polygon->points = p_points;
@@ -3498,8 +3556,6 @@ void VisualServerRaster::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	polygon->indices = indices;
 	polygon->count = indices.size();
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(polygon);
 }
 
 void VisualServerRaster::canvas_item_add_triangle_array_ptr(RID p_item, int p_count, const int *p_indices, const Point2 *p_points, const Color *p_colors, const Point2 *p_uvs, RID p_texture) {
@@ -3507,12 +3563,13 @@ void VisualServerRaster::canvas_item_add_triangle_array_ptr(RID p_item, int p_co
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	ERR_FAIL_COND(p_count <= 0);
 
 	ERR_FAIL_COND(p_points == NULL);
 
-	CanvasItem::CommandPolygonPtr *polygon = memnew(CanvasItem::CommandPolygonPtr);
+	CanvasItem::CommandPolygonPtr *polygon = canvas_item->alloc_command<CanvasItem::CommandPolygonPtr>();
 	ERR_FAIL_COND(!polygon);
 	polygon->texture = p_texture;
 	polygon->points = p_points;
@@ -3521,8 +3578,6 @@ void VisualServerRaster::canvas_item_add_triangle_array_ptr(RID p_item, int p_co
 	polygon->indices = p_indices;
 	polygon->count = p_count * 3;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(polygon);
 };
 
 void VisualServerRaster::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, int p_count) {
@@ -3530,6 +3585,7 @@ void VisualServerRaster::canvas_item_add_triangle_array(RID p_item, const Vector
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	int ps = p_points.size();
 	ERR_FAIL_COND(!p_colors.empty() && p_colors.size() != ps && p_colors.size() != 1);
@@ -3551,7 +3607,7 @@ void VisualServerRaster::canvas_item_add_triangle_array(RID p_item, const Vector
 			count = indices.size();
 	}
 
-	CanvasItem::CommandPolygon *polygon = memnew(CanvasItem::CommandPolygon);
+	CanvasItem::CommandPolygon *polygon = canvas_item->alloc_command<CanvasItem::CommandPolygon>();
 	ERR_FAIL_COND(!polygon);
 	polygon->texture = p_texture;
 	polygon->points = p_points;
@@ -3560,8 +3616,6 @@ void VisualServerRaster::canvas_item_add_triangle_array(RID p_item, const Vector
 	polygon->indices = indices;
 	polygon->count = count;
 	canvas_item->rect_dirty = true;
-
-	canvas_item->commands.push_back(polygon);
 }
 
 void VisualServerRaster::canvas_item_add_set_transform(RID p_item, const Matrix32 &p_transform) {
@@ -3569,12 +3623,11 @@ void VisualServerRaster::canvas_item_add_set_transform(RID p_item, const Matrix3
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandTransform *tr = memnew(CanvasItem::CommandTransform);
+	CanvasItem::CommandTransform *tr = canvas_item->alloc_command<CanvasItem::CommandTransform>();
 	ERR_FAIL_COND(!tr);
 	tr->xform = p_transform;
-
-	canvas_item->commands.push_back(tr);
 }
 
 void VisualServerRaster::canvas_item_add_set_blend_mode(RID p_item, MaterialBlendMode p_blend) {
@@ -3582,12 +3635,11 @@ void VisualServerRaster::canvas_item_add_set_blend_mode(RID p_item, MaterialBlen
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandBlendMode *bm = memnew(CanvasItem::CommandBlendMode);
+	CanvasItem::CommandBlendMode *bm = canvas_item->alloc_command<CanvasItem::CommandBlendMode>();
 	ERR_FAIL_COND(!bm);
 	bm->blend_mode = p_blend;
-
-	canvas_item->commands.push_back(bm);
 };
 
 void VisualServerRaster::canvas_item_set_z(RID p_item, int p_z) {
@@ -3596,6 +3648,7 @@ void VisualServerRaster::canvas_item_set_z(RID p_item, int p_z) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->z = p_z;
 }
 
@@ -3604,6 +3657,7 @@ void VisualServerRaster::canvas_item_set_z_as_relative_to_parent(RID p_item, boo
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->z_relative = p_enable;
 }
 
@@ -3612,6 +3666,7 @@ void VisualServerRaster::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	if (bool(canvas_item->copy_back_buffer != NULL) != p_enable) {
 		if (p_enable) {
 			canvas_item->copy_back_buffer = memnew(Rasterizer::CanvasItem::CopyBackBuffer);
@@ -3632,6 +3687,7 @@ void VisualServerRaster::canvas_item_set_use_parent_material(RID p_item, bool p_
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->use_parent_material = p_enable;
 }
 
@@ -3657,6 +3713,7 @@ void VisualServerRaster::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 	canvas_item->sort_y = p_enable;
 }
 
@@ -3665,22 +3722,32 @@ void VisualServerRaster::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
-	CanvasItem::CommandClipIgnore *ci = memnew(CanvasItem::CommandClipIgnore);
+	CanvasItem::CommandClipIgnore *ci = canvas_item->alloc_command<CanvasItem::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
 	ci->ignore = p_ignore;
-
-	canvas_item->commands.push_back(ci);
 }
 
 void VisualServerRaster::canvas_item_clear(RID p_item) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_canvas_item_invalidate(canvas_item);
 
 	canvas_item->clear();
 }
 
+void VisualServerRaster::_canvas_item_invalidate(CanvasItem *p_canvas_item) {
+
+	//stops at the first item already marked, its ancestors are either marked too or it was skipped as hidden
+	CanvasItem *ci = p_canvas_item;
+	while (ci && !ci->subtree_dirty) {
+		ci->subtree_dirty = true;
+		ci = ci->parent_item;
+	}
+}
+
 void VisualServerRaster::canvas_item_raise(RID p_item) {
 	VS_CHANGED;
 	CanvasItem *canvas_item = canvas_item_owner.get(p_item);
@@ -3704,6 +3771,7 @@ void VisualServerRaster::canvas_item_raise(RID p_item) {
 			ERR_FAIL_COND(idx < 0);
 			item_owner->child_items.remove(idx);
 			item_owner->child_items.push_back(canvas_item);
+			_canvas_item_invalidate(item_owner);
 		}
 	}
 }
@@ -4338,12 +4406,15 @@ void VisualServerRaster::free(RID p_rid) {
 
 				CanvasItem *item_owner = canvas_item_owner.get(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_canvas_item_invalidate(item_owner);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 
 			canvas_item->child_items[i]->parent = RID();
+			canvas_item->child_items[i]->parent_item = NULL;
+			canvas_item->child_items[i]->subtree_dirty = true;
 		}
 
 		if (canvas_item->material) {
@@ -4721,7 +4792,8 @@ void VisualServerRaster::_light_instance_update_pssm_shadow(Instance *p_light, S
 		light_frustum_planes[4] = Plane(z_vec, z_max + 1e6);
 		light_frustum_planes[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-		int caster_cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, INSTANCE_GEOMETRY_MASK);
+		int caster_cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_buffer, INSTANCE_GEOMETRY_MASK, &work_pool);
+		Instance **instance_shadow_cull_result = instance_shadow_cull_buffer.ptr();
 
 		// a pre pass will need to be needed to determine the actual z-near to be used
 		for (int j = 0; j < caster_cull_count; j++) {
@@ -4812,7 +4884,8 @@ void VisualServerRaster::_light_instance_update_lispsm_shadow(Instance *p_light,
 	float near_dist = 1;
 
 	Vector<Plane> light_frustum_planes = _camera_generate_orthogonal_planes(p_light, p_camera, p_cull_range.min, p_cull_range.max);
-	int caster_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, INSTANCE_GEOMETRY_MASK);
+	int caster_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_buffer, INSTANCE_GEOMETRY_MASK, &work_pool);
+	Instance **instance_shadow_cull_result = instance_shadow_cull_buffer.ptr();
 
 	// this could be faster by just getting supports from the AABBs..
 	// but, safer to do as the original implementation explains for now..
@@ -5050,7 +5123,8 @@ void VisualServerRaster::_light_instance_update_lispsm_shadow(Instance *p_light,
 
 	/* STEP 3: CULL CASTERS */
 
-	int caster_count = p_scenario->octree.cull_convex(light_cull_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, INSTANCE_GEOMETRY_MASK);
+	int caster_count = p_scenario->octree.cull_convex(light_cull_planes, instance_shadow_cull_buffer, INSTANCE_GEOMETRY_MASK, &work_pool);
+	Instance **instance_shadow_cull_result = instance_shadow_cull_buffer.ptr();
 
 	/* STEP 4: ADJUST FAR Z PLANE */
 
@@ -5180,7 +5254,8 @@ void VisualServerRaster::_light_instance_update_shadow(Instance *p_light, Scenar
 			cm.set_perspective(angle * 2.0, 1.0, 0.001, far);
 
 			Vector<Plane> planes = cm.get_projection_planes(p_light->data.transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, INSTANCE_GEOMETRY_MASK);
+			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_buffer, INSTANCE_GEOMETRY_MASK, &work_pool);
+			Instance **instance_shadow_cull_result = instance_shadow_cull_buffer.ptr();
 
 			for (int i = 0; i < cull_count; i++) {
 
@@ -5218,7 +5293,8 @@ void VisualServerRaster::_light_instance_update_shadow(Instance *p_light, Scenar
 					planes[3] = p_light->data.transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
 					planes[4] = p_light->data.transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, INSTANCE_GEOMETRY_MASK);
+					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_buffer, INSTANCE_GEOMETRY_MASK, &work_pool);
+					Instance **instance_shadow_cull_result = instance_shadow_cull_buffer.ptr();
 
 					for (int j = 0; j < cull_count; j++) {
 
@@ -5940,6 +6016,114 @@ void VisualServerRaster::_render_no_camera(Viewport *p_viewport, Camera *p_camer
 	rasterizer->end_scene();
 }
 
+void VisualServerRaster::_instance_cull_job(uint32_t p_chunk, InstanceCullData *p_data) {
+
+	//only the chunk is written here, shared state (light and sampler lists, sampler passes) is updated when merging
+	InstanceCullChunk &chunk = p_data->chunks[p_chunk];
+	const CullRange &cull_range = p_data->cull_range;
+
+	chunk.from = p_chunk * INSTANCE_CULL_CHUNK_SIZE;
+	chunk.count = 0;
+	chunk.min = cull_range.z_far;
+	chunk.max = cull_range.z_near;
+	chunk.light_count = 0;
+	chunk.light_sampler_count = 0;
+
+	Instance **instances = &p_data->instances[chunk.from];
+	int count = MIN(INSTANCE_CULL_CHUNK_SIZE, p_data->instance_count - chunk.from);
+
+	for (int i = 0; i < count; i++) {
+
+		Instance *ins = instances[i];
+
+		bool keep = false;
+
+		if ((p_data->camera_layer_mask & ins->layer_mask) == 0) {
+
+			//failure
+		} else if (ins->base_type == INSTANCE_LIGHT) {
+
+			{
+				//compute distance to camera using aabb support
+				Vector3 n = ins->data.transform.basis.xform_inv(cull_range.nearp.normal).normalized();
+				Vector3 s = ins->data.transform.xform(ins->aabb.get_support(n));
+				ins->light_info->dtc = cull_range.nearp.distance_to(s);
+			}
+
+			if (chunk.lights.size() == chunk.light_count)
+				chunk.lights.resize(MAX(8, chunk.light_count * 2));
+			chunk.lights[chunk.light_count++] = ins;
+
+		} else if ((1 << ins->base_type) & INSTANCE_GEOMETRY_MASK && ins->visible && ins->data.cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+
+			bool discarded = false;
+
+			if (ins->draw_range_end > 0) {
+
+				float d = cull_range.nearp.distance_to(ins->data.transform.origin);
+				if (d < 0)
+					d = 0;
+				discarded = (d < ins->draw_range_begin || d >= ins->draw_range_end);
+			}
+
+			if (!discarded) {
+
+				// test if this geometry should be visible
+
+				if (room_cull_enabled) {
+
+					if (ins->visible_in_all_rooms) {
+						keep = true;
+					} else if (ins->room) {
+
+						if (ins->room->room_info->last_visited_pass == render_pass)
+							keep = true;
+					} else if (ins->auto_rooms.size()) {
+
+						for (Set<Instance *>::Element *E = ins->auto_rooms.front(); E; E = E->next()) {
+
+							if (E->get()->room_info->last_visited_pass == render_pass) {
+								keep = true;
+								break;
+							}
+						}
+					} else if (exterior_visited)
+						keep = true;
+				} else {
+
+					keep = true;
+				}
+			}
+
+			if (keep) {
+				// update cull range
+				float min, max;
+				ins->transformed_aabb.project_range_in_plane(cull_range.nearp, min, max);
+
+				if (min < chunk.min)
+					chunk.min = min;
+				if (max > chunk.max)
+					chunk.max = max;
+
+				if (ins->sampled_light) {
+					if (chunk.light_samplers.size() == chunk.light_sampler_count)
+						chunk.light_samplers.resize(MAX(8, chunk.light_sampler_count * 2));
+					chunk.light_samplers[chunk.light_sampler_count++] = ins->sampled_light;
+				}
+			}
+		}
+
+		if (!keep) {
+			// remove, no reason to keep
+			ins->last_render_pass = 0; // make invalid
+		} else {
+
+			ins->last_render_pass = render_pass;
+			instances[chunk.count++] = ins;
+		}
+	}
+}
+
 void VisualServerRaster::_render_camera(Viewport *p_viewport, Camera *p_camera, Scenario *p_scenario) {
 
 	render_pass++;
@@ -5989,7 +6173,8 @@ void VisualServerRaster::_render_camera(Viewport *p_viewport, Camera *p_camera,
 	cull_range.max = cull_range.z_near;
 
 	/* STEP 2 - CULL */
-	int cull_count = p_scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	int cull_count = p_scenario->octree.cull_convex(planes, instance_cull_buffer, 0xFFFFFFFF, &work_pool);
+	Instance **instance_cull_result = instance_cull_buffer.ptr();
 	light_cull_count = 0;
 	light_samplers_culled = 0;
 
@@ -6080,98 +6265,51 @@ void VisualServerRaster::_render_camera(Viewport *p_viewport, Camera *p_camera,
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
-	for (int i = 0; i < cull_count; i++) {
-
-		Instance *ins = instance_cull_result[i];
+	{
+		//instances are tested in chunks (in parallel if there are render threads), then kept ones, lights and samplers are merged in order
+		int chunk_count = (cull_count + INSTANCE_CULL_CHUNK_SIZE - 1) / INSTANCE_CULL_CHUNK_SIZE;
+		if (instance_cull_chunks.size() < chunk_count)
+			instance_cull_chunks.resize(chunk_count);
 
-		bool keep = false;
+		InstanceCullData cull_data;
+		cull_data.instances = instance_cull_result;
+		cull_data.instance_count = cull_count;
+		cull_data.camera_layer_mask = camera_layer_mask;
+		cull_data.cull_range = cull_range;
+		cull_data.chunks = instance_cull_chunks.ptr();
 
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
+		work_pool.do_work(chunk_count, this, &VisualServerRaster::_instance_cull_job, &cull_data);
 
-			//failure
-		} else if (ins->base_type == INSTANCE_LIGHT) {
+		cull_count = 0;
 
-			if (light_cull_count < MAX_LIGHTS_CULLED) {
-				light_cull_result[light_cull_count++] = ins;
-				//				rasterizer->light_instance_set_active_hint(ins->light_info->instance);
-				{
-					//compute distance to camera using aabb support
-					Vector3 n = ins->data.transform.basis.xform_inv(cull_range.nearp.normal).normalized();
-					Vector3 s = ins->data.transform.xform(ins->aabb.get_support(n));
-					ins->light_info->dtc = cull_range.nearp.distance_to(s);
-				}
-			}
+		for (int i = 0; i < chunk_count; i++) {
 
-		} else if ((1 << ins->base_type) & INSTANCE_GEOMETRY_MASK && ins->visible && ins->data.cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+			const InstanceCullChunk &chunk = cull_data.chunks[i];
 
-			bool discarded = false;
-
-			if (ins->draw_range_end > 0) {
-
-				float d = cull_range.nearp.distance_to(ins->data.transform.origin);
-				if (d < 0)
-					d = 0;
-				discarded = (d < ins->draw_range_begin || d >= ins->draw_range_end);
+			if (chunk.count) {
+				if (chunk.from != cull_count)
+					movemem(&instance_cull_result[cull_count], &instance_cull_result[chunk.from], chunk.count * sizeof(Instance *));
+				cull_count += chunk.count;
 			}
 
-			if (!discarded) {
+			if (chunk.min < cull_range.min)
+				cull_range.min = chunk.min;
+			if (chunk.max > cull_range.max)
+				cull_range.max = chunk.max;
 
-				// test if this geometry should be visible
-
-				if (room_cull_enabled) {
-
-					if (ins->visible_in_all_rooms) {
-						keep = true;
-					} else if (ins->room) {
-
-						if (ins->room->room_info->last_visited_pass == render_pass)
-							keep = true;
-					} else if (ins->auto_rooms.size()) {
-
-						for (Set<Instance *>::Element *E = ins->auto_rooms.front(); E; E = E->next()) {
-
-							if (E->get()->room_info->last_visited_pass == render_pass) {
-								keep = true;
-								break;
-							}
-						}
-					} else if (exterior_visited)
-						keep = true;
-				} else {
-
-					keep = true;
-				}
+			for (int j = 0; j < chunk.light_count && light_cull_count < MAX_LIGHTS_CULLED; j++) {
+				light_cull_result[light_cull_count++] = chunk.lights[j];
 			}
 
-			if (keep) {
-				// update cull range
-				float min, max;
-				ins->transformed_aabb.project_range_in_plane(cull_range.nearp, min, max);
-
-				if (min < cull_range.min)
-					cull_range.min = min;
-				if (max > cull_range.max)
-					cull_range.max = max;
+			for (int j = 0; j < chunk.light_sampler_count; j++) {
 
-				if (ins->sampled_light && ins->sampled_light->baked_light_sampler_info->last_pass != render_pass) {
-					if (light_samplers_culled < MAX_LIGHT_SAMPLERS) {
-						light_sampler_cull_result[light_samplers_culled++] = ins->sampled_light;
-						ins->sampled_light->baked_light_sampler_info->last_pass = render_pass;
-					}
+				Instance *sampler = chunk.light_samplers[j];
+				if (sampler->baked_light_sampler_info->last_pass != render_pass && light_samplers_culled < MAX_LIGHT_SAMPLERS) {
+					light_sampler_cull_result[light_samplers_culled++] = sampler;
+					sampler->baked_light_sampler_info->last_pass = render_pass;
 				}
 			}
 		}
-
-		if (!keep) {
-			// remove, no reason to keep
-			cull_count--;
-			SWAP(instance_cull_result[i], instance_cull_result[cull_count]);
-			i--;
-			ins->last_render_pass = 0; // make invalid
-		} else {
-
-			ins->last_render_pass = render_pass;
-		}
 	}
 
 	if (cull_range.max > cull_range.z_far)
@@ -6350,12 +6488,36 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 
 	CanvasItem *ci = p_canvas_item;
 
+	if (!ci->subtree_dirty && ci->subtree_cacheable && ci->cache_opacity == p_opacity && ci->cache_z == p_z && ci->cache_canvas_clip == p_canvas_clip && ci->cache_material_owner == p_material_owner && ci->cache_transform == p_transform && ci->cache_clip_rect == p_clip_rect && (!p_canvas_clip || ci->cache_canvas_clip_rect == p_canvas_clip->final_clip_rect)) {
+		//nothing changed in this subtree since it was last drawn, relink it as it was
+		if (ci->subtree_drawn)
+			_render_canvas_item_cached(ci, z_list, z_last_list);
+		return;
+	}
+
+	ci->subtree_dirty = false;
+	ci->subtree_cacheable = true;
+	ci->subtree_drawn = false;
+	ci->drawn = false;
+	ci->cache_transform = p_transform;
+	ci->cache_clip_rect = p_clip_rect;
+	ci->cache_canvas_clip_rect = p_canvas_clip ? p_canvas_clip->final_clip_rect : Rect2();
+	ci->cache_opacity = p_opacity;
+	ci->cache_z = p_z;
+	ci->cache_canvas_clip = p_canvas_clip;
+	ci->cache_material_owner = p_material_owner;
+
 	if (!ci->visible)
 		return;
 
 	if (p_opacity < 0.007)
 		return;
 
+	if (ci->viewport.is_valid()) {
+		//the viewport render rect is taken from the global viewport rect, so it's set up every time
+		ci->subtree_cacheable = false;
+	}
+
 	Rect2 rect = ci->get_rect();
 	Matrix32 xform = p_transform * ci->xform;
 	Rect2 global_rect = xform.xform(rect);
@@ -6399,8 +6561,19 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 	float opacity = ci->opacity * p_opacity;
 
 	int child_item_count = ci->child_items.size();
-	CanvasItem **child_items = (CanvasItem **)alloca(child_item_count * sizeof(CanvasItem *));
-	copymem(child_items, ci->child_items.ptr(), child_item_count * sizeof(CanvasItem *));
+	CanvasItem **child_items;
+
+	if (ci->sort_y) {
+		//the sorted order is kept, so the subtree can be relinked without sorting again
+		ci->sorted_child_items.resize(child_item_count);
+		child_items = ci->sorted_child_items.ptr();
+		copymem(child_items, ci->child_items.ptr(), child_item_count * sizeof(CanvasItem *));
+
+		SortArray<CanvasItem *, CanvasItemPtrSort> sorter;
+		sorter.sort(child_items, child_item_count);
+	} else {
+		child_items = ci->child_items.ptr();
+	}
 
 	if (ci->clip) {
 		if (p_canvas_clip != NULL) {
@@ -6414,12 +6587,6 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 		ci->final_clip_owner = p_canvas_clip;
 	}
 
-	if (ci->sort_y) {
-
-		SortArray<CanvasItem *, CanvasItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
-	}
-
 	if (ci->z_relative)
 		p_z = CLAMP(p_z + ci->z, CANVAS_ITEM_Z_MIN, CANVAS_ITEM_Z_MAX);
 	else
@@ -6430,6 +6597,8 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 		if (child_items[i]->ontop)
 			continue;
 		_render_canvas_item(child_items[i], xform, p_clip_rect, opacity, p_z, z_list, z_last_list, (CanvasItem *)ci->final_clip_owner, p_material_owner);
+		ci->subtree_drawn = ci->subtree_drawn || child_items[i]->subtree_drawn;
+		ci->subtree_cacheable = ci->subtree_cacheable && child_items[i]->subtree_cacheable;
 	}
 
 	if (ci->copy_back_buffer) {
@@ -6437,7 +6606,7 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 		ci->copy_back_buffer->screen_rect = xform.xform(ci->copy_back_buffer->rect).clip(p_clip_rect);
 	}
 
-	if ((!ci->commands.empty() && p_clip_rect.intersects(global_rect)) || ci->vp_render || ci->copy_back_buffer) {
+	if ((ci->commands && p_clip_rect.intersects(global_rect)) || ci->vp_render || ci->copy_back_buffer) {
 		//something to draw?
 		ci->final_transform = xform;
 		ci->final_opacity = opacity * ci->self_opacity;
@@ -6457,6 +6626,9 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 		}
 
 		ci->next = NULL;
+		ci->drawn = true;
+		ci->drawn_z = zidx;
+		ci->subtree_drawn = true;
 	}
 
 	for (int i = 0; i < child_item_count; i++) {
@@ -6464,6 +6636,49 @@ void VisualServerRaster::_render_canvas_item(CanvasItem *p_canvas_item, const Ma
 		if (!child_items[i]->ontop)
 			continue;
 		_render_canvas_item(child_items[i], xform, p_clip_rect, opacity, p_z, z_list, z_last_list, (CanvasItem *)ci->final_clip_owner, p_material_owner);
+		ci->subtree_drawn = ci->subtree_drawn || child_items[i]->subtree_drawn;
+		ci->subtree_cacheable = ci->subtree_cacheable && child_items[i]->subtree_cacheable;
+	}
+}
+
+void VisualServerRaster::_render_canvas_item_cached(CanvasItem *p_canvas_item, Rasterizer::CanvasItem **z_list, Rasterizer::CanvasItem **z_last_list) {
+
+	//same order as _render_canvas_item, but only the items that were drawn last time are linked
+	CanvasItem *ci = p_canvas_item;
+
+	int child_item_count = ci->child_items.size();
+	CanvasItem **child_items = ci->sort_y ? ci->sorted_child_items.ptr() : ci->child_items.ptr();
+
+	for (int i = 0; i < child_item_count; i++) {
+
+		if (child_items[i]->ontop || !child_items[i]->subtree_drawn)
+			continue;
+		_render_canvas_item_cached(child_items[i], z_list, z_last_list);
+	}
+
+	if (ci->drawn) {
+
+		ci->light_masked = false;
+
+		int zidx = ci->drawn_z;
+
+		if (z_last_list[zidx]) {
+			z_last_list[zidx]->next = ci;
+			z_last_list[zidx] = ci;
+
+		} else {
+			z_list[zidx] = ci;
+			z_last_list[zidx] = ci;
+		}
+
+		ci->next = NULL;
+	}
+
+	for (int i = 0; i < child_item_count; i++) {
+
+		if (!child_items[i]->ontop || !child_items[i]->subtree_drawn)
+			continue;
+		_render_canvas_item_cached(child_items[i], z_list, z_last_list);
 	}
 }
 
@@ -6978,6 +7193,8 @@ void VisualServerRaster::sync() {
 }
 
 void VisualServerRaster::draw() {
+	TRACE_ZONE("VisualServer::draw");
+
 	//if (changes)
 	//	print_line("changes: "+itos(changes));
 	changes = 0;
@@ -7089,6 +7306,10 @@ void VisualServerRaster::init() {
 		aabb_random_points[i] = Vector3(Math::random(0, 1), Math::random(0, 1), Math::random(0, 1));
 	transformed_aabb_random_points.resize(aabb_random_points.size());
 	changes = 0;
+
+	//used for culling and instance updates, 0 does everything on the render thread, -1 uses one thread per core
+	work_pool.init(GLOBAL_DEF("render/threads", 0));
+	Globals::get_singleton()->set_custom_property_info("render/threads", PropertyInfo(Variant::INT, "render/threads", PROPERTY_HINT_RANGE, "-1,64,1"));
 }
 
 void VisualServerRaster::_clean_up_owner(RID_OwnerBase *p_owner, String p_type) {
@@ -7130,6 +7351,7 @@ void VisualServerRaster::finish() {
 
 	rasterizer->finish();
 	octree_allocator.clear();
+	work_pool.finish();
 
 	if (instance_dependency_map.size()) {
 		print_line("Base resources missing amount: " + itos(instance_dependency_map.size()));
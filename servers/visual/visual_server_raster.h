@@ -31,6 +31,7 @@
 
 #include "allocators.h"
 #include "octree.h"
+#include "os/thread_work_pool.h"
 #include "servers/visual/rasterizer.h"
 #include "servers/visual_server.h"
 
@@ -42,7 +43,8 @@ class VisualServerRaster : public VisualServer {
 
 	enum {
 
-		MAX_INSTANCE_CULL = 8192,
+		INSTANCE_CULL_CHUNK_SIZE = 256,
+		INSTANCE_UPDATE_CHUNK_SIZE = 128,
 		MAX_INSTANCE_LIGHTS = 4,
 		LIGHT_CACHE_DIRTY = -1,
 		MAX_LIGHTS_CULLED = 256,
@@ -375,6 +377,23 @@ class VisualServerRaster : public VisualServer {
 		bool use_parent_material;
 
 		Vector<CanvasItem *> child_items;
+		CanvasItem *parent_item; //NULL if the parent is a canvas
+
+		//a clean subtree drawn with the same parameters as last time is relinked into the draw lists
+		//as it was, without recomputing transforms, bounds and clipping
+		bool subtree_dirty;
+		bool subtree_cacheable; //viewport items are set up on every draw
+		bool subtree_drawn;
+		bool drawn;
+		int drawn_z;
+		Matrix32 cache_transform;
+		Rect2 cache_clip_rect;
+		Rect2 cache_canvas_clip_rect;
+		float cache_opacity;
+		int cache_z;
+		CanvasItem *cache_canvas_clip;
+		CanvasItem *cache_material_owner;
+		Vector<CanvasItem *> sorted_child_items;
 
 		CanvasItem() {
 			E = NULL;
@@ -384,6 +403,16 @@ class VisualServerRaster : public VisualServer {
 			sort_y = false;
 			use_parent_material = false;
 			z_relative = true;
+			parent_item = NULL;
+			subtree_dirty = true;
+			subtree_cacheable = false;
+			subtree_drawn = false;
+			drawn = false;
+			drawn_z = 0;
+			cache_opacity = 0;
+			cache_z = 0;
+			cache_canvas_clip = NULL;
+			cache_material_owner = NULL;
 		}
 	};
 
@@ -561,8 +590,35 @@ class VisualServerRaster : public VisualServer {
 	static void *instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int);
 	static void instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *);
 
-	Instance *instance_cull_result[MAX_INSTANCE_CULL];
-	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+	//culling has no result limit, these only grow
+	Vector<Instance *> instance_cull_buffer;
+	Vector<Instance *> instance_shadow_cull_buffer; //used for generating shadowmaps
+	ThreadWorkPool work_pool;
+
+	struct InstanceCullChunk {
+
+		int from;
+		int count; //instances kept are moved to the front of the chunk
+		float min, max;
+		Vector<Instance *> lights;
+		int light_count;
+		Vector<Instance *> light_samplers;
+		int light_sampler_count;
+	};
+
+	struct InstanceCullData {
+
+		Instance **instances;
+		int instance_count;
+		uint32_t camera_layer_mask;
+		CullRange cull_range;
+		InstanceCullChunk *chunks;
+	};
+
+	Vector<InstanceCullChunk> instance_cull_chunks;
+
+	void _instance_cull_job(uint32_t p_chunk, InstanceCullData *p_data);
+
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	int light_cull_count;
 
@@ -592,12 +648,22 @@ class VisualServerRaster : public VisualServer {
 	_FORCE_INLINE_ void _instance_queue_update(Instance *p_instance, bool p_update_aabb = false, bool p_update_materials = false);
 	void _update_instances();
 	void _update_instance_aabb(Instance *p_instance);
+	void _update_instance_transform(Instance *p_instance);
 	void _update_instance(Instance *p_instance);
 	void _free_attached_instances(RID p_rid, bool p_free_scenario = false);
 	void _clean_up_owner(RID_OwnerBase *p_owner, String p_type);
 
 	Instance *instance_update_list;
 
+	struct InstanceUpdateData {
+
+		Instance **instances;
+		int instance_count;
+	};
+
+	Vector<Instance *> instance_update_buffer; //only grows
+	void _instance_update_job(uint32_t p_chunk, InstanceUpdateData *p_data);
+
 	//RID default_scenario;
 	//RID default_viewport;
 
@@ -634,6 +700,8 @@ class VisualServerRaster : public VisualServer {
 	static void _render_canvas_item_viewport(VisualServer *p_self, void *p_vp, const Rect2 &p_rect);
 	void _render_canvas_item_tree(CanvasItem *p_canvas_item, const Matrix32 &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, Rasterizer::CanvasLight *p_lights);
 	void _render_canvas_item(CanvasItem *p_canvas_item, const Matrix32 &p_transform, const Rect2 &p_clip_rect, float p_opacity, int p_z, Rasterizer::CanvasItem **z_list, Rasterizer::CanvasItem **z_last_list, CanvasItem *p_canvas_clip, CanvasItem *p_material_owner);
+	void _render_canvas_item_cached(CanvasItem *p_canvas_item, Rasterizer::CanvasItem **z_list, Rasterizer::CanvasItem **z_last_list);
+	void _canvas_item_invalidate(CanvasItem *p_canvas_item);
 	void _render_canvas(Canvas *p_canvas, const Matrix32 &p_transform, Rasterizer::CanvasLight *p_lights, Rasterizer::CanvasLight *p_masked_lights);
 	void _light_mask_canvas_items(int p_z, Rasterizer::CanvasItem *p_canvas_item, Rasterizer::CanvasLight *p_masked_lights);
 
@@ -29,6 +29,7 @@
 #include "visual_server_wrap_mt.h"
 #include "globals.h"
 #include "os/os.h"
+#include "os/trace.h"
 void VisualServerWrapMT::thread_exit() {
 
 	exit = true;
@@ -68,6 +69,7 @@ void VisualServerWrapMT::_thread_callback(void *_instance) {
 void VisualServerWrapMT::thread_loop() {
 
 	server_thread = Thread::get_caller_ID();
+	Trace::set_thread_name("visual");
 
 	OS::get_singleton()->make_rendering_thread();
 